@@ -50,6 +50,118 @@ namespace rascal {
     kernel.def("compute",
                &Kernel::template compute<Calculator, StructureManagers>,
                py::call_guard<py::gil_scoped_release>());
+    // the python callback receives (first_row, tile) for each tile of rows
+    kernel.def(
+        "compute_tiles",
+        [](Kernel & kernel, const Calculator & calculator,
+           const StructureManagers & managers_a,
+           const StructureManagers & managers_b, py::function & callback) {
+          kernel.compute_tiles(
+              calculator, managers_a, managers_b,
+              [&callback](size_t first_row,
+                          const Eigen::Ref<const math::Matrix_t> & tile) {
+                py::gil_scoped_acquire acquire{};
+                callback(first_row, math::Matrix_t{tile});
+              });
+        },
+        py::arg("calculator"), py::arg("managers_a"), py::arg("managers_b"),
+        py::arg("callback"), py::call_guard<py::gil_scoped_release>());
+  }
+
+  /**
+   * Bind the FeatureStore and the kernels between the features of stores.
+   * The arrays of the store are returned as read-only views of the mapped
+   * file that keep the store alive.
+   */
+  template <class CalculatorBind>
+  decltype(auto) bind_feature_store(py::module & mod, CalculatorBind & kernel) {
+    py::class_<FeatureStore, std::shared_ptr<FeatureStore>> store(
+        mod, "FeatureStore");
+    store.def(py::init<const std::string &, const std::string &>(),
+              py::arg("filename"), py::arg("representation_name") = "");
+    store.def_property_readonly("name", &FeatureStore::get_name);
+    store.def_property_readonly(
+        "name_hash", py::overload_cast<>(&FeatureStore::get_name_hash,
+                                         py::const_));
+    store.def_property_readonly("n_structures",
+                                &FeatureStore::get_n_structures);
+    store.def_property_readonly("n_centers", &FeatureStore::get_n_centers);
+    store.def_property_readonly("n_keys", &FeatureStore::get_n_keys);
+    store.def("get_key", &FeatureStore::get_key, py::arg("i_key"));
+    store.def("get_structure_offsets", &FeatureStore::get_structure_offsets);
+    store.def("get_centers", &FeatureStore::get_centers, py::arg("i_key"),
+              py::return_value_policy::reference_internal);
+    store.def("get_values", &FeatureStore::get_values, py::arg("i_key"),
+              py::return_value_policy::reference_internal);
+    store.def("get_squared_norms", &FeatureStore::get_squared_norms,
+              py::return_value_policy::reference_internal);
+    store.def_static(
+        "get_name_hash",
+        py::overload_cast<const std::string &>(&FeatureStore::get_name_hash),
+        py::arg("representation_name"));
+
+    // py::overload_cast cannot pick it among the compute templates
+    kernel.def(
+        "compute",
+        [](Kernel & kernel, const FeatureStore & store_a,
+           const FeatureStore & store_b) {
+          return kernel.compute(store_a, store_b);
+        },
+        py::arg("store_a"), py::arg("store_b"),
+        py::call_guard<py::gil_scoped_release>());
+    return store;
+  }
+
+  /**
+   * Bind the functions writing the features of the managers of a collection
+   * to a FeatureStore and registering them back in the managers.
+   */
+  template <class Calculator, class StructureManagers, class StoreBind>
+  void bind_feature_store_io(StoreBind & store) {
+    using Manager_t = typename StructureManagers::Manager_t;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    store.def("fill_properties",
+              &FeatureStore::template fill_properties<Property_t,
+                                                      StructureManagers>,
+              py::arg("managers"));
+    // in the precision in which calculator stores its features
+    store.def(
+        "fill_properties",
+        [](const FeatureStore & feature_store, StructureManagers & managers,
+           const Calculator & calculator) {
+          internal::visit_feature_property<Calculator, Manager_t>(
+              calculator, [&](auto property_type) {
+                using Prop_t = typename decltype(property_type)::type;
+                feature_store.template fill_properties<Prop_t>(managers);
+              });
+        },
+        py::arg("managers"), py::arg("calculator"));
+    store.def_static(
+        "write",
+        [](const std::string & filename, const StructureManagers & managers,
+           const Calculator & calculator) {
+          internal::visit_feature_property<Calculator, Manager_t>(
+              calculator, [&](auto property_type) {
+                using Prop_t = typename decltype(property_type)::type;
+                FeatureStore::write<Prop_t>(filename, managers,
+                                            calculator.get_name());
+              });
+        },
+        py::arg("filename"), py::arg("managers"), py::arg("calculator"));
+  }
+
+  /**
+   * The derivatives of the kernels need the gradients of the representation,
+   * i.e. managers with the center contribution adaptor
+   */
+  template <class Calculator, class StructureManagers, class CalculatorBind>
+  void bind_kernel_compute_derivative(CalculatorBind & kernel) {
+    kernel.def("compute_derivative",
+               &Kernel::template compute_derivative<Calculator,
+                                                    StructureManagers>,
+               py::arg("calculator"), py::arg("managers"),
+               py::arg("sparse_points"), py::arg("compute_stress") = false,
+               py::call_guard<py::gil_scoped_release>());
   }
 
   /**
@@ -78,5 +190,9 @@ namespace rascal {
                                  ManagerCollection_1_t>(kernel);
     bind_kernel_compute_function<internal::KernelType::Cosine, Calc1_t,
                                  ManagerCollection_2_t>(kernel);
+    bind_kernel_compute_derivative<Calc1_t, ManagerCollection_2_t>(kernel);
+    auto store = bind_feature_store(mod, kernel);
+    bind_feature_store_io<Calc1_t, ManagerCollection_1_t>(store);
+    bind_feature_store_io<Calc1_t, ManagerCollection_2_t>(store);
   }
 }  // namespace rascal
@@ -110,6 +110,8 @@ namespace rascal {
     auto base = py::class_<CalculatorBase>(m_internal, "CalculatorBase");
     base.def_readwrite("name", &CalculatorBase::name);
     base.def_readonly("default_prefix", &CalculatorBase::default_prefix);
+    base.def_property("n_threads", &CalculatorBase::get_n_threads,
+                      &CalculatorBase::set_n_threads);
     /*-------------------- rep-bind-start --------------------*/
     // Defines a particular structure manager type
 
@@ -201,8 +201,9 @@ namespace rascal {
   decltype(auto) add_manager(py::module & mod) {
     using Parent = typename Manager_t::Parent;
     std::string manager_name = internal::GetBindingTypeName<Manager_t>();
+    // dynamic attributes hold the buffers given to update_from_buffers
     py::class_<Manager_t, Parent, std::shared_ptr<Manager_t>> manager(
-        mod, manager_name.c_str());
+        mod, manager_name.c_str(), py::dynamic_attr());
     return manager;
   }
 
@@ -215,8 +216,9 @@ namespace rascal {
   decltype(auto) add_manager_safe(py::module & mod,
                                   const std::string & manager_name) {
     using Parent = typename Manager_t::Parent;
+    // dynamic attributes hold the buffers given to update_from_buffers
     py::class_<Manager_t, Parent, std::shared_ptr<Manager_t>> manager(
-        mod, manager_name.c_str());
+        mod, manager_name.c_str(), py::dynamic_attr());
     return manager;
   }
 
@@ -273,6 +275,61 @@ namespace rascal {
                 py::arg("pbc"), py::call_guard<py::gil_scoped_release>());
   }
 
+  /**
+   * Bind the update function from the NumPy arrays of the positions (a
+   * (n_atoms, 3) float64 array whose rows may be strided, e.g. the
+   * `positions` array of an ASE Atoms object) and of the atom types (a
+   * contiguous int32 array), without copying them (see AtomicStructureView).
+   * The arrays of the last call are kept alive as long as the Python object
+   * of the manager it is called on (in its `_buffers` attribute), e.g. the
+   * result of `atoms.numbers.astype(np.int32)`, but the caller must keep
+   * them in place and increment `version` whenever they are not only
+   * modified in place.
+   */
+  template <typename StructureManagerImplementation>
+  void bind_update_view(PyManager<StructureManagerImplementation> & manager) {
+    manager.def(
+        "update_from_buffers",
+        [](py::object self, py::array positions, py::array atom_types,
+           const py::EigenDRef<const Eigen::MatrixXd> & cell,
+           const py::EigenDRef<const Eigen::MatrixXi> & pbc, size_t version) {
+          auto & manager{self.cast<StructureManagerImplementation &>()};
+          constexpr auto double_size{static_cast<py::ssize_t>(sizeof(double))};
+          if (not py::isinstance<py::array_t<double>>(positions) or
+              positions.ndim() != 2 or positions.shape(1) != 3 or
+              positions.strides(1) != double_size or
+              positions.strides(0) % double_size != 0 or
+              not positions.writeable()) {
+            throw std::runtime_error(
+                "The positions should be a writeable (n_atoms, 3) float64 "
+                "array with contiguous rows.");
+          }
+          if (not py::isinstance<py::array_t<int>>(atom_types) or
+              atom_types.ndim() != 1 or
+              atom_types.shape(0) != positions.shape(0) or
+              atom_types.strides(0) != static_cast<py::ssize_t>(sizeof(int)) or
+              not atom_types.writeable()) {
+            throw std::runtime_error(
+                "The atom types should be a writeable and contiguous int32 "
+                "array with one entry per atom.");
+          }
+          AtomicStructureView<3> view{};
+          view.positions = static_cast<double *>(positions.mutable_data());
+          view.positions_stride = positions.strides(0) / double_size;
+          view.atom_types = static_cast<int *>(atom_types.mutable_data());
+          view.n_atoms = positions.shape(0);
+          view.cell = cell;
+          view.pbc = pbc;
+          view.version = version;
+          // the manager reads the arrays in place until the next call
+          self.attr("_buffers") = py::make_tuple(positions, atom_types);
+          py::gil_scoped_release release{};
+          manager.update(view);
+        },
+        py::arg("positions"), py::arg("atom_types"), py::arg("cell"),
+        py::arg("pbc"), py::arg("version"));
+  }
+
   /**
    * Bind the update function when no atomic structure is provided. It
    * corresponds to the case when several adaptors are stacked on a
@@ -455,6 +512,46 @@ namespace rascal {
         "get_dense_feature_matrix",
         &ManagerCollection_t::template get_dense_feature_matrix<Calculator>,
         py::call_guard<py::gil_scoped_release>());
+    // the buffers of the CSR matrix are handed to numpy without copy, they
+    // are freed with the last array that uses them
+    manager_collection.def(
+        "get_sparse_feature_matrix",
+        [](ManagerCollection_t & managers, const Calculator & calculator) {
+          using SparseMatrix_t = math::SparseMatrix_t;
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          std::unique_ptr<SparseMatrix_t> features{};
+          int block_size{0};
+          {
+            py::gil_scoped_release release{};
+            features = std::make_unique<SparseMatrix_t>(
+                managers.get_sparse_feature_matrix(calculator));
+            // number of consecutive columns of a key
+            block_size = internal::visit_feature_property<Calculator,
+                                                          Manager_t>(
+                calculator, [&](auto property_type) {
+                  using Property_t = typename decltype(property_type)::type;
+                  return managers[0]
+                      ->template get_property_ref<Property_t>(
+                          calculator.get_name())
+                      .get_nb_comp();
+                });
+          }
+          auto n_rows{features->rows()};
+          auto n_cols{features->cols()};
+          auto n_entries{features->nonZeros()};
+          auto data{features->valuePtr()};
+          auto columns{features->innerIndexPtr()};
+          auto row_offsets{features->outerIndexPtr()};
+          py::capsule owner(features.release(), [](void * ptr) {
+            delete static_cast<SparseMatrix_t *>(ptr);
+          });
+          return py::make_tuple(
+              py::array_t<double>(n_entries, data, owner),
+              py::array_t<int>(n_entries, columns, owner),
+              py::array_t<int>(n_rows + 1, row_offsets, owner),
+              py::make_tuple(n_rows, n_cols), block_size);
+        },
+        py::arg("calculator"));
   }
 
   template <typename Manager, template <class> class... Adaptor>
@@ -512,6 +609,16 @@ namespace rascal {
         R"(Read a file and extract the structures from start to start + length.)",
         py::arg("filename"), py::arg("start") = 0, py::arg("length") = -1);
 
+    manager_collection.def(
+        "add_structures",
+        [](ManagerCollection_t & v,
+           const std::shared_ptr<StructureStore> & store, int start,
+           int length) { v.add_structures(store, start, length); },
+        R"(Add the structures from start to start + length of a
+        StructureStore, read in place from the memory mapped file.)",
+        py::arg("store"), py::arg("start") = 0, py::arg("length") = -1,
+        py::call_guard<py::gil_scoped_release>());
+
     manager_collection.def("__len__",
                            [](ManagerCollection_t & v) { return v.size(); });
 
@@ -559,6 +666,7 @@ namespace rascal {
                     ManagerImplementation>::bind_adaptor_init(adaptor);
         // bind_update_empty<Manager_t>(adaptor);
         bind_update_unpacked<Manager_t>(adaptor);
+        bind_update_view<Manager_t>(adaptor);
         // bind clusterRefs so that one can loop over adaptor
         // MaxOrder+1 because recursion stops at Val-1
         add_iterators<Manager_t, 1, MaxOrder + 1>::static_for(m_internal,
@@ -594,6 +702,7 @@ namespace rascal {
                     ManagerImplementation>::bind_adaptor_init(adaptor);
         bind_update_empty<Manager_t>(adaptor);
         bind_update_unpacked<Manager_t>(adaptor);
+        bind_update_view<Manager_t>(adaptor);
         // bind clusterRefs so that one can loop over adaptor
         // MaxOrder+1 because recursion stops at Val-1
         add_iterators<Manager_t, 1, MaxOrder + 1>::static_for(m_internal,
@@ -620,6 +729,13 @@ namespace rascal {
         add_structure_manager_implementation<Manager_t>(mod, m_internal);
     //
     bind_update_unpacked<Manager_t>(manager);
+    bind_update_view<Manager_t>(manager);
+    // views on the data of the manager, i.e. on the buffers given to
+    // update_from_buffers for the positions
+    manager.def("get_positions", &Manager_t::get_positions,
+                py::return_value_policy::reference_internal);
+    manager.def("get_cell", &Manager_t::get_cell,
+                py::return_value_policy::reference_internal);
   }
 
   //! Bind the ClusterRef up to order 4 and from Layer 0 to 6
@@ -703,6 +819,33 @@ namespace rascal {
              py::keep_alive<0, 1>());
   }
 
+  /**
+   * bind the StructureStore, a binary file of structures that is memory
+   * mapped instead of parsed
+   */
+  void bind_structure_store(py::module & mod) {
+    py::class_<StructureStore, std::shared_ptr<StructureStore>>(
+        mod, "StructureStore")
+        .def(py::init<const std::string &>(), py::arg("filename"))
+        .def("__len__", &StructureStore::size)
+        .def("get_id",
+             [](const StructureStore & store, size_t index) {
+               // StructureStore::get_id does not check the index
+               if (index >= store.size()) {
+                 throw py::index_error("The index is out of the store.");
+               }
+               return store.get_id(index);
+             },
+             py::arg("index"))
+        .def("get_structure", &StructureStore::get_structure,
+             py::arg("index"))
+        .def_static("write", &StructureStore::write, py::arg("filename"),
+                    py::arg("structures"), py::arg("ids") = std::vector<int>{})
+        .def_static("convert_ase", &StructureStore::convert_ase,
+                    py::arg("ase_filename"), py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>());
+  }
+
   //! Main function to add StructureManagers and their Adaptors
   void add_structure_managers(py::module & m_nl, py::module & m_internal) {
     // Bind StructureManagerBase (needed for virtual inheritance)
@@ -739,5 +882,6 @@ namespace rascal {
         m_nl);
 
     bind_atomic_structure(m_nl);
+    bind_structure_store(m_nl);
   }
 }  // namespace rascal
@@ -40,6 +40,7 @@
 #include "structure_managers/structure_manager_base.hh"
 #include "structure_managers/structure_manager_collection.hh"
 #include "structure_managers/adaptor_center_contribution.hh"
+#include "structure_store.hh"
 
 #include "bind_include.hh"
 
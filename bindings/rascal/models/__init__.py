@@ -1 +1 @@
-from .kernels import Kernel
+from .kernels import Kernel, FeatureStore
@@ -1,4 +1,5 @@
 from ..lib._rascal.models.kernels import Kernel as Kernelcpp
+from ..lib._rascal.models.kernels import FeatureStore
 from ..neighbourlist import AtomsList
 import json
 
@@ -19,14 +20,23 @@ class Kernel(object):
             Representation calculator associated with the kernel
 
         name : string
-            Type of kernel, 'Cosine' (aka dot-product) is the default and
-            (currently) only option
+            Type of kernel: 'Cosine' (aka dot-product, with the `zeta`
+            exponent) is the default, 'Polynomial' computes
+            (gamma x.y + coef0)^degree (`degree`, `gamma` and `coef0`
+            keyword arguments) and 'Gaussian' computes
+            exp(-gamma |x - y|^2) (`gamma` keyword argument)
 
         target_type : string
             Type of target (prediction) properties, either 'atomic' (kernel is
             between atomic environments) or 'structure' (kernel is summed over
             atoms in a structure) (default)
 
+        structure_reduction : string, optional
+            How the kernels between the atoms of two structures are reduced
+            to the structure kernel: 'Average' (default), 'Sum' or
+            'NormalizedAverage' (average divided by the square root of the
+            averages of each structure with itself)
+
         """
         hypers = dict(name=name,target_type=target_type)
         hypers.update(**kwargs)
@@ -41,8 +51,10 @@ class Kernel(object):
 
         Parameters
         ----------
-        X : AtomList or ManagerCollection (C++ class)
-            Container of atomic structures.
+        X : AtomList, ManagerCollection (C++ class) or FeatureStore
+            Container of atomic structures or features saved with
+            FeatureStore.write, which are read from the file instead of
+            being computed.
 
         Returns
         -------
@@ -50,8 +62,67 @@ class Kernel(object):
         """
         if Y is None:
             Y = X
+        if isinstance(X, FeatureStore):
+            return self._kernel.compute(X, Y)
         if isinstance(X, AtomsList):
             X = X.managers
         if isinstance(Y, AtomsList):
             Y = Y.managers
         return self._kernel.compute(self._representation, X, Y)
+
+    def compute_tiles(self, callback, X, Y=None):
+        """
+        Compute the kernel as a stream of tiles of consecutive rows, without
+        holding the whole kernel matrix in memory. The sizes of the tiles are
+        set with the `tile_rows` and `tile_cols` keyword arguments of the
+        constructor (in numbers of atomic environments).
+
+        Parameters
+        ----------
+        callback : callable
+            Called as callback(first_row, tile) with each tile of rows of the
+            kernel matrix (ndarray), in order.
+        X : AtomList or ManagerCollection (C++ class)
+            Container of atomic structures.
+        """
+        if Y is None:
+            Y = X
+        if isinstance(X, AtomsList):
+            X = X.managers
+        if isinstance(Y, AtomsList):
+            Y = Y.managers
+        self._kernel.compute_tiles(self._representation, X, Y, callback)
+
+    def compute_derivative(self, X, sparse_points, compute_stress=False):
+        """
+        Compute the derivative of the kernel between the structures of X and
+        the atomic environments of sparse_points with respect to the
+        positions of the atoms of X. The representation must have been
+        computed with `compute_gradients=True`.
+
+        Parameters
+        ----------
+        X : AtomList or ManagerCollection (C++ class)
+            Container of atomic structures.
+        sparse_points : AtomList or ManagerCollection (C++ class)
+            Container of atomic structures whose environments are the sparse
+            points.
+        compute_stress : bool
+            Also compute the derivative with respect to the strain of each
+            structure.
+
+        Returns
+        -------
+        derivative: ndarray
+            (3 n_atoms (+ 6 n_structures), n_sparse_points) matrix with the
+            x, y, z gradients of each atom of each structure followed by the
+            strain derivatives (xx, yy, zz, yz, xz, xy) of each structure.
+            The forces predicted with the weights w of the sparse points are
+            -derivative[:3*n_atoms].dot(w).
+        """
+        if isinstance(X, AtomsList):
+            X = X.managers
+        if isinstance(sparse_points, AtomsList):
+            sparse_points = sparse_points.managers
+        return self._kernel.compute_derivative(self._representation, X,
+                                               sparse_points, compute_stress)
@@ -3,6 +3,7 @@ from .base import (NeighbourListFactory, is_valid_structure,
  adapt_structure, StructureCollectionFactory)
 from collections.abc import Iterable
 import numpy as np
+import scipy.sparse
 
 class AtomsList(object):
     """
@@ -23,7 +24,13 @@ class AtomsList(object):
         self.nl_options = nl_options
         self._frames = frames
 
-        if isinstance(frames, str):
+        if isinstance(frames, neighbour_list.StructureStore):
+            # structures memory mapped from a binary file
+            managers = StructureCollectionFactory(nl_options)
+            managers.add_structures(frames,
+                start=0 if start is None else start,
+                length=-1 if length is None else length)
+        elif isinstance(frames, str):
             # if filename
             managers = StructureCollectionFactory(nl_options)
             if start is None and length is None:
@@ -72,6 +79,33 @@ class AtomsList(object):
         return self.managers.get_dense_feature_matrix(
                 calculator._representation)
 
+    def get_sparse_feature_matrix(self, calculator, blocks=False):
+        """
+        Parameters
+        -------
+        calculator : Calculator (an object owning a _representation object)
+
+        blocks : bool
+            return a block sparse row matrix with the features of each key of
+            each center as a block, instead of a compressed sparse row one
+
+        Returns
+        -------
+        represenation_matrix : scipy.sparse.csr_matrix or bsr_matrix
+            returns the representation bound to the calculator as a sparse
+            matrix, with the same columns as get_dense_feature_matrix() but
+            only the features of the keys of each center are stored. The
+            values are not copied from the C++ buffers.
+        """
+        data, indices, indptr, shape, block_size = \
+            self.managers.get_sparse_feature_matrix(calculator._representation)
+        if blocks:
+            return scipy.sparse.bsr_matrix(
+                (data.reshape(-1, 1, block_size), indices[::block_size] //
+                 block_size, indptr // block_size), shape=shape, copy=False)
+        return scipy.sparse.csr_matrix((data, indices, indptr), shape=shape,
+                                       copy=False)
+
 
 def get_neighbourlist(structure, options):
     manager = NeighbourListFactory(options)
@@ -94,6 +94,7 @@ class SortedCoulombMatrix(object):
         hypers_str = json.dumps(self.hypers)
         self.rep_options = dict(name=self.name, args=[hypers_str])
         self._representation = CalculatorFactory(self.rep_options)
+        self._representation.n_threads = self.misc['n_workers']
 
         self._representation.compute(frames.managers)
 
@@ -46,6 +46,27 @@ class SphericalCovariants(object):
     lam : int
         Order of the lambda spectrum.
 
+    radial_basis : str
+        Radial basis of the expansion: 'GTO', 'DVR' or 'Spline'. 'Spline'
+        tabulates the GTO radial integral once and interpolates it with
+        cubic splines, which is faster when many structures are computed
+        with the same hyperparameters.
+
+    spline_accuracy : float
+        Accuracy target of the spline interpolation of the radial integral
+        (only used with radial_basis='Spline').
+
+    use_pair_parity : bool
+        Evaluate the radial integral and the spherical harmonics only once
+        per pair of atoms and obtain the contribution of the reverse pair
+        from the parity of the spherical harmonics, which roughly halves the
+        cost of the expansion.
+
+    n_workers : int
+        Number of threads used to compute the representation (0 uses all
+        the available cores). The structures are split over the threads, or
+        the atomic centers when there are fewer structures than threads.
+
     Methods
     -------
     transform(frames)
@@ -63,10 +84,10 @@ class SphericalCovariants(object):
                  max_radial, max_angular, gaussian_sigma_type,
                  gaussian_sigma_constant=0., n_species=1,
                  cutoff_function_type="ShiftedCosine", normalize=True,
-                 radial_basis="GTO",
+                 radial_basis="GTO", spline_accuracy=1e-8,
                  soap_type="LambdaSpectrum", inversion_symmetry=True,
-                 lam=0,
-                 cutoff_function_parameters=dict()):
+                 lam=0, use_pair_parity=False,
+                 n_workers=1, cutoff_function_parameters=dict()):
         """Construct a SphericalExpansion representation
 
         Required arguments are all the hyperparameters named in the
@@ -99,10 +120,14 @@ class SphericalCovariants(object):
         radial_contribution = dict(
             type=radial_basis,
         )
+        if radial_basis == 'Spline':
+            radial_contribution.update(accuracy=spline_accuracy)
 
         self.update_hyperparameters(cutoff_function=cutoff_function,
                                     gaussian_density=gaussian_density,
                                     radial_contribution=radial_contribution)
+        if use_pair_parity:
+            self.update_hyperparameters(use_pair_parity=True)
 
         self.nl_options = [
             dict(name='centers', args=dict()),
@@ -115,6 +140,7 @@ class SphericalCovariants(object):
         self.rep_options = dict(name=self.name, args=[hypers_str])
 
         self._representation = CalculatorFactory(self.rep_options)
+        self._representation.n_threads = n_workers
 
     def update_hyperparameters(self, **hypers):
         """Store the given dict of hyperparameters
@@ -123,6 +149,7 @@ class SphericalCovariants(object):
 
         """
         allowed_keys = {'interaction_cutoff', 'cutoff_smooth_width',
+                        'use_pair_parity',
                         'max_radial', 'max_angular', 'gaussian_sigma_type',
                         'gaussian_sigma_constant', 'n_species', 'soap_type',
                         'inversion_symmetry', 'lam', 'cutoff_function',
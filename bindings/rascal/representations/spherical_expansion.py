@@ -37,6 +37,27 @@ class SphericalExpansion(object):
         Specifies the atomic Gaussian widths, in the case where they're
         fixed.
 
+    radial_basis : str
+        Radial basis of the expansion: 'GTO', 'DVR' or 'Spline'. 'Spline'
+        tabulates the GTO radial integral once and interpolates it with
+        cubic splines, which is faster when many structures are computed
+        with the same hyperparameters.
+
+    spline_accuracy : float
+        Accuracy target of the spline interpolation of the radial integral
+        (only used with radial_basis='Spline').
+
+    use_pair_parity : bool
+        Evaluate the radial integral and the spherical harmonics only once
+        per pair of atoms and obtain the contribution of the reverse pair
+        from the parity of the spherical harmonics, which roughly halves the
+        cost of the expansion.
+
+    n_workers : int
+        Number of threads used to compute the representation (0 uses all
+        the available cores). The structures are split over the threads, or
+        the atomic centers when there are fewer structures than threads.
+
     Methods
     -------
     transform(frames)
@@ -53,9 +74,9 @@ class SphericalExpansion(object):
                  max_radial, max_angular, gaussian_sigma_type,
                  gaussian_sigma_constant=0.,
                  cutoff_function_type="ShiftedCosine",
-                 n_species=1, radial_basis="GTO",
+                 n_species=1, radial_basis="GTO", spline_accuracy=1e-8,
                  method='thread', n_workers=1, disable_pbar=False,
-                 cutoff_function_parameters=dict()):
+                 cutoff_function_parameters=dict(), use_pair_parity=False):
         """Construct a SphericalExpansion representation
 
         Required arguments are all the hyperparameters named in the
@@ -85,9 +106,13 @@ class SphericalExpansion(object):
         radial_contribution = dict(
             type=radial_basis,
         )
+        if radial_basis == 'Spline':
+            radial_contribution.update(accuracy=spline_accuracy)
         self.update_hyperparameters(cutoff_function=cutoff_function,
                                     gaussian_density=gaussian_density,
                                     radial_contribution=radial_contribution)
+        if use_pair_parity:
+            self.update_hyperparameters(use_pair_parity=True)
 
         self.nl_options = [
             dict(name='centers', args=dict()),
@@ -107,6 +132,7 @@ class SphericalExpansion(object):
                          disable_pbar=disable_pbar)
 
         self._representation = CalculatorFactory(self.rep_options)
+        self._representation.n_threads = n_workers
 
     def update_hyperparameters(self, **hypers):
         """Store the given dict of hyperparameters
@@ -115,6 +141,7 @@ class SphericalExpansion(object):
 
         """
         allowed_keys = {'interaction_cutoff', 'cutoff_smooth_width',
+                        'use_pair_parity',
                         'max_radial', 'max_angular', 'gaussian_sigma_type',
                         'gaussian_sigma_constant', 'n_species', 'gaussian_density', 'cutoff_function',
                         'radial_contribution', 'cutoff_function_parameters'}
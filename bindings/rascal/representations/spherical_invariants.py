@@ -49,6 +49,37 @@ class SphericalInvariants(object):
         Whether to normalize so that the kernel between identical environments
         is 1.  Default and highly recommended: True.
 
+    radial_basis : str
+        Radial basis of the expansion: 'GTO', 'DVR' or 'Spline'. 'Spline'
+        tabulates the GTO radial integral once and interpolates it with
+        cubic splines, which is faster when many structures are computed
+        with the same hyperparameters.
+
+    spline_accuracy : float
+        Accuracy target of the spline interpolation of the radial integral
+        (only used with radial_basis='Spline').
+
+    use_pair_parity : bool
+        Evaluate the radial integral and the spherical harmonics only once
+        per pair of atoms and obtain the contribution of the reverse pair
+        from the parity of the spherical harmonics, which roughly halves the
+        cost of the expansion.
+
+    precision : str
+        Precision in which the invariants are stored: 'double' or
+        'single'. They are always computed in double, 'single' halves the
+        memory of the features and the cost of the matrix products of the
+        kernels. The feature matrices are returned in double.
+
+    n_workers : int
+        Number of threads used to compute the representation (0 uses all
+        the available cores). The structures are split over the threads, or
+        the atomic centers when there are fewer structures than threads.
+
+    compute_gradients : bool
+        Also compute the gradients of the invariants with respect to the
+        atomic positions, e.g. for Kernel.compute_derivative.
+
     Methods
     -------
     transform(frames)
@@ -66,8 +97,9 @@ class SphericalInvariants(object):
                  gaussian_sigma_constant=0., n_species=1,
                  cutoff_function_type="ShiftedCosine",
                  soap_type="PowerSpectrum", inversion_symmetry=True,
-                 radial_basis="GTO", normalize=True,
-                 cutoff_function_parameters=dict()):
+                 radial_basis="GTO", spline_accuracy=1e-8, normalize=True,
+                 use_pair_parity=False, precision="double", n_workers=1,
+                 cutoff_function_parameters=dict(), compute_gradients=False):
         """Construct a SphericalExpansion representation
 
         Required arguments are all the hyperparameters named in the
@@ -98,10 +130,18 @@ class SphericalInvariants(object):
         radial_contribution = dict(
             type=radial_basis,
         )
+        if radial_basis == 'Spline':
+            radial_contribution.update(accuracy=spline_accuracy)
 
         self.update_hyperparameters(cutoff_function=cutoff_function,
                                     gaussian_density=gaussian_density,
                                     radial_contribution=radial_contribution)
+        if use_pair_parity:
+            self.update_hyperparameters(use_pair_parity=True)
+        if precision != "double":
+            self.update_hyperparameters(precision=precision)
+        if compute_gradients:
+            self.update_hyperparameters(compute_gradients=True)
 
         if soap_type == "RadialSpectrum":
             self.update_hyperparameters(max_angular=0)
@@ -117,6 +157,7 @@ class SphericalInvariants(object):
         self.rep_options = dict(name=self.name, args=[hypers_str])
 
         self._representation = CalculatorFactory(self.rep_options)
+        self._representation.n_threads = n_workers
 
     def update_hyperparameters(self, **hypers):
         """Store the given dict of hyperparameters
@@ -125,11 +166,12 @@ class SphericalInvariants(object):
 
         """
         allowed_keys = {'interaction_cutoff', 'cutoff_smooth_width',
+                        'use_pair_parity', 'precision',
                         'max_radial', 'max_angular', 'gaussian_sigma_type',
                         'gaussian_sigma_constant', 'n_species', 'soap_type',
                         'inversion_symmetry', 'cutoff_function', 'normalize',
                         'gaussian_density', 'radial_contribution',
-                        'cutoff_function_parameters'}
+                        'cutoff_function_parameters', 'compute_gradients'}
         hypers_clean = {key: hypers[key] for key in hypers
                         if key in allowed_keys}
         self.hypers.update(hypers_clean)
@@ -42,6 +42,44 @@
 // TODO(markus): CHECK for skewedness
 namespace rascal {
 
+  /**
+   * Non-owning description of an atomic structure whose positions and atom
+   * types are stored in buffers owned by the caller, e.g. an MD engine or the
+   * NumPy arrays of an ASE Atoms object. It is used to update a
+   * StructureManagerCenters without copying them.
+   *
+   * The positions of atom j are read from `positions + j * positions_stride`,
+   * so an (n_atoms, Dim) C-ordered array, or a view of the first Dim columns
+   * of a wider one, can be used directly. The atom types are contiguous.
+   *
+   * The buffers are not copied: they have to stay alive and at the same
+   * address as long as the managers updated with them are used. Their
+   * content may change between updates, e.g. the positions along a
+   * trajectory, but any other change (other buffers, number of atoms, atom
+   * types) must be signalled by incrementing `version`, which is the only
+   * thing looked at to decide if the atoms have to be validated and indexed
+   * again. The cell and the periodicity are small and are always copied.
+   */
+  template <int Dim>
+  struct AtomicStructureView {
+    //! first coordinate of the first atom
+    double * positions{nullptr};
+    //! number of doubles between the coordinates of two consecutive atoms
+    Eigen::Index positions_stride{Dim};
+    //! atomic numbers of the atoms
+    int * atom_types{nullptr};
+    //! number of atoms in the buffers
+    Eigen::Index n_atoms{0};
+    //! cell vectors as columns
+    Eigen::Matrix<double, Dim, Dim> cell{
+        Eigen::Matrix<double, Dim, Dim>::Zero()};
+    //! 0/1 periodicity in each direction
+    Eigen::Matrix<int, Dim, 1> pbc{Eigen::Matrix<int, Dim, 1>::Zero()};
+    //! to be incremented by the caller whenever the buffers are not
+    //! just updated in place
+    size_t version{0};
+  };
+
   /**
    * A common structure to access atom and cell related data, based on the
    * idea of the atoms object in the Atomic Simulation Environment. The
@@ -107,10 +145,21 @@ namespace rascal {
     //! in the form of an array of N booleans (true->center)
     ArrayB_t center_atoms_mask{};
 
+    /**
+     * Caller-owned buffers of the positions and atom types, used in place of
+     * `positions` and `atom_types` (which are then empty) when `is_view`.
+     */
+    AtomicStructureView<Dim> view{};
+
+    //! whether the positions and atom types are read from `view`
+    bool is_view{false};
+
     //! Default constructor
     AtomicStructure() = default;
 
-    inline size_t get_number_of_atoms() const { return positions.cols(); }
+    inline size_t get_number_of_atoms() const {
+      return this->is_view ? this->view.n_atoms : positions.cols();
+    }
 
     /**
      * Set the atomic structure. The expected input are similar to the member
@@ -172,6 +221,34 @@ namespace rascal {
       this->pbc = pbc;
       this->positions = positions;
       this->center_atoms_mask = center_atoms_mask;
+      this->is_view = false;
+    }
+
+    /**
+     * Read the positions and atom types from caller-owned buffers, without
+     * copy. All atoms are centers when the version of the buffers changes,
+     * otherwise the center atoms mask is kept.
+     */
+    inline void set_structure(const AtomicStructureView<Dim> & view) {
+      if (view.n_atoms < 0 or view.positions_stride < Dim) {
+        throw std::runtime_error(
+            "The number of atoms must be positive and the positions stride "
+            "at least the dimension.");
+      }
+      if (view.n_atoms > 0 and
+          (view.positions == nullptr or view.atom_types == nullptr)) {
+        throw std::runtime_error("The positions or atom types are missing.");
+      }
+      if (not this->is_view or this->view.version != view.version or
+          this->center_atoms_mask.size() != view.n_atoms) {
+        this->positions.resize(Dim, 0);
+        this->atom_types.resize(0);
+        this->center_atoms_mask = ArrayB_t::Ones(view.n_atoms);
+      }
+      this->cell = view.cell;
+      this->pbc = view.pbc;
+      this->view = view;
+      this->is_view = true;
     }
 
     // TODO(markus): add function to read from XYZ files
@@ -228,6 +305,8 @@ namespace rascal {
       this->cell = other.cell;
       this->pbc = other.pbc;
       this->center_atoms_mask = other.center_atoms_mask;
+      this->view = other.view;
+      this->is_view = other.is_view;
     }
 
     inline void set_structure() {}
@@ -253,6 +332,17 @@ namespace rascal {
 
     inline bool is_similar(const std::string &, double) const { return false; }
 
+    /**
+     * The buffers of a view are read in place, so only their version, the
+     * cell and the periodicity are compared and not the positions.
+     */
+    inline bool is_similar(const AtomicStructureView<Dim> & view,
+                           double) const {
+      return this->is_view and this->view.version == view.version and
+             (this->pbc.array() == view.pbc.array()).all() and
+             (this->cell.array() == view.cell.array()).all();
+    }
+
     inline bool is_similar(const AtomicStructure<Dim> & other,
                            double threshold2) const {
       bool is_similar_{true};
@@ -27,6 +27,9 @@
 
 #include "json_io.hh"
 
+#include <cstdlib>
+#include <vector>
+
 namespace rascal {
   namespace json_io {
 
@@ -62,6 +65,150 @@ namespace rascal {
       return json::from_ubjson(ref_data_ubjson);
     }
 
+    /**
+     * SAX consumer building the json dictionary of one structure of an ase
+     * file at a time (the objects at the first level of the file whose key
+     * is an id) and handing it over to the callback. The other entries of
+     * the first level ("ids", "nextid") are skipped.
+     */
+    class AseStructureReader : public nlohmann::json_sax<json> {
+     public:
+      using Callback_t = std::function<bool(int, json &&)>;
+
+      explicit AseStructureReader(const Callback_t & callback)
+          : callback{callback} {}
+
+      bool null() override { return this->add_value(json(nullptr)); }
+      bool boolean(bool val) override { return this->add_value(json(val)); }
+      bool number_integer(number_integer_t val) override {
+        return this->add_value(json(val));
+      }
+      bool number_unsigned(number_unsigned_t val) override {
+        return this->add_value(json(val));
+      }
+      bool number_float(number_float_t val, const string_t &) override {
+        return this->add_value(json(val));
+      }
+      bool string(string_t & val) override {
+        return this->add_value(json(std::move(val)));
+      }
+
+      bool start_object(std::size_t) override {
+        ++this->depth;
+        if (this->depth == 2 and this->values.empty() and this->is_id) {
+          this->structure = json::object();
+          this->values.push_back(&this->structure);
+        } else if (not this->values.empty()) {
+          this->values.push_back(this->add(json::object()));
+        }
+        return true;
+      }
+
+      bool end_object() override {
+        --this->depth;
+        if (this->values.empty()) {
+          return true;
+        }
+        this->values.pop_back();
+        if (this->values.empty()) {
+          return this->callback(this->id, std::move(this->structure));
+        }
+        return true;
+      }
+
+      bool start_array(std::size_t) override {
+        ++this->depth;
+        if (not this->values.empty()) {
+          this->values.push_back(this->add(json::array()));
+        }
+        return true;
+      }
+
+      bool end_array() override {
+        --this->depth;
+        if (not this->values.empty()) {
+          this->values.pop_back();
+        }
+        return true;
+      }
+
+      bool key(string_t & val) override {
+        if (this->depth == 1) {
+          // the structures are the entries whose key is an integer id
+          char * end{nullptr};
+          long id{std::strtol(val.c_str(), &end, 10)};
+          this->is_id = (not val.empty() and *end == '\0');
+          this->id = static_cast<int>(id);
+        } else {
+          this->next_key = val;
+        }
+        return true;
+      }
+
+      bool parse_error(std::size_t position, const std::string & last_token,
+                       const json::exception & error) override {
+        throw std::runtime_error(
+            std::string("Could not parse the structures at byte ") +
+            std::to_string(position) + " ('" + last_token +
+            "'): " + error.what());
+      }
+
+     protected:
+      //! store value in the innermost object or array being built
+      json * add(json && value) {
+        json & parent{*this->values.back()};
+        if (parent.is_array()) {
+          parent.push_back(std::move(value));
+          return &parent.back();
+        }
+        json & entry{parent[this->next_key]};
+        entry = std::move(value);
+        return &entry;
+      }
+
+      bool add_value(json && value) {
+        if (not this->values.empty()) {
+          this->add(std::move(value));
+        }
+        return true;
+      }
+
+      const Callback_t & callback;
+      //! nesting level of the current event, 1 is the first level of the file
+      int depth{0};
+      //! the key of the current entry of the first level is an id
+      bool is_id{false};
+      int id{0};
+      json structure{};
+      //! the objects and arrays of structure being built, innermost last;
+      //! empty outside of the entry of a structure
+      std::vector<json *> values{};
+      //! key of the next value of the innermost object
+      string_t next_key{};
+    };
+
+    void read_ase_structures(
+        const std::string & filename,
+        const std::function<bool(int, json &&)> & callback) {
+      auto extension{internal::get_filename_extension(filename)};
+      json::input_format_t format{};
+      if (extension == "json") {
+        format = json::input_format_t::json;
+      } else if (extension == "ubjson") {
+        format = json::input_format_t::ubjson;
+      } else {
+        throw std::runtime_error(std::string("Don't know the extension of ") +
+                                 filename);
+      }
+      std::ifstream reader(filename, std::ios::binary);
+      if (not reader.is_open()) {
+        throw std::runtime_error(std::string("Could not open the file: ") +
+                                 filename);
+      }
+      AseStructureReader structure_reader{callback};
+      json::sax_parse(reader, &structure_reader, format);
+    }
+
     /* ---------------------------------------------------------------------- */
     void to_json(json & j, AtomicJsonData & s) {
       j = json{{"cell", s.cell},
@@ -38,6 +38,7 @@
 
 #include <Eigen/Dense>
 #include <fstream>
+#include <functional>
 
 // For convenience
 using json = nlohmann::json;
@@ -300,6 +301,20 @@ namespace rascal {
     //! load a json file in ubjson binary format
     json load_bin(const std::string & filename);
 
+    /**
+     * Read the structures of a file in the ase json format (text or ubjson
+     * depending on the extension, like load()) one at a time, so that the
+     * whole file is never held in memory.
+     *
+     * callback(id, structure) is called with the id and the json dictionary
+     * of each structure in the order in which they appear in the file, which
+     * is not necessarily the order of the ids. Reading stops early when
+     * callback returns false.
+     */
+    void read_ase_structures(
+        const std::string & filename,
+        const std::function<bool(int, json &&)> & callback);
+
     /**
      * Object to deserialize the content of a JSON file containing Atomic
      * Simulation Environment (ASE) type atomic structures, the nlohmann::json
@@ -146,6 +146,31 @@ namespace rascal {
         }
         return result;
       }
+
+      /**
+       * Computes G(a,b,z) for a batch of z, see calc() above for the
+       * definition of the arguments.
+       *
+       * @param result has to be of the same size as z
+       */
+      inline void calc(const Eigen::Ref<const Eigen::ArrayXd> & z,
+                       const Eigen::Ref<const Eigen::ArrayXd> & z2,
+                       const Eigen::Ref<const Eigen::ArrayXd> & ez2,
+                       Eigen::Ref<Eigen::ArrayXd> result,
+                       bool derivative = false) {
+        if (not this->is_exp) {
+          if (not derivative) {
+            this->sum(z, this->coeff, result);
+            result = this->prefac * result * ez2;
+          } else {
+            this->sum(z, this->coeff_derivative, result);
+            result = this->prefac * (result * this->a / this->b) * ez2;
+          }
+        } else {
+          result = this->prefac * (z + z2).exp();
+        }
+      }
+
       //! Computes 1F1
       inline double hyp1f1(double z, bool derivative, int n_terms) {
         using math::pow;
@@ -209,6 +234,41 @@ namespace rascal {
         }
         return res;
       }
+
+      /**
+       * Adaptive sum for a batch of z. The series are summed in lockstep so
+       * that the arithmetic vectorizes over z, and every element stops
+       * accumulating at its own bailout point like the scalar sum().
+       */
+      inline void sum(const Eigen::Ref<const Eigen::ArrayXd> & z,
+                      const Eigen::VectorXd & coefficient,
+                      Eigen::Ref<Eigen::ArrayXd> res) {
+        using ArrayB_t = Eigen::Array<bool, Eigen::Dynamic, 1>;
+        auto n_z{z.size()};
+        Eigen::ArrayXd zpow{z}, z4{z.square().square()}, a1{n_z};
+        ArrayB_t active{ArrayB_t::Constant(n_z, true)};
+        ArrayB_t not_converged{n_z};
+        res.setOnes();
+        for (size_t i{0}; i < this->mmax - 3; i += 4) {
+          a1 = zpow * (coefficient(i) +
+                       z * (coefficient(i + 1) +
+                            z * (coefficient(i + 2) + z * coefficient(i + 3))));
+          not_converged = (a1 >= this->tolerance * res);
+          res = active.select(res + a1, res);
+          active = active && not_converged;
+          if (not active.any()) {
+            break;
+          }
+          zpow *= z4;
+        }
+        if ((res > DOVERFLOW).any()) {
+          std::stringstream error{};
+          error << "Hyp1f1Series series expansion: a="
+                << std::to_string(this->a) << " b=" << std::to_string(this->b)
+                << " z=" << std::to_string(z.maxCoeff()) << std::endl;
+          throw std::overflow_error(error.str());
+        }
+      }
     };
 
     /**
@@ -515,6 +575,54 @@ namespace rascal {
           return this->hyp1f1_series.calc(z, z2, ez2, derivative);
         }
       }
+
+      /**
+       * Computes G(a,b,z) for a batch of z (see above). The elements that
+       * need the power series are evaluated together with the vectorized
+       * Hyp1f1Series::calc() and the (few) ones that need the asymptotic
+       * expansion one by one.
+       *
+       * @param result has to be of the same size as z
+       */
+      inline void calc(const Eigen::Ref<const Eigen::ArrayXd> & z,
+                       const Eigen::Ref<const Eigen::ArrayXd> & z2,
+                       const Eigen::Ref<const Eigen::ArrayXd> & ez2,
+                       Eigen::Ref<Eigen::ArrayXd> result,
+                       bool derivative = false) {
+        auto n_z{z.size()};
+        auto n_series{(z <= this->z_asympt).count()};
+        if (n_series == n_z) {
+          this->hyp1f1_series.calc(z, z2, ez2, result, derivative);
+          return;
+        } else if (n_series == 0) {
+          for (int i_z{0}; i_z < n_z; ++i_z) {
+            result(i_z) =
+                this->hyp1f1_asymptotic.calc(z(i_z), z2(i_z), derivative);
+          }
+          return;
+        }
+        // gather the elements that need the power series
+        Eigen::ArrayXd z_s{n_series}, z2_s{n_series}, ez2_s{n_series},
+            result_s{n_series};
+        for (int i_z{0}, i_s{0}; i_z < n_z; ++i_z) {
+          if (z(i_z) <= this->z_asympt) {
+            z_s(i_s) = z(i_z);
+            z2_s(i_s) = z2(i_z);
+            ez2_s(i_s) = ez2(i_z);
+            ++i_s;
+          }
+        }
+        this->hyp1f1_series.calc(z_s, z2_s, ez2_s, result_s, derivative);
+        for (int i_z{0}, i_s{0}; i_z < n_z; ++i_z) {
+          if (z(i_z) <= this->z_asympt) {
+            result(i_z) = result_s(i_s);
+            ++i_s;
+          } else {
+            result(i_z) =
+                this->hyp1f1_asymptotic.calc(z(i_z), z2(i_z), derivative);
+          }
+        }
+      }
     };
 
     /**
@@ -551,6 +659,14 @@ namespace rascal {
       Eigen::ArrayXd z{};
       Eigen::ArrayXd dz_dr{};
 
+      // same as above for a batch of distances, see calc_batch()
+      Eigen::ArrayXXd values_batch{};
+      Eigen::ArrayXXd derivatives_batch{};
+      Eigen::ArrayXXd z_batch{};
+      Eigen::ArrayXXd dz_dr_batch{};
+      Eigen::ArrayXd z2_batch{};
+      Eigen::ArrayXd ez2_batch{};
+
       inline int get_pos(int n_radial, int l_angular) {
         return l_angular + (this->max_angular + 1) * n_radial;
       }
@@ -680,6 +796,109 @@ namespace rascal {
         this->derivatives -= (2 * alpha_rij) * this->values;
       }
 
+      //! column of the batched results corresponding to n, l
+      inline int get_batch_pos(int n_radial, int l_angular) {
+        return n_radial + this->max_radial * l_angular;
+      }
+
+      //! batched version of calc_recursion()
+      inline void calc_recursion_batch(const Eigen::ArrayXd & alpha_rij) {
+        auto n_distances{alpha_rij.size()};
+        Eigen::ArrayXd M1p2p{n_distances}, M2p3p{n_distances},
+            MP1p2p{n_distances}, MP2p3p{n_distances}, M1p1p{n_distances},
+            Moo{n_distances}, MP1p1p{n_distances}, MPoo{n_distances};
+        auto & z2{this->z2_batch};
+        auto & ez2{this->ez2_batch};
+
+        for (size_t n_radial{0}; n_radial < this->max_radial; ++n_radial) {
+          // get the starting points for the recursion
+          auto z{this->z_batch.col(n_radial)};
+          int l_angular{static_cast<int>(this->max_angular)};
+          int ipos{this->get_pos(n_radial, l_angular)};
+          int bpos{this->get_batch_pos(n_radial, l_angular)};
+          this->hyp1f1[ipos].calc(z, z2, ez2, M1p2p);
+          this->values_batch.col(bpos) = M1p2p;
+          this->hyp1f1[ipos].calc(z, z2, ez2, M2p3p, true);
+          this->derivatives_batch.col(bpos) = M2p3p;
+
+          ipos = this->get_pos(n_radial, l_angular - 1);
+          bpos = this->get_batch_pos(n_radial, l_angular - 1);
+          this->hyp1f1[ipos].calc(z, z2, ez2, MP1p2p);
+          this->values_batch.col(bpos) = MP1p2p;
+          this->hyp1f1[ipos].calc(z, z2, ez2, MP2p3p, true);
+          this->derivatives_batch.col(bpos) = MP2p3p;
+          l_angular -= 2;
+          for (; l_angular > 0; l_angular -= 2) {
+            auto a{this->get_a(n_radial, l_angular)};
+            auto b{this->get_b(l_angular)};
+            // see recurence_G_to_der_downward and recurence_G_to_val_downward
+            M1p1p = z * M2p3p + M1p2p * (b + 1);
+            Moo = (z * (a - b) * M1p2p + M1p1p * b) / a;
+            bpos = this->get_batch_pos(n_radial, l_angular);
+            this->values_batch.col(bpos) = Moo;
+            this->derivatives_batch.col(bpos) = M1p1p;
+            M2p3p = M1p1p;
+            M1p2p = Moo;
+
+            a = this->get_a(n_radial, l_angular - 1);
+            b = this->get_b(l_angular - 1);
+            MP1p1p = z * MP2p3p + MP1p2p * (b + 1);
+            MPoo = (z * (a - b) * MP1p2p + MP1p1p * b) / a;
+            bpos = this->get_batch_pos(n_radial, l_angular - 1);
+            this->values_batch.col(bpos) = MPoo;
+            this->derivatives_batch.col(bpos) = MP1p1p;
+            MP2p3p = MP1p1p;
+            MP1p2p = MPoo;
+          }
+          // makes sure l == 0 is taken care of
+          if (this->max_angular % 2 == 0) {
+            auto a{this->get_a(n_radial, 0)};
+            auto b{this->get_b(0)};
+            M1p1p = z * M2p3p + M1p2p * (b + 1);
+            Moo = (z * (a - b) * M1p2p + M1p1p * b) / a;
+            bpos = this->get_batch_pos(n_radial, 0);
+            this->values_batch.col(bpos) = Moo;
+            this->derivatives_batch.col(bpos) = M1p1p;
+          }
+
+          for (size_t l_angular{0}; l_angular < this->max_angular + 1;
+               l_angular++) {
+            bpos = this->get_batch_pos(n_radial, l_angular);
+            this->derivatives_batch.col(bpos) *=
+                this->dz_dr_batch.col(n_radial);
+          }
+        }
+        // here is where dG/dz*dz/dr is computed
+        this->derivatives_batch -=
+            this->values_batch.colwise() * (2 * alpha_rij);
+      }
+
+      //! batched version of calc_direct()
+      inline void calc_direct_batch(const Eigen::ArrayXd & alpha_rij,
+                                    bool derivative) {
+        auto & z2{this->z2_batch};
+        auto & ez2{this->ez2_batch};
+        for (size_t n_radial{0}; n_radial < this->max_radial; n_radial++) {
+          auto z{this->z_batch.col(n_radial)};
+          for (size_t l_angular{0}; l_angular < this->max_angular + 1;
+               l_angular++) {
+            int ipos{this->get_pos(n_radial, l_angular)};
+            int bpos{this->get_batch_pos(n_radial, l_angular)};
+            this->hyp1f1[ipos].calc(z, z2, ez2, this->values_batch.col(bpos));
+            if (derivative) {
+              this->hyp1f1[ipos].calc(z, z2, ez2,
+                                      this->derivatives_batch.col(bpos), true);
+              this->derivatives_batch.col(bpos) *=
+                  this->dz_dr_batch.col(n_radial);
+            }
+          }
+        }
+        if (derivative) {
+          this->derivatives_batch -=
+              this->values_batch.colwise() * (2 * alpha_rij);
+        }
+      }
+
       //! computes G by direct evaluation
       inline void calc_direct(double r_ij, double alpha,
                               const Vector_Ref & fac_b, bool derivative) {
@@ -717,9 +936,57 @@ namespace rascal {
         }
       }
 
+      /**
+       * Computes G (and dG/dr) for all possible n, l values and for a batch
+       * of distances r_ij, e.g. all the neighbours of a center.
+       *
+       * The results are stored in a structure of arrays layout: one column
+       * per (n, l) pair, at index n + max_radial * l, running over the
+       * distances (see get_values_batch()). All the intermediates and
+       * the recurrence relations are evaluated with array operations over
+       * the distances so they vectorize.
+       */
+      inline void calc_batch(const Eigen::Ref<const Eigen::ArrayXd> & r_ij,
+                             double alpha, const Vector_Ref & fac_b,
+                             bool derivative = false) {
+        auto n_distances{r_ij.size()};
+        size_t n_cols{this->max_radial * (this->max_angular + 1)};
+        this->values_batch.resize(n_distances, n_cols);
+        this->derivatives_batch.resize(n_distances, n_cols);
+        this->z_batch.resize(n_distances, this->max_radial);
+        this->dz_dr_batch.resize(n_distances, this->max_radial);
+
+        // same intermediates as in calc_direct()
+        Eigen::ArrayXd alpha_rij{alpha * r_ij};
+        this->z2_batch = -r_ij * alpha_rij;
+        this->ez2_batch = this->z2_batch.exp();
+        for (size_t n_radial{0}; n_radial < this->max_radial; n_radial++) {
+          double inv_alpha_fac_b{1. / (alpha + fac_b(n_radial))};
+          this->z_batch.col(n_radial) = (alpha_rij * alpha) * inv_alpha_fac_b;
+          this->dz_dr_batch.col(n_radial) = this->z_batch.col(n_radial) * 2;
+          this->z_batch.col(n_radial) *= r_ij;
+        }
+
+        if (not this->recursion or this->max_angular < 3) {
+          this->calc_direct_batch(alpha_rij, derivative);
+        } else {
+          this->calc_recursion_batch(alpha_rij);
+        }
+      }
+
       //! get a reference to the computed G values
       inline Matrix_Ref get_values() { return Matrix_Ref(this->values); }
 
+      //! get the G values computed by calc_batch()
+      inline const Eigen::ArrayXXd & get_values_batch() const {
+        return this->values_batch;
+      }
+
+      //! get the G derivatives computed by calc_batch()
+      inline const Eigen::ArrayXXd & get_derivatives_batch() const {
+        return this->derivatives_batch;
+      }
+
       //! get a reference to the computed G derivatives
       inline Matrix_Ref get_derivatives() {
         return Matrix_Ref(this->derivatives);
@@ -0,0 +1,219 @@
+/**
+ * @file   interpolator.hh
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  Tabulation of a vector valued function of one variable and its
+ *         cubic Hermite interpolation
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_MATH_INTERPOLATOR_HH_
+#define SRC_MATH_INTERPOLATOR_HH_
+
+#include "math/math_utils.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace rascal {
+  namespace math {
+
+    /**
+     * Cubic Hermite spline of a vector valued function f(x) on a uniform
+     * grid of [x_min, x_max].
+     *
+     * The values and the derivatives of f are tabulated at the nodes of the
+     * grid and the number of intervals is doubled until the interpolation
+     * error at the middle of every interval is below the accuracy target.
+     * The error is measured as the largest absolute deviation relative to
+     * the largest tabulated value, i.e. every element of f is interpolated
+     * with the same absolute accuracy.
+     *
+     * The value of the interpolant has an O(h^4) error and its derivative an
+     * O(h^3) error where h is the grid spacing.
+     */
+    class CubicHermiteSpline {
+     public:
+      //! one column per node of the grid
+      using Table_t = Eigen::MatrixXd;
+
+      /**
+       * Tabulate function on [x_min, x_max].
+       *
+       * @param function is called as function(points, values, derivatives)
+       *        and fills the (n_outputs, points.size()) matrices values and
+       *        derivatives with f and df/dx at the points
+       * @param n_outputs number of elements of f
+       * @param accuracy target of the interpolation error
+       * @param n_intervals_max maximum number of intervals of the grid
+       *
+       * @throw runtime_error if the accuracy target can't be reached with
+       *        at most n_intervals_max intervals
+       */
+      template <class Function>
+      void initialize(double x_min, double x_max, size_t n_outputs,
+                      double accuracy, Function && function,
+                      size_t n_intervals_max = 1 << 16) {
+        if (not(x_max > x_min)) {
+          throw std::runtime_error("The range of the spline is empty");
+        }
+        this->x_min = x_min;
+        this->x_max = x_max;
+        this->n_intervals = 16;
+        this->update_grid_spacing();
+
+        Eigen::ArrayXd points{
+            Eigen::ArrayXd::LinSpaced(this->n_intervals + 1, x_min, x_max)};
+        this->values.resize(n_outputs, this->n_intervals + 1);
+        this->derivatives.resize(n_outputs, this->n_intervals + 1);
+        function(points, this->values, this->derivatives);
+
+        Table_t mid_values(n_outputs, this->n_intervals);
+        Table_t mid_derivatives(n_outputs, this->n_intervals);
+        while (true) {
+          Eigen::ArrayXd mid_points{
+              points.head(this->n_intervals) + 0.5 * this->grid_spacing};
+          mid_values.resize(n_outputs, this->n_intervals);
+          mid_derivatives.resize(n_outputs, this->n_intervals);
+          function(mid_points, mid_values, mid_derivatives);
+
+          // the interpolant at t = 1/2 is
+          // (y_i + y_{i+1}) / 2 + h (dy_i - dy_{i+1}) / 8
+          auto && n_i{this->n_intervals};
+          double scale{std::max(this->values.cwiseAbs().maxCoeff(),
+                                std::numeric_limits<double>::min())};
+          this->error =
+              (0.5 * (this->values.leftCols(n_i) +
+                      this->values.rightCols(n_i)) +
+               0.125 * this->grid_spacing *
+                   (this->derivatives.leftCols(n_i) -
+                    this->derivatives.rightCols(n_i)) -
+               mid_values)
+                  .cwiseAbs()
+                  .maxCoeff() /
+              scale;
+
+          if (not std::isfinite(this->error)) {
+            throw std::runtime_error(
+                "The function to interpolate is not finite on the range of "
+                "the spline");
+          }
+          if (this->error <= accuracy) {
+            break;
+          }
+          if (2 * this->n_intervals > n_intervals_max) {
+            std::stringstream err_str{};
+            err_str << "The spline could not reach an accuracy of "
+                    << accuracy << " (got " << this->error << ") with "
+                    << n_intervals_max << " intervals";
+            throw std::runtime_error(err_str.str());
+          }
+
+          // the middle points become nodes of the refined grid
+          Table_t refined_values(n_outputs, 2 * this->n_intervals + 1);
+          Table_t refined_derivatives(n_outputs, 2 * this->n_intervals + 1);
+          for (size_t i_node{0}; i_node < this->n_intervals; ++i_node) {
+            refined_values.col(2 * i_node) = this->values.col(i_node);
+            refined_values.col(2 * i_node + 1) = mid_values.col(i_node);
+            refined_derivatives.col(2 * i_node) = this->derivatives.col(i_node);
+            refined_derivatives.col(2 * i_node + 1) =
+                mid_derivatives.col(i_node);
+          }
+          refined_values.rightCols(1) = this->values.rightCols(1);
+          refined_derivatives.rightCols(1) = this->derivatives.rightCols(1);
+          this->values.swap(refined_values);
+          this->derivatives.swap(refined_derivatives);
+
+          this->n_intervals *= 2;
+          this->update_grid_spacing();
+          points = Eigen::ArrayXd::LinSpaced(this->n_intervals + 1, x_min,
+                                             x_max);
+        }
+      }
+
+      //! interpolated f(x), outside of [x_min, x_max] the first or last
+      //! interval is extrapolated
+      inline void interpolate(double x,
+                              Eigen::Ref<Eigen::VectorXd> result) const {
+        size_t i_node{this->locate(x)};
+        double t{x - this->x_min - i_node * this->grid_spacing};
+        t *= this->inv_grid_spacing;
+        double t2{t * t}, t3{t2 * t};
+        double h00{2 * t3 - 3 * t2 + 1}, h10{t3 - 2 * t2 + t},
+            h01{-2 * t3 + 3 * t2}, h11{t3 - t2};
+        result = h00 * this->values.col(i_node) +
+                 h01 * this->values.col(i_node + 1) +
+                 (h10 * this->grid_spacing) * this->derivatives.col(i_node) +
+                 (h11 * this->grid_spacing) * this->derivatives.col(i_node + 1);
+      }
+
+      //! derivative of the interpolant df/dx(x)
+      inline void
+      interpolate_derivative(double x,
+                             Eigen::Ref<Eigen::VectorXd> result) const {
+        size_t i_node{this->locate(x)};
+        double t{x - this->x_min - i_node * this->grid_spacing};
+        t *= this->inv_grid_spacing;
+        double t2{t * t};
+        double dh00{(6 * t2 - 6 * t) * this->inv_grid_spacing},
+            dh10{3 * t2 - 4 * t + 1}, dh11{3 * t2 - 2 * t};
+        result = dh00 * (this->values.col(i_node) -
+                         this->values.col(i_node + 1)) +
+                 dh10 * this->derivatives.col(i_node) +
+                 dh11 * this->derivatives.col(i_node + 1);
+      }
+
+      size_t get_n_intervals() const { return this->n_intervals; }
+
+      //! interpolation error reached by initialize()
+      double get_error() const { return this->error; }
+
+     protected:
+      //! index of the interval containing x
+      inline size_t locate(double x) const {
+        double x_rel{(x - this->x_min) * this->inv_grid_spacing};
+        if (not(x_rel > 0.)) {
+          return 0;
+        }
+        return std::min(static_cast<size_t>(x_rel), this->n_intervals - 1);
+      }
+
+      void update_grid_spacing() {
+        this->grid_spacing = (this->x_max - this->x_min) / this->n_intervals;
+        this->inv_grid_spacing = 1. / this->grid_spacing;
+      }
+
+      double x_min{0.};
+      double x_max{0.};
+      size_t n_intervals{0};
+      double grid_spacing{0.};
+      double inv_grid_spacing{0.};
+      double error{0.};
+      Table_t values{};
+      Table_t derivatives{};
+    };
+
+  }  // namespace math
+}  // namespace rascal
+
+#endif  // SRC_MATH_INTERPOLATOR_HH_
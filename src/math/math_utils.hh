@@ -30,6 +30,7 @@
 #define SRC_MATH_MATH_UTILS_HH_
 
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 #include <cmath>
 #include <limits>
 #include <cstdint>
@@ -68,6 +69,8 @@ namespace rascal {
     using Matrix_t =
         Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
     using Vector_t = Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor>;
+    //! compressed sparse row (CSR) matrix, with the index type of scipy
+    using SparseMatrix_t = Eigen::SparseMatrix<double, Eigen::RowMajor, int>;
 
     using MatrixX2_t = Eigen::Matrix<double, Eigen::Dynamic, 2>;
     using Matrix_Ref = typename Eigen::Ref<const Matrix_t>;
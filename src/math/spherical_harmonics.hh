@@ -32,6 +32,7 @@
 
 #include "math_utils.hh"
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 namespace rascal {
@@ -340,6 +341,194 @@ namespace rascal {
         this->calc(direction, this->calculate_derivatives);
       }
 
+      /**
+       * Compute the spherical harmonics (and optionally their gradients) of
+       * a batch of direction vectors, e.g. all the neighbours of a center.
+       *
+       * Same as calc() but the recurrence relations are evaluated with array
+       * operations over the directions, so they vectorize across the
+       * directions instead of across m. The method only reads the
+       * precomputed coefficients and writes to its arguments, so a single
+       * SphericalHarmonics object can be used by several threads.
+       *
+       * @param directions 3 x N matrix of direction vectors, they are
+       *                   normalized if necessary
+       *
+       * @param harmonics resized to N x \f$(\ell_\text{max}+1)^2\f$, the
+       *                  row index runs over the directions and the column
+       *                  index over \f$(\ell, m)\f$ in the same compact format
+       *                  as get_harmonics()
+       *
+       * @param harmonics_derivatives resized to
+       *                  N x \f$3(\ell_\text{max}+1)^2\f$, the x, y and z
+       *                  components are stored in consecutive blocks of
+       *                  \f$(\ell_\text{max}+1)^2\f$ columns with the same
+       *                  convention as get_harmonics_derivatives()
+       *
+       * @throw runtime_error if the derivatives are requested without having
+       *        been precomputed
+       */
+      void calc_batch(const Eigen::Ref<const Eigen::Matrix3Xd> & directions,
+                      Eigen::MatrixXd & harmonics,
+                      Eigen::MatrixXd & harmonics_derivatives,
+                      bool calculate_derivatives) const {
+        using std::sqrt;
+        using Array_t = Eigen::ArrayXd;
+        auto n_directions{directions.cols()};
+        size_t n_l{this->max_angular + 1};
+        size_t n_lm{n_l * n_l};
+        // columns of the associated Legendre polynomials, P_l^m is stored at
+        // l * (max_angular + 2) + m and P_l^{l+1} is zero
+        size_t n_m{this->max_angular + 2};
+        auto plm_col = [n_m](size_t angular_l, size_t m_count) {
+          return angular_l * n_m + m_count;
+        };
+
+        Array_t inv_norms{directions.colwise().norm().array().inverse()};
+        Array_t x{directions.row(0).transpose().array() * inv_norms};
+        Array_t y{directions.row(1).transpose().array() * inv_norms};
+        Array_t cos_theta{directions.row(2).transpose().array() * inv_norms};
+        Array_t sqrt_xy{(x.square() + y.square()).sqrt()};
+        // For a vector along the z-axis, define phi=0
+        auto on_axis{sqrt_xy < math::dbl_ftol};
+        Array_t inv_sqrt_xy{on_axis.select(0., sqrt_xy.inverse())};
+        Array_t cos_phi{on_axis.select(1., x * inv_sqrt_xy)};
+        Array_t sin_phi{on_axis.select(0., y * inv_sqrt_xy)};
+
+        // associated Legendre polynomials, see compute_assoc_legendre_polynom
+        Eigen::ArrayXXd alps{Eigen::ArrayXXd::Zero(n_directions, n_l * n_m)};
+        {
+          Array_t sin_theta{(1.0 - cos_theta.square()).sqrt()};
+          const double SQRT_INV_2PI = sqrt(0.5 / PI);
+          Array_t l_accum{Array_t::Constant(n_directions, SQRT_INV_2PI)};
+          alps.col(plm_col(0, 0)) = l_accum;
+          if (this->max_angular > 0) {
+            alps.col(plm_col(1, 0)) = cos_theta * SQRT_THREE * SQRT_INV_2PI;
+            l_accum *= -sqrt(3.0 / 2.0) * sin_theta;
+            alps.col(plm_col(1, 1)) = l_accum;
+          }
+          for (size_t angular_l{2}; angular_l < n_l; angular_l++) {
+            for (size_t m_count{0}; m_count < angular_l - 1; m_count++) {
+              alps.col(plm_col(angular_l, m_count)) =
+                  (cos_theta * alps.col(plm_col(angular_l - 1, m_count)) +
+                   this->coeff_b(angular_l, m_count) *
+                       alps.col(plm_col(angular_l - 2, m_count))) *
+                  this->coeff_a(angular_l, m_count);
+            }
+            alps.col(plm_col(angular_l, angular_l - 1)) =
+                l_accum * cos_theta * this->angular_coeffs1(angular_l);
+            l_accum *= sin_theta * this->angular_coeffs2(angular_l);
+            alps.col(plm_col(angular_l, angular_l)) = l_accum;
+          }
+        }
+
+        // cos(m phi) and sin(m phi), see compute_cos_sin_angle_multiples
+        Eigen::ArrayXXd cos_m_phi(n_directions, n_l);
+        Eigen::ArrayXXd sin_m_phi(n_directions, n_l);
+        cos_m_phi.col(0).setOnes();
+        sin_m_phi.col(0).setZero();
+        if (this->max_angular > 0) {
+          cos_m_phi.col(1) = cos_phi;
+          sin_m_phi.col(1) = sin_phi;
+        }
+        for (size_t m_count{2}; m_count < n_l; m_count++) {
+          cos_m_phi.col(m_count) = 2.0 * cos_phi * cos_m_phi.col(m_count - 1) -
+                                   cos_m_phi.col(m_count - 2);
+          sin_m_phi.col(m_count) = 2.0 * cos_phi * sin_m_phi.col(m_count - 1) -
+                                   sin_m_phi.col(m_count - 2);
+        }
+
+        // see compute_spherical_harmonics
+        harmonics.resize(n_directions, n_lm);
+        size_t lm_base{0};
+        for (size_t angular_l{0}; angular_l < n_l; angular_l++) {
+          harmonics.col(lm_base + angular_l) =
+              (alps.col(plm_col(angular_l, 0)) * INV_SQRT_TWO).matrix();
+          for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+            harmonics.col(lm_base + angular_l + m_count) =
+                (alps.col(plm_col(angular_l, m_count)) *
+                 cos_m_phi.col(m_count))
+                    .matrix();
+            harmonics.col(lm_base + angular_l - m_count) =
+                (alps.col(plm_col(angular_l, m_count)) *
+                 sin_m_phi.col(m_count))
+                    .matrix();
+          }
+          lm_base += 2 * angular_l + 1;
+        }
+
+        if (not calculate_derivatives) {
+          return;
+        }
+        if (not this->derivatives_precomputed) {
+          throw std::runtime_error(
+              "Resources for computation of dervatives have not been "
+              "initialized. Please set calculate_derivatives flag on "
+              "construction of the SphericalHarmonics object or during "
+              "precomputation.");
+        }
+
+        // see compute_spherical_harmonics_derivatives
+        harmonics_derivatives.resize(n_directions, 3 * n_lm);
+        auto && d_dx{harmonics_derivatives.leftCols(n_lm).array()};
+        auto && d_dy{harmonics_derivatives.middleCols(n_lm, n_lm).array()};
+        auto && d_dz{harmonics_derivatives.rightCols(n_lm).array()};
+        d_dx.col(0).setZero();
+        d_dy.col(0).setZero();
+        d_dz.col(0).setZero();
+
+        Array_t & sin_theta{sqrt_xy};
+        // singularity at the poles for the first form of the phi derivative
+        // factor, at the equator for the second
+        auto near_pole{sin_theta <= 0.1};
+        Array_t inv_sin_theta{near_pole.select(0., sin_theta.inverse())};
+        Array_t inv_cos_theta{near_pole.select(cos_theta.inverse(), 0.)};
+        Array_t legendre_polynom_difference(n_directions);
+        Array_t phi_derivative_factor(n_directions);
+        size_t l_block_index{1};
+        for (size_t angular_l{1}; angular_l < n_l; angular_l++) {
+          size_t l_0{l_block_index + angular_l};
+          Array_t dp_l1{this->plm_factors(angular_l, 0) * INV_SQRT_TWO *
+                        alps.col(plm_col(angular_l, 1))};
+          d_dx.col(l_0) = cos_theta * cos_phi * dp_l1;
+          d_dy.col(l_0) = cos_theta * sin_phi * dp_l1;
+          d_dz.col(l_0) = -1.0 * sin_theta * dp_l1;
+
+          for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+            auto && plm_m{this->plm_factors(angular_l, m_count - 1)};
+            auto && plm_mp1{this->plm_factors(angular_l, m_count)};
+            auto && alp_mm1{alps.col(plm_col(angular_l, m_count - 1))};
+            auto && alp_m{alps.col(plm_col(angular_l, m_count))};
+            auto && alp_mp1{alps.col(plm_col(angular_l, m_count + 1))};
+            legendre_polynom_difference = plm_m * alp_mm1 - plm_mp1 * alp_mp1;
+            phi_derivative_factor = near_pole.select(
+                -0.5 * inv_cos_theta * (plm_m * alp_mm1 + plm_mp1 * alp_mp1),
+                static_cast<double>(m_count) * inv_sin_theta * alp_m);
+
+            auto && cos_m{cos_m_phi.col(m_count)};
+            auto && sin_m{sin_m_phi.col(m_count)};
+            size_t i_pos{l_0 + m_count}, i_neg{l_0 - m_count};
+            d_dx.col(i_pos) = sin_phi * phi_derivative_factor * sin_m +
+                              -0.5 * cos_theta * cos_phi * cos_m *
+                                  legendre_polynom_difference;
+            d_dx.col(i_neg) = -1.0 * sin_phi * phi_derivative_factor * cos_m +
+                              -0.5 * cos_theta * cos_phi * sin_m *
+                                  legendre_polynom_difference;
+            d_dy.col(i_pos) = -1.0 * cos_phi * phi_derivative_factor * sin_m +
+                              -0.5 * cos_theta * sin_phi * cos_m *
+                                  legendre_polynom_difference;
+            d_dy.col(i_neg) = cos_phi * phi_derivative_factor * cos_m +
+                              -0.5 * cos_theta * sin_phi * sin_m *
+                                  legendre_polynom_difference;
+            d_dz.col(i_pos) =
+                0.5 * sin_theta * cos_m * legendre_polynom_difference;
+            d_dz.col(i_neg) =
+                0.5 * sin_theta * sin_m * legendre_polynom_difference;
+          }
+          l_block_index += (2 * angular_l + 1);
+        }
+      }
+
       /**
        * Compute \f$\cos(m\phi)\f$ and \f$\sin(m\phi)\f$ from the recurrence
        * relations
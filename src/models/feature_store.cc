@@ -0,0 +1,286 @@
+/**
+ * @file   feature_store.cc
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  implementation of the binary file of computed features
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "models/feature_store.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace rascal {
+
+  namespace internal {
+
+    constexpr char FeatureStoreMagic[8] = {'R', 'S', 'C', 'L',
+                                           'F', 'T', 'R', '1'};
+    constexpr std::uint64_t FeatureStoreVersion{1};
+
+    struct FeatureStoreHeader {
+      char magic[8];
+      std::uint64_t version;
+      std::uint64_t n_structures;
+      std::uint64_t n_centers;
+      std::uint64_t n_keys;
+      std::uint64_t key_size;
+      std::uint64_t n_entries;
+      std::uint64_t block_rows;
+      std::uint64_t block_cols;
+      std::uint64_t name_size;
+    };
+
+    //! start of each array of the file in bytes, see FeatureStore
+    struct FeatureStoreLayout {
+      explicit FeatureStoreLayout(const FeatureStoreHeader & header)
+          : name{next(0, sizeof(FeatureStoreHeader))},
+            keys{next(name, header.name_size)},
+            key_offsets{next(keys, header.n_keys * header.key_size *
+                                       sizeof(std::int32_t))},
+            structure_offsets{next(key_offsets, (header.n_keys + 1) *
+                                                    sizeof(std::uint64_t))},
+            entry_centers{next(structure_offsets, (header.n_structures + 1) *
+                                                      sizeof(std::uint64_t))},
+            squared_norms{
+                next(entry_centers, header.n_entries * sizeof(std::uint64_t))},
+            values{next(squared_norms, header.n_centers * sizeof(double))},
+            n_bytes{next(values, header.n_entries * header.block_rows *
+                                     header.block_cols * sizeof(double))} {}
+
+      //! start of the array following n_bytes from start, 8 bytes aligned
+      static size_t next(size_t start, size_t n_bytes) {
+        return start + (n_bytes + 7) / 8 * 8;
+      }
+
+      size_t name;
+      size_t keys;
+      size_t key_offsets;
+      size_t structure_offsets;
+      size_t entry_centers;
+      size_t squared_norms;
+      size_t values;
+      size_t n_bytes;
+    };
+
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  FeatureStore::FeatureStore(const std::string & filename,
+                             const std::string & representation_name)
+      : file{filename} {
+    auto bytes{this->file.data()};
+    internal::FeatureStoreHeader header{};
+    if (this->file.size() < sizeof(header)) {
+      throw std::runtime_error(filename + " is not a feature store.");
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    internal::FeatureStoreLayout layout{header};
+    if (std::memcmp(header.magic, internal::FeatureStoreMagic,
+                    sizeof(header.magic)) != 0 or
+        header.version != internal::FeatureStoreVersion or
+        layout.n_bytes != this->file.size()) {
+      throw std::runtime_error(filename +
+                               " is not a feature store or is corrupted.");
+    }
+    this->name.assign(bytes + layout.name, header.name_size);
+    if (not representation_name.empty() and
+        representation_name != this->name) {
+      throw std::runtime_error("The features of " + filename +
+                               " are not the ones of the representation " +
+                               representation_name);
+    }
+    this->n_structures = header.n_structures;
+    this->n_centers = header.n_centers;
+    this->n_keys = header.n_keys;
+    this->key_size = header.key_size;
+    this->n_entries = header.n_entries;
+    this->block_rows = static_cast<int>(header.block_rows);
+    this->block_cols = static_cast<int>(header.block_cols);
+    this->keys = reinterpret_cast<const std::int32_t *>(bytes + layout.keys);
+    this->key_offsets =
+        reinterpret_cast<const std::uint64_t *>(bytes + layout.key_offsets);
+    this->structure_offsets = reinterpret_cast<const std::uint64_t *>(
+        bytes + layout.structure_offsets);
+    this->entry_centers =
+        reinterpret_cast<const std::uint64_t *>(bytes + layout.entry_centers);
+    this->squared_norms =
+        reinterpret_cast<const double *>(bytes + layout.squared_norms);
+    this->values = reinterpret_cast<const double *>(bytes + layout.values);
+
+    if (this->key_offsets[0] != 0 or
+        this->key_offsets[this->n_keys] != this->n_entries or
+        not std::is_sorted(this->key_offsets,
+                           this->key_offsets + this->n_keys + 1) or
+        this->structure_offsets[0] != 0 or
+        this->structure_offsets[this->n_structures] != this->n_centers or
+        not std::is_sorted(this->structure_offsets,
+                           this->structure_offsets + this->n_structures + 1)) {
+      throw std::runtime_error(filename + " has inconsistent offsets.");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::uint64_t FeatureStore::get_name_hash() const {
+    return FeatureStore::get_name_hash(this->name);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::uint64_t
+  FeatureStore::get_name_hash(const std::string & representation_name) {
+    std::uint64_t hash{14695981039346656037ULL};
+    for (unsigned char character : representation_name) {
+      hash ^= character;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureStore::check_key_index(size_t i_key) const {
+    if (i_key >= this->n_keys) {
+      throw std::out_of_range("Key " + std::to_string(i_key) +
+                              " is not in the store of " +
+                              std::to_string(this->n_keys) + " keys.");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto FeatureStore::get_key(size_t i_key) const -> Key_t {
+    this->check_key_index(i_key);
+    auto first{this->keys + i_key * this->key_size};
+    return Key_t(first, first + this->key_size);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::vector<size_t> FeatureStore::get_structure_offsets() const {
+    return std::vector<size_t>(this->structure_offsets,
+                               this->structure_offsets + this->n_structures +
+                                   1);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto FeatureStore::get_centers(size_t i_key) const -> Centers_t {
+    this->check_key_index(i_key);
+    auto first{this->key_offsets[i_key]};
+    return Centers_t(this->entry_centers + first,
+                     this->key_offsets[i_key + 1] - first);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto FeatureStore::get_values(size_t i_key) const -> Values_t {
+    this->check_key_index(i_key);
+    auto first{this->key_offsets[i_key]};
+    Eigen::Index block_size{this->block_rows * this->block_cols};
+    return Values_t(this->values + first * block_size,
+                    this->key_offsets[i_key + 1] - first, block_size);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  Eigen::Map<const Eigen::VectorXd> FeatureStore::get_squared_norms() const {
+    return Eigen::Map<const Eigen::VectorXd>(this->squared_norms,
+                                             this->n_centers);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureStore::write_blocks(const std::string & filename,
+                                  const std::string & representation_name,
+                                  int block_rows, int block_cols,
+                                  const std::vector<size_t> & structure_offsets,
+                                  const std::map<Key_t, Block> & blocks,
+                                  const std::vector<double> & squared_norms) {
+    internal::FeatureStoreHeader header{};
+    std::memcpy(header.magic, internal::FeatureStoreMagic,
+                sizeof(header.magic));
+    header.version = internal::FeatureStoreVersion;
+    header.n_structures = structure_offsets.size() - 1;
+    header.n_centers = squared_norms.size();
+    header.n_keys = blocks.size();
+    header.key_size = blocks.empty() ? 0 : blocks.begin()->first.size();
+    header.n_entries = 0;
+    for (const auto & block : blocks) {
+      if (block.first.size() != header.key_size) {
+        throw std::runtime_error(
+            "The keys of the features should have the same size.");
+      }
+      header.n_entries += block.second.centers.size();
+    }
+    header.block_rows = static_cast<std::uint64_t>(block_rows);
+    header.block_cols = static_cast<std::uint64_t>(block_cols);
+    header.name_size = representation_name.size();
+    internal::FeatureStoreLayout layout{header};
+
+    std::ofstream writer(filename, std::ios::binary | std::ios::trunc);
+    if (not writer.is_open()) {
+      throw std::runtime_error(std::string("Could not open the file: ") +
+                               filename);
+    }
+    // arrays start on a multiple of 8 bytes, see FeatureStoreLayout
+    auto pad_to = [&writer](size_t start) {
+      while (static_cast<size_t>(writer.tellp()) < start) {
+        writer.put('\0');
+      }
+    };
+    auto write_bytes = [&writer](const void * values, size_t n_bytes) {
+      writer.write(static_cast<const char *>(values), n_bytes);
+    };
+    write_bytes(&header, sizeof(header));
+    pad_to(layout.name);
+    write_bytes(representation_name.data(), representation_name.size());
+
+    pad_to(layout.keys);
+    std::vector<std::uint64_t> key_offsets{0};
+    for (const auto & block : blocks) {
+      std::vector<std::int32_t> key(block.first.begin(), block.first.end());
+      write_bytes(key.data(), key.size() * sizeof(std::int32_t));
+      key_offsets.push_back(key_offsets.back() + block.second.centers.size());
+    }
+    pad_to(layout.key_offsets);
+    write_bytes(key_offsets.data(),
+                key_offsets.size() * sizeof(std::uint64_t));
+
+    pad_to(layout.structure_offsets);
+    std::vector<std::uint64_t> offsets(structure_offsets.begin(),
+                                       structure_offsets.end());
+    write_bytes(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+
+    pad_to(layout.entry_centers);
+    for (const auto & block : blocks) {
+      write_bytes(block.second.centers.data(),
+                  block.second.centers.size() * sizeof(std::uint64_t));
+    }
+    pad_to(layout.squared_norms);
+    write_bytes(squared_norms.data(), squared_norms.size() * sizeof(double));
+
+    pad_to(layout.values);
+    for (const auto & block : blocks) {
+      write_bytes(block.second.values.data(),
+                  block.second.values.size() * sizeof(double));
+    }
+    pad_to(layout.n_bytes);
+    if (not writer.good()) {
+      throw std::runtime_error(std::string("Could not write the file: ") +
+                               filename);
+    }
+  }
+
+}  // namespace rascal
@@ -0,0 +1,289 @@
+/**
+ * @file   feature_store.hh
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  binary file of computed features read through a memory map
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_MODELS_FEATURE_STORE_HH_
+#define SRC_MODELS_FEATURE_STORE_HH_
+
+#include "math/math_utils.hh"
+#include "utils/mapped_file.hh"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Read-only copy of the features (a BlockSparseProperty, e.g. the SOAP
+   * vectors) computed on a set of structures, stored in a binary file that
+   * is memory mapped so that they can be used again, e.g. by the kernels,
+   * without computing nor copying them.
+   *
+   * The features are grouped by key like in internal::KeyBlockedFeatures:
+   * the block of a key holds the features of all the centers that have it
+   * as the rows of a row major matrix, sorted by center. The centers are
+   * numbered structure after structure. The file starts with a header
+   * (magic string, format version and the sizes below) followed by
+   * contiguous arrays, each starting on a multiple of 8 bytes:
+   *
+   *   - name, char (name_size): name of the representation, i.e. the
+   *     calculator's get_name()
+   *   - keys, int32 (n_keys, key_size), sorted
+   *   - key offsets, uint64 (n_keys + 1): first entry of each key
+   *   - structure offsets, uint64 (n_structures + 1): first center of each
+   *     structure
+   *   - entry centers, uint64 (n_entries): center of each entry
+   *   - squared norms, double (n_centers): of the features of each center
+   *   - values, double (n_entries, block_rows * block_cols)
+   *
+   * in the byte order of the machine that wrote it. The values are stored in
+   * double whatever the precision of the property they come from. All the
+   * keys have the same size and all the blocks of a center the same shape,
+   * which holds for the calculators of the library.
+   */
+  class FeatureStore {
+   public:
+    using Key_t = std::vector<int>;
+    using Values_t = Eigen::Map<const math::Matrix_t>;
+    using Centers_t =
+        Eigen::Map<const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>>;
+
+    /**
+     * Map the file, which is unmapped with the store.
+     *
+     * @param representation_name if not empty, the name the features have
+     *        to be registered with, e.g. the get_name() of the calculator
+     *        that is expected to have computed them
+     */
+    explicit FeatureStore(const std::string & filename,
+                          const std::string & representation_name = "");
+
+    //! the pointers refer to the mapping, which is owned by the store
+    FeatureStore(const FeatureStore &) = delete;
+    FeatureStore(FeatureStore &&) = delete;
+    FeatureStore & operator=(const FeatureStore &) = delete;
+    FeatureStore & operator=(FeatureStore &&) = delete;
+
+    //! name of the representation
+    inline const std::string & get_name() const { return this->name; }
+
+    //! hash of the name of the representation, see get_name_hash()
+    std::uint64_t get_name_hash() const;
+
+    inline size_t get_n_structures() const { return this->n_structures; }
+
+    inline size_t get_n_centers() const { return this->n_centers; }
+
+    inline size_t get_n_keys() const { return this->n_keys; }
+
+    //! shape of the features of a center for a key
+    inline int get_block_rows() const { return this->block_rows; }
+    inline int get_block_cols() const { return this->block_cols; }
+
+    Key_t get_key(size_t i_key) const;
+
+    //! first center of each structure and the number of centers at the back
+    std::vector<size_t> get_structure_offsets() const;
+
+    //! centers that have the key i_key
+    Centers_t get_centers(size_t i_key) const;
+
+    //! features of get_centers(i_key) for the key i_key, one per row
+    Values_t get_values(size_t i_key) const;
+
+    //! squared norm of the features of each center
+    Eigen::Map<const Eigen::VectorXd> get_squared_norms() const;
+
+    /**
+     * Register the features in the managers of a collection, e.g. to use
+     * them with the functions that take a collection and a calculator,
+     * under the name of the store. The managers should have the same
+     * centers as when the store was written. This copies the features.
+     */
+    template <class Property_t, class StructureManagers>
+    void fill_properties(StructureManagers & managers) const;
+
+    /**
+     * Write the features registered as representation_name in managers.
+     */
+    template <class Property_t, class StructureManagers>
+    static void write(const std::string & filename,
+                      const StructureManagers & managers,
+                      const std::string & representation_name);
+
+    /**
+     * Hash (64 bits FNV-1a) of the name of a representation, i.e. of the
+     * hypers of its calculator, which is the same on all platforms and can
+     * be used to name the file of a cache of features.
+     */
+    static std::uint64_t get_name_hash(const std::string & representation_name);
+
+   protected:
+    //! the features of the centers that have a key
+    struct Block {
+      std::vector<std::uint64_t> centers{};
+      std::vector<double> values{};
+    };
+
+    static void write_blocks(const std::string & filename,
+                             const std::string & representation_name,
+                             int block_rows, int block_cols,
+                             const std::vector<size_t> & structure_offsets,
+                             const std::map<Key_t, Block> & blocks,
+                             const std::vector<double> & squared_norms);
+
+    void check_key_index(size_t i_key) const;
+
+    internal::MappedFile file;
+
+    std::string name{};
+    size_t n_structures{0};
+    size_t n_centers{0};
+    size_t n_keys{0};
+    size_t key_size{0};
+    size_t n_entries{0};
+    int block_rows{0};
+    int block_cols{0};
+
+    const std::int32_t * keys{nullptr};
+    const std::uint64_t * key_offsets{nullptr};
+    const std::uint64_t * structure_offsets{nullptr};
+    const std::uint64_t * entry_centers{nullptr};
+    const double * squared_norms{nullptr};
+    const double * values{nullptr};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <class Property_t, class StructureManagers>
+  void FeatureStore::write(const std::string & filename,
+                           const StructureManagers & managers,
+                           const std::string & representation_name) {
+    std::map<Key_t, Block> blocks{};
+    std::vector<size_t> structure_offsets{0};
+    std::vector<double> squared_norms{};
+    int block_rows{-1}, block_cols{-1};
+    for (auto & manager : managers) {
+      auto && property{manager->template get_validated_property_ref<Property_t>(
+          representation_name)};
+      if (block_rows == -1) {
+        block_rows = property.get_nb_row();
+        block_cols = property.get_nb_col();
+      } else if (block_rows != property.get_nb_row() or
+                 block_cols != property.get_nb_col()) {
+        throw std::runtime_error(
+            "The features should have the same shape in all structures.");
+      }
+      for (auto center : manager) {
+        double squared_norm{0.};
+        for (auto element : property[center]) {
+          auto && key{element.first};
+          auto && center_values{element.second};
+          if (center_values.rows() != block_rows or
+              center_values.cols() != block_cols) {
+            throw std::runtime_error(
+                "The features should have the same shape for all keys.");
+          }
+          auto & block{blocks[Key_t(key.begin(), key.end())]};
+          block.centers.push_back(squared_norms.size());
+          block.values.insert(block.values.end(), center_values.data(),
+                              center_values.data() + center_values.size());
+          squared_norm += center_values.template cast<double>().squaredNorm();
+        }
+        squared_norms.push_back(squared_norm);
+      }
+      structure_offsets.push_back(squared_norms.size());
+    }
+    FeatureStore::write_blocks(filename, representation_name,
+                               std::max(block_rows, 0), std::max(block_cols, 0),
+                               structure_offsets, blocks, squared_norms);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class Property_t, class StructureManagers>
+  void FeatureStore::fill_properties(StructureManagers & managers) const {
+    using PropertyKey_t = typename Property_t::Key_t;
+    if (static_cast<size_t>(managers.size()) != this->n_structures) {
+      throw std::runtime_error(
+          "There should be as many structures as in the feature store.");
+    }
+    // first row of each block not yet given to a center
+    std::vector<size_t> next_entries(this->key_offsets,
+                                     this->key_offsets + this->n_keys);
+    std::vector<PropertyKey_t> keys{};
+    for (size_t i_key{0}; i_key < this->n_keys; ++i_key) {
+      auto key{this->get_key(i_key)};
+      keys.emplace_back(key.begin(), key.end());
+    }
+    size_t i_structure{0};
+    for (auto & manager : managers) {
+      if (manager->size() != this->structure_offsets[i_structure + 1] -
+                                 this->structure_offsets[i_structure]) {
+        throw std::runtime_error(
+            "The structures do not have the centers of the feature store.");
+      }
+      auto && property{
+          manager->template get_property_ref<Property_t>(this->name)};
+      property.clear();
+      property.set_shape(this->block_rows, this->block_cols);
+      property.resize();
+      size_t i_center{this->structure_offsets[i_structure]};
+      for (auto center : manager) {
+        std::vector<size_t> center_keys{};
+        for (size_t i_key{0}; i_key < this->n_keys; ++i_key) {
+          auto & entry{next_entries[i_key]};
+          if (entry < this->key_offsets[i_key + 1] and
+              this->entry_centers[entry] == i_center) {
+            center_keys.push_back(i_key);
+          }
+        }
+        std::vector<PropertyKey_t> center_key_values{};
+        for (auto & i_key : center_keys) {
+          center_key_values.push_back(keys[i_key]);
+        }
+        auto && center_features{property[center]};
+        center_features.resize(center_key_values, this->block_rows,
+                               this->block_cols);
+        size_t block_size{static_cast<size_t>(this->block_rows) *
+                          static_cast<size_t>(this->block_cols)};
+        for (auto & i_key : center_keys) {
+          auto && center_values{center_features[keys[i_key]]};
+          center_values =
+              Eigen::Map<const math::Matrix_t>(
+                  this->values + next_entries[i_key] * block_size,
+                  this->block_rows, this->block_cols)
+                  .template cast<typename Property_t::Scalar_t>();
+          ++next_entries[i_key];
+        }
+        ++i_center;
+      }
+      property.set_updated_status(true);
+      ++i_structure;
+    }
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_MODELS_FEATURE_STORE_HH_
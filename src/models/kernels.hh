@@ -29,78 +29,762 @@
 #define SRC_MODELS_KERNELS_HH_
 
 #include "math/math_utils.hh"
+#include "models/feature_store.hh"
 #include "structure_managers/structure_manager_collection.hh"
 #include "json_io.hh"
+#include "utils/parallel_for.hh"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <vector>
 
 namespace rascal {
 
   namespace internal {
-    enum class KernelType { Cosine };
+    enum class KernelType { Cosine, Polynomial, Gaussian };
 
     enum class TargetType { Structure, Atom };
 
-    struct KernelImplBase {
-      using Hypers_t = json;
+    /**
+     * How the kernels between the centers of two structures are reduced to
+     * the structure kernel: their average, their sum, or their average
+     * normalized by the self kernels of the two structures,
+     * K(A, B) / sqrt(K(A, A) K(B, B)).
+     */
+    enum class StructureReduction { Average, Sum, NormalizedAverage };
+
+    /**
+     * Features of a set of structures grouped by key (e.g. species pair) for
+     * the computation of kernels.
+     *
+     * The block of a key holds, as the rows of a dense matrix, the features
+     * of all the centers that have this key, so the contribution of a key to
+     * the dot products between two sets of centers is a single matrix
+     * product. The centers are numbered structure after structure, and the
+     * rows of the blocks are sorted by center so the centers of consecutive
+     * structures are a contiguous range of rows of each block.
+     *
+     * The features are held in Precision, e.g. float for the features
+     * computed in single precision, which is also the precision of the
+     * matrix products between the blocks. The dot products and the kernels
+     * are accumulated in double.
+     */
+    template <class Key, class Precision = double>
+    struct KeyBlockedFeatures {
+      using Key_t = Key;
+      using Values_t = Eigen::Matrix<Precision, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor>;
+
+      struct Block {
+        Block() = default;
+        Block(const Block &) = delete;
+        Block(Block &&) = default;
+
+        //! center of each row of values
+        std::vector<size_t> centers{};
+        //! features of the centers, one per row, in storage or in the
+        //! mapped file of a FeatureStore
+        Eigen::Map<const Values_t> values{nullptr, 0, 0};
+        //! the features gathered from the managers
+        Values_t storage{};
+      };
+
+      std::map<Key_t, Block> blocks{};
+
+      //! first center of each structure, and the number of centers at the back
+      std::vector<size_t> structure_offsets{0};
+
+      //! squared norm of the features of each center
+      Eigen::VectorXd squared_norms{};
+
+      //! gather the features registered as representation_name in managers
+      template <class Property_t, class StructureManagers>
+      void fill(const StructureManagers & managers,
+                const std::string & representation_name) {
+        using PropertyRow_t =
+            Eigen::Matrix<typename Property_t::Scalar_t, 1, Eigen::Dynamic>;
+        this->blocks.clear();
+        this->structure_offsets.assign(1, 0);
+        // count the rows and columns of each block before filling them
+        std::map<Key_t, std::pair<size_t, int>> shapes{};
+        for (auto & manager : managers) {
+          auto && property{
+              manager->template get_validated_property_ref<Property_t>(
+                  representation_name)};
+          for (auto center : manager) {
+            for (auto element : property[center]) {
+              auto & shape{shapes[element.first]};
+              ++shape.first;
+              shape.second = static_cast<int>(element.second.size());
+            }
+          }
+          this->structure_offsets.push_back(this->structure_offsets.back() +
+                                            manager->size());
+        }
+        for (const auto & shape : shapes) {
+          auto & block{this->blocks[shape.first]};
+          block.centers.reserve(shape.second.first);
+          block.storage.resize(shape.second.first, shape.second.second);
+          new (&block.values) Eigen::Map<const Values_t>(
+              block.storage.data(), block.storage.rows(),
+              block.storage.cols());
+        }
+
+        this->squared_norms = Eigen::VectorXd::Zero(this->get_n_centers());
+        size_t i_center{0};
+        for (auto & manager : managers) {
+          auto && property{
+              manager->template get_validated_property_ref<Property_t>(
+                  representation_name)};
+          for (auto center : manager) {
+            for (auto element : property[center]) {
+              auto & block{this->blocks[element.first]};
+              auto && values{element.second};
+              if (values.size() != block.values.cols()) {
+                throw std::runtime_error(
+                    "The features of a key should have the same size for "
+                    "all centers.");
+              }
+              auto && row{block.storage.row(block.centers.size())};
+              row = Eigen::Map<const PropertyRow_t>(values.data(),
+                                                    values.size())
+                        .template cast<Precision>();
+              this->squared_norms(i_center) +=
+                  row.template cast<double>().squaredNorm();
+              block.centers.push_back(i_center);
+            }
+            ++i_center;
+          }
+        }
+      }
+
+      /**
+       * use the features of a FeatureStore, whose values are read in place
+       * from the mapped file, which has to outlive this object
+       */
+      void map(const FeatureStore & store) {
+        static_assert(std::is_same<Precision, double>::value,
+                      "The values of a FeatureStore are in double.");
+        this->blocks.clear();
+        this->structure_offsets = store.get_structure_offsets();
+        this->squared_norms = store.get_squared_norms();
+        for (size_t i_key{0}; i_key < store.get_n_keys(); ++i_key) {
+          auto key{store.get_key(i_key)};
+          auto & block{this->blocks[Key_t(key.begin(), key.end())]};
+          auto centers{store.get_centers(i_key)};
+          block.centers.assign(centers.data(), centers.data() + centers.size());
+          auto values{store.get_values(i_key)};
+          new (&block.values) Eigen::Map<const math::Matrix_t>(
+              values.data(), values.rows(), values.cols());
+        }
+      }
+
+      inline size_t get_n_structures() const {
+        return this->structure_offsets.size() - 1;
+      }
+
+      inline size_t get_n_centers() const {
+        return this->structure_offsets.back();
+      }
+
+      //! first row of block whose center is not before center
+      static inline Eigen::Index get_row(const Block & block, size_t center) {
+        return std::lower_bound(block.centers.begin(), block.centers.end(),
+                                center) -
+               block.centers.begin();
+      }
+
+      /**
+       * First center of each target, i.e. of each structure or of each
+       * center, and the number of centers at the back.
+       */
+      std::vector<size_t> get_target_offsets(TargetType target_type) const {
+        if (target_type == TargetType::Structure) {
+          return this->structure_offsets;
+        }
+        std::vector<size_t> offsets(this->get_n_centers() + 1);
+        std::iota(offsets.begin(), offsets.end(), 0);
+        return offsets;
+      }
     };
 
-    template <internal::KernelType Type>
-    struct KernelImpl {};
+    /**
+     * Split consecutive targets into tiles of at most max_tile_centers
+     * centers (unless a single target is larger).
+     *
+     * @param offsets first center of each target and the number of centers
+     *                at the back, see KeyBlockedFeatures::get_target_offsets
+     * @return the first target of each tile and the number of targets at the
+     *         back
+     */
+    inline std::vector<size_t> get_tiles(const std::vector<size_t> & offsets,
+                                         size_t max_tile_centers) {
+      size_t n_targets{offsets.size() - 1};
+      std::vector<size_t> tiles{0};
+      for (size_t i_target{0}; i_target < n_targets; ++i_target) {
+        if (i_target > tiles.back() and
+            offsets[i_target + 1] - offsets[tiles.back()] > max_tile_centers) {
+          tiles.push_back(i_target);
+        }
+      }
+      if (n_targets > 0) {
+        tiles.push_back(n_targets);
+      }
+      return tiles;
+    }
 
-    template <>
-    struct KernelImpl<internal::KernelType::Cosine> : KernelImplBase {
-      using Hypers_t = typename KernelImplBase::Hypers_t;
+    /**
+     * result += values_a * values_b^T, the product being computed in the
+     * precision of the features and accumulated in double
+     */
+    template <class Result, class ValuesA, class ValuesB>
+    inline void add_block_product(Result && result, const ValuesA & values_a,
+                                  const ValuesB & values_b, std::true_type) {
+      result.noalias() += values_a * values_b.transpose();
+    }
 
-      //! exponent of the cosine kernel
-      size_t zeta{1};
+    template <class Result, class ValuesA, class ValuesB>
+    inline void add_block_product(Result && result, const ValuesA & values_a,
+                                  const ValuesB & values_b, std::false_type) {
+      result += (values_a * values_b.transpose()).template cast<double>();
+    }
 
-      KernelImpl() = default;
+    template <class Result, class ValuesA, class ValuesB>
+    inline void add_block_product(Result && result, const ValuesA & values_a,
+                                  const ValuesB & values_b) {
+      using IsDouble_t = std::is_same<typename ValuesA::Scalar, double>;
+      add_block_product(std::forward<Result>(result), values_a, values_b,
+                        IsDouble_t{});
+    }
 
-      explicit KernelImpl(const Hypers_t & hypers) : KernelImplBase{} {
-        this->set_hyperparmeters(hypers);
+    /**
+     * Dot products between the centers [a_begin, a_end) of features_a and
+     * [b_begin, b_end) of features_b. Only the keys present in both sets
+     * contribute, each with one matrix product between the rows of their
+     * blocks. It is accumulated directly in result when these rows belong to
+     * consecutive centers, which is the case when every center has the key,
+     * otherwise it goes through product and is scattered to the centers.
+     *
+     * @param result (a_end - a_begin) x (b_end - b_begin) matrix
+     * @param product buffer, resized when needed
+     */
+    template <class Key, class Precision>
+    void compute_dot_products(
+        const KeyBlockedFeatures<Key, Precision> & features_a, size_t a_begin,
+        size_t a_end, const KeyBlockedFeatures<Key, Precision> & features_b,
+        size_t b_begin, size_t b_end, Eigen::Ref<math::Matrix_t> result,
+        math::Matrix_t & product) {
+      using Features_t = KeyBlockedFeatures<Key, Precision>;
+      result.setZero();
+      auto it_a{features_a.blocks.begin()};
+      auto it_b{features_b.blocks.begin()};
+      while (it_a != features_a.blocks.end() and
+             it_b != features_b.blocks.end()) {
+        if (it_a->first < it_b->first) {
+          ++it_a;
+          continue;
+        } else if (it_b->first < it_a->first) {
+          ++it_b;
+          continue;
+        }
+        auto & block_a{it_a->second};
+        auto & block_b{it_b->second};
+        ++it_a;
+        ++it_b;
+        auto row_a{Features_t::get_row(block_a, a_begin)};
+        auto n_rows_a{Features_t::get_row(block_a, a_end) - row_a};
+        auto row_b{Features_t::get_row(block_b, b_begin)};
+        auto n_rows_b{Features_t::get_row(block_b, b_end) - row_b};
+        if (n_rows_a == 0 or n_rows_b == 0) {
+          continue;
+        }
+        if (block_a.values.cols() != block_b.values.cols()) {
+          throw std::runtime_error(
+              "The features of the two sets have different sizes.");
+        }
+        auto && values_a{block_a.values.middleRows(row_a, n_rows_a)};
+        auto && values_b{block_b.values.middleRows(row_b, n_rows_b)};
+        size_t center_a{block_a.centers[row_a]};
+        size_t center_b{block_b.centers[row_b]};
+        bool contiguous_a{block_a.centers[row_a + n_rows_a - 1] - center_a ==
+                          static_cast<size_t>(n_rows_a - 1)};
+        bool contiguous_b{block_b.centers[row_b + n_rows_b - 1] - center_b ==
+                          static_cast<size_t>(n_rows_b - 1)};
+        if (contiguous_a and contiguous_b) {
+          add_block_product(result.block(center_a - a_begin,
+                                         center_b - b_begin, n_rows_a,
+                                         n_rows_b),
+                            values_a, values_b);
+        } else {
+          if (product.rows() < n_rows_a or product.cols() < n_rows_b) {
+            product.resize(std::max(product.rows(), n_rows_a),
+                           std::max(product.cols(), n_rows_b));
+          }
+          auto && block_product{product.topLeftCorner(n_rows_a, n_rows_b)};
+          block_product.setZero();
+          add_block_product(block_product, values_a, values_b);
+          for (Eigen::Index i_row{0}; i_row < n_rows_a; ++i_row) {
+            auto i_center{block_a.centers[row_a + i_row] - a_begin};
+            for (Eigen::Index i_col{0}; i_col < n_rows_b; ++i_col) {
+              result(i_center, block_b.centers[row_b + i_col] - b_begin) +=
+                  block_product(i_row, i_col);
+            }
+          }
+        }
       }
+    }
 
-      void set_hyperparmeters(const Hypers_t & hypers) {
-        if (hypers.count("zeta") == 1) {
-          zeta = hypers["zeta"].get<size_t>();
+    /**
+     * Compute a kernel between the targets (structures or centers) of two
+     * sets of features as a stream of tiles of consecutive rows, so that the
+     * whole kernel matrix is never held in memory.
+     *
+     * The rows of a tile are the targets of A with at most tile_rows centers
+     * (at least one target), and the dot products with the centers of B are
+     * computed tile_cols centers at a time to bound the size of the
+     * intermediate matrices. Each block of dot products is turned into a
+     * block of center kernels in place by
+     * transform(dots, features_a, a_begin, features_b, b_begin),
+     * then reduced over each pair of structures for structure kernels, all
+     * while the block is in cache. The self kernels of the structures needed
+     * for the normalized reduction are computed beforehand. The tiles of
+     * columns of each tile of rows, and the structures for the self kernels,
+     * are distributed over n_threads threads, so transform has to be safe to
+     * call concurrently.
+     *
+     * @param callback called as callback(first_row, tile) with each tile of
+     *                 rows of the kernel, in order; the tile is only valid
+     *                 during the call
+     */
+    template <class Key, class Precision, class Transform, class Callback>
+    void compute_kernel_tiles(
+        TargetType target_type, StructureReduction reduction,
+        const KeyBlockedFeatures<Key, Precision> & features_a,
+        const KeyBlockedFeatures<Key, Precision> & features_b,
+        size_t tile_rows, size_t tile_cols, size_t n_threads,
+        Transform && transform, Callback && callback) {
+      auto offsets_a{features_a.get_target_offsets(target_type)};
+      auto offsets_b{features_b.get_target_offsets(target_type)};
+      bool normalize{target_type == TargetType::Structure and
+                     reduction == StructureReduction::NormalizedAverage};
+      auto tiles_a{get_tiles(offsets_a, tile_rows)};
+      auto tiles_b{get_tiles(offsets_b, tile_cols)};
+      size_t n_tiles_b{tiles_b.size() - 1};
+      size_t n_targets_b{offsets_b.size() - 1};
+
+      n_threads = utils::resolve_n_threads(n_threads, n_tiles_b);
+      // scratch of each thread
+      struct Buffers {
+        math::Matrix_t center_kernel{}, product{};
+      };
+      std::vector<Buffers> buffers(n_threads);
+
+      // inverse square root of the self kernel of each structure
+      Eigen::VectorXd scale_a{}, scale_b{};
+      if (normalize) {
+        auto get_scale =
+            [&transform, &buffers, n_threads](
+                const KeyBlockedFeatures<Key, Precision> & features,
+                Eigen::VectorXd & scale) {
+              auto && offsets{features.structure_offsets};
+              scale.resize(features.get_n_structures());
+              auto compute_scale = [&](size_t thread_id, size_t i_structure) {
+                auto & self_kernel{buffers[thread_id].center_kernel};
+                size_t begin{offsets[i_structure]};
+                size_t end{offsets[i_structure + 1]};
+                self_kernel.resize(end - begin, end - begin);
+                compute_dot_products(features, begin, end, features, begin,
+                                     end, self_kernel,
+                                     buffers[thread_id].product);
+                transform(self_kernel, features, begin, features, begin);
+                scale(i_structure) = 1. / std::sqrt(self_kernel.mean());
+              };
+              utils::parallel_for(scale.size(), n_threads, compute_scale);
+            };
+        get_scale(features_a, scale_a);
+        if (&features_a == &features_b) {
+          scale_b = scale_a;
         } else {
+          get_scale(features_b, scale_b);
+        }
+      }
+
+      math::Matrix_t tile{};
+      for (size_t i_tile_a{0}; i_tile_a + 1 < tiles_a.size(); ++i_tile_a) {
+        size_t first_a{tiles_a[i_tile_a]};
+        size_t a_begin{offsets_a[first_a]};
+        size_t a_end{offsets_a[tiles_a[i_tile_a + 1]]};
+        tile.resize(tiles_a[i_tile_a + 1] - first_a, n_targets_b);
+        // the tiles of columns fill disjoint columns of the tile
+        auto compute_columns = [&](size_t thread_id, size_t i_tile_b) {
+          auto & center_kernel{buffers[thread_id].center_kernel};
+          auto & product{buffers[thread_id].product};
+          size_t first_b{tiles_b[i_tile_b]};
+          size_t b_begin{offsets_b[first_b]};
+          size_t b_end{offsets_b[tiles_b[i_tile_b + 1]]};
+          if (target_type == TargetType::Atom) {
+            auto && dots{tile.middleCols(b_begin, b_end - b_begin)};
+            compute_dot_products(features_a, a_begin, a_end, features_b,
+                                 b_begin, b_end, dots, product);
+            transform(dots, features_a, a_begin, features_b, b_begin);
+            return;
+          }
+          center_kernel.resize(a_end - a_begin, b_end - b_begin);
+          compute_dot_products(features_a, a_begin, a_end, features_b,
+                               b_begin, b_end, center_kernel, product);
+          transform(center_kernel, features_a, a_begin, features_b,
+                    b_begin);
+          for (size_t i_a{first_a}; i_a < tiles_a[i_tile_a + 1]; ++i_a) {
+            for (size_t i_b{first_b}; i_b < tiles_b[i_tile_b + 1]; ++i_b) {
+              auto && pair_kernels{
+                  center_kernel.block(offsets_a[i_a] - a_begin,
+                                      offsets_b[i_b] - b_begin,
+                                      offsets_a[i_a + 1] - offsets_a[i_a],
+                                      offsets_b[i_b + 1] - offsets_b[i_b])};
+              tile(i_a - first_a, i_b) =
+                  (reduction == StructureReduction::Sum) ? pair_kernels.sum()
+                                                         : pair_kernels.mean();
+            }
+          }
+        };
+        utils::parallel_for(n_tiles_b, n_threads, compute_columns);
+        if (normalize) {
+          tile.array().colwise() *=
+              scale_a.segment(first_a, tile.rows()).array();
+          tile.array().rowwise() *= scale_b.transpose().array();
+        }
+        callback(first_a, static_cast<const math::Matrix_t &>(tile));
+      }
+    }
+
+    //! number of structures or centers in managers
+    template <class StructureManagers>
+    size_t count_targets(TargetType target_type,
+                         const StructureManagers & managers) {
+      size_t n_targets{0};
+      for (auto & manager : managers) {
+        n_targets += (target_type == TargetType::Structure) ? 1
+                                                            : manager->size();
+      }
+      return n_targets;
+    }
+
+    /**
+     * Number of rows of the derivative of a kernel with respect to the
+     * positions of the atoms of features (3 per atom) and to the strain of
+     * each structure (6 per structure in Voigt order xx, yy, zz, yz, xz, xy)
+     */
+    template <class Key, class Precision>
+    size_t
+    get_derivative_rows(const KeyBlockedFeatures<Key, Precision> & features,
+                        bool compute_stress) {
+      return 3 * features.get_n_centers() +
+             (compute_stress ? 6 * features.get_n_structures() : 0);
+    }
+
+    /**
+     * Derivatives of the structure kernels between the structures in
+     * managers and the centers of features_b (the sparse points) with respect
+     * to the positions of the atoms, and optionally to the strain, of the
+     * structures.
+     *
+     * The gradient of the kernel between a center and a sparse point with
+     * respect to the features of the center is alpha * s + beta * x, where
+     * derivative(dots, beta, features_a, a_begin, features_b, b_begin)
+     * replaces the dot products by alpha in place and sets beta (empty when
+     * it is zero). The chain rule with the gradients of the features of the
+     * centers with respect to the position of each of their neighbours
+     * (gradient_name, stored per pair and key as 3 rows of the size of the
+     * features) is a matrix product per pair and key with the features of the
+     * sparse points that share the key, so the gradients of all the features
+     * with respect to all the atoms are never held at once.
+     *
+     * The structures and the tiles of tile_cols sparse points are
+     * distributed over n_threads threads, each of them filling its own
+     * block of result.
+     *
+     * @param result (get_derivative_rows(features_a), n sparse points)
+     *               matrix, with the 3 rows of each atom of the structures
+     *               one after the other and the strain rows at the back
+     */
+    template <class PropertyGradient_t, class StructureManagers, class Key,
+              class Precision, class Derivative>
+    void compute_kernel_derivative(
+        StructureReduction reduction, const StructureManagers & managers,
+        const KeyBlockedFeatures<Key, Precision> & features_a,
+        const KeyBlockedFeatures<Key, Precision> & features_b,
+        const std::string & gradient_name, size_t tile_cols, size_t n_threads,
+        Derivative && derivative, Eigen::Ref<math::Matrix_t> result,
+        bool compute_stress) {
+      using Features_t = KeyBlockedFeatures<Key, Precision>;
+      using GradientMap_t = Eigen::Map<
+          const Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>>;
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      if (reduction == StructureReduction::NormalizedAverage) {
+        throw std::logic_error("The derivative of the normalized structure "
+                               "kernels is not implemented.");
+      }
+      std::vector<ManagerPtr_t> manager_list{managers.begin(),
+                                             managers.end()};
+      auto && offsets_a{features_a.structure_offsets};
+      auto tiles_b{get_tiles(features_b.get_target_offsets(TargetType::Atom),
+                             tile_cols)};
+      size_t n_structures{manager_list.size()};
+      size_t n_tiles_b{tiles_b.size() - 1};
+      size_t stress_offset{3 * features_a.get_n_centers()};
+      result.setZero();
+
+      n_threads = utils::resolve_n_threads(n_threads, n_structures * n_tiles_b);
+      // scratch of each thread
+      struct Buffers {
+        math::Matrix_t alpha{}, beta{}, product{}, key_gradient{};
+        Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>
+            pair_gradient{};
+      };
+      std::vector<Buffers> buffers(n_threads);
+
+      auto compute_item = [&](size_t thread_id, size_t item) {
+        auto & buffer{buffers[thread_id]};
+        size_t i_structure{item / n_tiles_b};
+        size_t b_begin{tiles_b[item % n_tiles_b]};
+        size_t n_cols{tiles_b[item % n_tiles_b + 1] - b_begin};
+        size_t a_begin{offsets_a[i_structure]};
+        size_t n_centers{offsets_a[i_structure + 1] - a_begin};
+        auto & manager{manager_list[i_structure]};
+        if (manager->size() != n_centers) {
+          throw std::runtime_error("The features of a structure changed.");
+        }
+        auto && gradients{
+            manager->template get_validated_property_ref<PropertyGradient_t>(
+                gradient_name)};
+        if (n_centers > 0 and gradients.size() == 0) {
           throw std::runtime_error(
-              R"(zeta should be specified for the cosine kernel)");
+              "The gradients of the representation are needed, "
+              "compute_gradients should be set.");
+        }
+        double scale{(reduction == StructureReduction::Average and
+                      n_centers > 0)
+                         ? 1. / n_centers
+                         : 1.};
+
+        auto & alpha{buffer.alpha};
+        auto & beta{buffer.beta};
+        alpha.resize(n_centers, n_cols);
+        compute_dot_products(features_a, a_begin, a_begin + n_centers,
+                             features_b, b_begin, b_begin + n_cols, alpha,
+                             buffer.product);
+        derivative(alpha, beta, features_a, a_begin, features_b, b_begin);
+        bool has_beta{beta.size() > 0};
+
+        // accumulate d k(x_i, s) / d r_j for the pair (i, j), r_ij = r_j - r_i
+        auto add_pair = [&](auto && pair, size_t i_center, size_t center,
+                            const Eigen::Vector3d & r_ij) {
+          auto & pair_gradient{buffer.pair_gradient};
+          pair_gradient.setZero(3, n_cols);
+          Eigen::Vector3d gradient_dot_x{Eigen::Vector3d::Zero()};
+          for (auto element : gradients[pair]) {
+            auto && gradient_values{element.second};
+            GradientMap_t gradient{gradient_values.data(), 3,
+                                   gradient_values.size() / 3};
+            auto it_b{features_b.blocks.find(element.first)};
+            if (it_b != features_b.blocks.end()) {
+              auto & block_b{it_b->second};
+              if (block_b.values.cols() != gradient.cols()) {
+                throw std::runtime_error("The gradients and the features of "
+                                         "the sparse points do not match.");
+              }
+              auto row_b{Features_t::get_row(block_b, b_begin)};
+              auto n_rows_b{Features_t::get_row(block_b, b_begin + n_cols) -
+                            row_b};
+              if (n_rows_b > 0) {
+                // cast to double like the gradients
+                auto && values_b{block_b.values.middleRows(row_b, n_rows_b)};
+                size_t col{block_b.centers[row_b] - b_begin};
+                if (block_b.centers[row_b + n_rows_b - 1] - b_begin - col ==
+                    static_cast<size_t>(n_rows_b - 1)) {
+                  pair_gradient.middleCols(col, n_rows_b).noalias() +=
+                      gradient * values_b.template cast<double>().transpose();
+                } else {
+                  auto & key_gradient{buffer.key_gradient};
+                  key_gradient.noalias() =
+                      gradient * values_b.template cast<double>().transpose();
+                  for (Eigen::Index i_row{0}; i_row < n_rows_b; ++i_row) {
+                    pair_gradient.col(block_b.centers[row_b + i_row] -
+                                      b_begin) += key_gradient.col(i_row);
+                  }
+                }
+              }
+            }
+            if (has_beta) {
+              auto it_a{features_a.blocks.find(element.first)};
+              if (it_a == features_a.blocks.end()) {
+                continue;
+              }
+              auto & block_a{it_a->second};
+              auto row_a{Features_t::get_row(block_a, center)};
+              if (row_a < static_cast<Eigen::Index>(block_a.centers.size()) and
+                  block_a.centers[row_a] == center) {
+                gradient_dot_x.noalias() +=
+                    gradient * block_a.values.row(row_a)
+                                   .template cast<double>()
+                                   .transpose();
+              }
+            }
+          }
+          pair_gradient.array().rowwise() *= alpha.row(i_center).array();
+          if (has_beta) {
+            pair_gradient.noalias() += gradient_dot_x * beta.row(i_center);
+          }
+          pair_gradient *= scale;
+
+          size_t atom_index{manager->get_atom_index(pair.get_atom_tag())};
+          if (atom_index >= n_centers) {
+            throw std::runtime_error(
+                "All the atoms of the structures should be centers.");
+          }
+          result.block(3 * (a_begin + atom_index), b_begin, 3, n_cols) +=
+              pair_gradient;
+          if (compute_stress) {
+            constexpr std::array<std::array<int, 2>, 6> voigt{
+                {{0, 0}, {1, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}}};
+            for (size_t i_voigt{0}; i_voigt < voigt.size(); ++i_voigt) {
+              result.row(stress_offset + 6 * i_structure + i_voigt)
+                  .segment(b_begin, n_cols) +=
+                  r_ij(voigt[i_voigt][1]) *
+                  pair_gradient.row(voigt[i_voigt][0]);
+            }
+          }
+        };
+
+        size_t i_center{0};
+        for (auto center : manager) {
+          auto && position{center.get_position()};
+          add_pair(center.get_atom_ii(), i_center, a_begin + i_center,
+                   Eigen::Vector3d::Zero());
+          for (auto neigh : center) {
+            add_pair(neigh, i_center, a_begin + i_center,
+                     neigh.get_position() - position);
+          }
+          ++i_center;
+        }
+      };
+
+      utils::parallel_for(n_structures * n_tiles_b, n_threads, compute_item);
+    }
+
+    struct KernelImplBase {
+      using Hypers_t = json;
+
+      /**
+       * maximum number of centers of set A in the rows of the tiles of the
+       * kernel (see compute_kernel_tiles)
+       */
+      size_t tile_rows{256};
+
+      /**
+       * maximum number of centers of set B whose dot products with the rows
+       * of a tile are computed at once (see compute_kernel_tiles)
+       */
+      size_t tile_cols{1024};
+
+      //! reduction of the center kernels to the structure kernels
+      StructureReduction reduction{StructureReduction::Average};
+
+      //! number of threads used by the kernels and their derivative, 0 means
+      //! all of them
+      size_t n_threads{1};
+
+      /**
+       * read the optional hypers common to all kernels: `tile_rows`,
+       * `tile_cols`, `structure_reduction` (Average, Sum or
+       * NormalizedAverage) and `n_threads`
+       */
+      void set_common_hyperparameters(const Hypers_t & hypers) {
+        if (hypers.count("n_threads") == 1) {
+          this->n_threads = hypers["n_threads"].get<size_t>();
+        }
+        if (hypers.count("tile_rows") == 1) {
+          this->tile_rows = hypers["tile_rows"].get<size_t>();
+        }
+        if (hypers.count("tile_cols") == 1) {
+          this->tile_cols = hypers["tile_cols"].get<size_t>();
+        }
+        if (hypers.count("structure_reduction") == 1) {
+          auto reduction_str{hypers["structure_reduction"].get<std::string>()};
+          if (reduction_str == "Average") {
+            this->reduction = StructureReduction::Average;
+          } else if (reduction_str == "Sum") {
+            this->reduction = StructureReduction::Sum;
+          } else if (reduction_str == "NormalizedAverage") {
+            this->reduction = StructureReduction::NormalizedAverage;
+          } else {
+            throw std::logic_error(
+                "Requested structure_reduction \'" + reduction_str +
+                "\' is not one of: \'Average\', \'Sum\', "
+                "\'NormalizedAverage\'.");
+          }
         }
       }
+    };
+
+    /**
+     * Computation shared by the kernels between centers that are a function
+     * of the dot product and of the norms of their features. The kernel
+     * implementation only provides the function, as get_center_kernel()
+     * returning the transform of compute_kernel_tiles, so that the dot
+     * products, the function and the reduction to structures are evaluated
+     * one tile at a time.
+     */
+    template <class KernelImplementation>
+    struct KernelImplTiled : KernelImplBase {
+      using Hypers_t = typename KernelImplBase::Hypers_t;
 
       /**
-       * Compute the kernel between 2 set of structure(s)
+       * Compute the kernel between 2 set of structure(s) as a stream of tiles
+       * of rows, see compute_kernel_tiles.
        *
        * @tparam StructureManagers should be an iterable over shared pointer
        *          of structure managers like ManagerCollection
+       * @param callback called as callback(first_row, tile) with each tile of
+       *                 consecutive rows of the kernel
        */
-      template <
-          class Property_t, internal::TargetType Type,
-          std::enable_if_t<Type == internal::TargetType::Structure, int> = 0,
-          class StructureManagers>
-      inline math::Matrix_t compute(StructureManagers & managers_a,
-                                    StructureManagers & managers_b,
-                                    const std::string & representation_name) {
-        math::Matrix_t kernel(managers_a.size(), managers_b.size());
-        auto integer_power{math::MakePositiveIntegerPower<double>(this->zeta)};
-        size_t ii_A{0};
-        for (auto & manager_a : managers_a) {
-          size_t ii_B{0};
-          auto && propA{
-              manager_a->template get_validated_property_ref<Property_t>(
-                  representation_name)};
-          for (auto & manager_b : managers_b) {
-            auto && propB{
-                manager_b->template get_validated_property_ref<Property_t>(
-                    representation_name)};
-
-            kernel(ii_A, ii_B) =
-                propA.dot(propB).unaryExpr(integer_power).mean();
-            ++ii_B;
-          }
-          ++ii_A;
+      template <class Property_t, internal::TargetType Type,
+                class StructureManagers, class Callback>
+      void compute_tiles(const StructureManagers & managers_a,
+                         const StructureManagers & managers_b,
+                         const std::string & representation_name,
+                         Callback && callback) {
+        using Features_t = KeyBlockedFeatures<typename Property_t::Key_t,
+                                              typename Property_t::Scalar_t>;
+        Features_t features_a{}, features_b{};
+        features_a.template fill<Property_t>(managers_a, representation_name);
+        if (&managers_a != &managers_b) {
+          features_b.template fill<Property_t>(managers_b,
+                                               representation_name);
         }
-        return kernel;
+        auto & features_b_ref{&managers_a != &managers_b ? features_b
+                                                         : features_a};
+        this->template compute_tiles<Type>(features_a, features_b_ref,
+                                           std::forward<Callback>(callback));
+      }
+
+      /**
+       * Same as above from features already gathered, e.g. mapped from a
+       * FeatureStore.
+       */
+      template <internal::TargetType Type, class Key, class Precision,
+                class Callback>
+      void compute_tiles(const KeyBlockedFeatures<Key, Precision> & features_a,
+                         const KeyBlockedFeatures<Key, Precision> & features_b,
+                         Callback && callback) {
+        auto & implementation{static_cast<KernelImplementation &>(*this)};
+        compute_kernel_tiles(
+            Type, this->reduction, features_a, features_b, this->tile_rows,
+            this->tile_cols, this->n_threads,
+            implementation.get_center_kernel(),
+            std::forward<Callback>(callback));
       }
 
       /**
@@ -117,39 +801,240 @@ namespace rascal {
        * @return kernel matrix
        */
       template <class Property_t, internal::TargetType Type,
-                std::enable_if_t<Type == internal::TargetType::Atom, int> = 0,
                 class StructureManagers>
       inline math::Matrix_t compute(const StructureManagers & managers_a,
                                     const StructureManagers & managers_b,
                                     const std::string & representation_name) {
-        size_t n_centersA{0};
-        for (const auto & manager_a : managers_a) {
-          n_centersA += manager_a->size();
+        math::Matrix_t kernel(count_targets(Type, managers_a),
+                              count_targets(Type, managers_b));
+        this->template compute_tiles<Property_t, Type>(
+            managers_a, managers_b, representation_name,
+            [&kernel](size_t first_row,
+                      const Eigen::Ref<const math::Matrix_t> & tile) {
+              kernel.middleRows(first_row, tile.rows()) = tile;
+            });
+        return kernel;
+      }
+
+      /**
+       * Compute the derivative of the kernel between the structures of
+       * managers and the centers of sparse_points with respect to the
+       * positions of the atoms of managers (and optionally to their strain),
+       * see compute_kernel_derivative. With atom targets it is the
+       * derivative of the sum of the kernels of the centers of a structure.
+       *
+       * @return (3 n_atoms (+ 6 n_structures), n_sparse_points) matrix
+       */
+      template <class Property_t, class PropertyGradient_t,
+                internal::TargetType Type, class StructureManagers>
+      math::Matrix_t
+      compute_derivative(const StructureManagers & managers,
+                         const StructureManagers & sparse_points,
+                         const std::string & representation_name,
+                         const std::string & gradient_name,
+                         bool compute_stress) {
+        using Features_t = KeyBlockedFeatures<typename Property_t::Key_t,
+                                              typename Property_t::Scalar_t>;
+        Features_t features_a{}, features_b{};
+        features_a.template fill<Property_t>(managers, representation_name);
+        if (&managers != &sparse_points) {
+          features_b.template fill<Property_t>(sparse_points,
+                                               representation_name);
         }
-        size_t n_centersB{0};
-        for (const auto & manager_b : managers_b) {
-          n_centersB += manager_b->size();
+        auto & features_b_ref{&managers != &sparse_points ? features_b
+                                                          : features_a};
+        auto reduction{(Type == TargetType::Atom) ? StructureReduction::Sum
+                                                  : this->reduction};
+        auto & implementation{static_cast<KernelImplementation &>(*this)};
+        math::Matrix_t derivative(
+            get_derivative_rows(features_a, compute_stress),
+            features_b_ref.get_n_centers());
+        compute_kernel_derivative<PropertyGradient_t>(
+            reduction, managers, features_a, features_b_ref, gradient_name,
+            this->tile_cols, this->n_threads,
+            implementation.get_center_kernel_derivative(), derivative,
+            compute_stress);
+        return derivative;
+      }
+    };
+
+    template <internal::KernelType Type>
+    struct KernelImpl {};
+
+    /**
+     * Cosine kernel k(x, y) = (x . y)^zeta, i.e. the dot product between
+     * (normalized) features raised to an integer power.
+     */
+    template <>
+    struct KernelImpl<internal::KernelType::Cosine>
+        : KernelImplTiled<KernelImpl<internal::KernelType::Cosine>> {
+      using Hypers_t = typename KernelImplBase::Hypers_t;
+
+      //! exponent of the cosine kernel
+      size_t zeta{1};
+
+      KernelImpl() = default;
+
+      explicit KernelImpl(const Hypers_t & hypers) {
+        this->set_hyperparmeters(hypers);
+      }
+
+      void set_hyperparmeters(const Hypers_t & hypers) {
+        if (hypers.count("zeta") == 1) {
+          zeta = hypers["zeta"].get<size_t>();
+        } else {
+          throw std::runtime_error(
+              R"(zeta should be specified for the cosine kernel)");
         }
-        math::Matrix_t kernel(n_centersA, n_centersB);
+        this->set_common_hyperparameters(hypers);
+      }
+
+      decltype(auto) get_center_kernel() const {
         auto integer_power{math::MakePositiveIntegerPower<double>(this->zeta)};
-        size_t ii_A{0};
-        for (auto & manager_a : managers_a) {
-          size_t ii_B{0};
-          auto && propA{
-              manager_a->template get_validated_property_ref<Property_t>(
-                  representation_name)};
-          for (auto & manager_b : managers_b) {
-            auto && propB{
-                manager_b->template get_validated_property_ref<Property_t>(
-                    representation_name)};
-
-            kernel.block(ii_A, ii_B, manager_a->size(), manager_b->size()) =
-                propA.dot(propB).unaryExpr(integer_power);
-            ii_B += manager_b->size();
-          }
-          ii_A += manager_a->size();
+        return [integer_power](Eigen::Ref<math::Matrix_t> dots, const auto &,
+                               size_t, const auto &, size_t) {
+          dots = dots.unaryExpr(integer_power);
+        };
+      }
+      decltype(auto) get_center_kernel_derivative() const {
+        // with zeta = 0 the kernel is constant and the factor zeta makes the
+        // derivative vanish, the exponent only has to stay in range
+        size_t exponent{this->zeta > 0 ? this->zeta - 1 : 0};
+        auto integer_power{math::MakePositiveIntegerPower<double>(exponent)};
+        double zeta{static_cast<double>(this->zeta)};
+        return [integer_power, zeta](Eigen::Ref<math::Matrix_t> dots,
+                                     math::Matrix_t & beta, const auto &,
+                                     size_t, const auto &, size_t) {
+          dots = zeta * dots.unaryExpr(integer_power);
+          beta.resize(0, 0);
+        };
+      }
+    };
+
+    /**
+     * Polynomial kernel k(x, y) = (gamma x . y + coef0)^degree
+     */
+    template <>
+    struct KernelImpl<internal::KernelType::Polynomial>
+        : KernelImplTiled<KernelImpl<internal::KernelType::Polynomial>> {
+      using Hypers_t = typename KernelImplBase::Hypers_t;
+
+      //! scaling of the dot product
+      double gamma{1.};
+      //! constant added to the scaled dot product
+      double coef0{1.};
+      //! exponent of the polynomial kernel
+      size_t degree{1};
+
+      KernelImpl() = default;
+
+      explicit KernelImpl(const Hypers_t & hypers) {
+        this->set_hyperparmeters(hypers);
+      }
+
+      void set_hyperparmeters(const Hypers_t & hypers) {
+        if (hypers.count("degree") == 1) {
+          this->degree = hypers["degree"].get<size_t>();
+        } else {
+          throw std::runtime_error(
+              R"(degree should be specified for the polynomial kernel)");
         }
-        return kernel;
+        if (hypers.count("gamma") == 1) {
+          this->gamma = hypers["gamma"].get<double>();
+        }
+        if (hypers.count("coef0") == 1) {
+          this->coef0 = hypers["coef0"].get<double>();
+        }
+        this->set_common_hyperparameters(hypers);
+      }
+
+      decltype(auto) get_center_kernel() const {
+        auto integer_power{
+            math::MakePositiveIntegerPower<double>(this->degree)};
+        double gamma{this->gamma}, coef0{this->coef0};
+        return [integer_power, gamma, coef0](Eigen::Ref<math::Matrix_t> dots,
+                                             const auto &, size_t,
+                                             const auto &, size_t) {
+          dots = (gamma * dots.array() + coef0).matrix().unaryExpr(
+              integer_power);
+        };
+      }
+      decltype(auto) get_center_kernel_derivative() const {
+        // as for the cosine kernel, degree = 0 gives a vanishing factor
+        size_t exponent{this->degree > 0 ? this->degree - 1 : 0};
+        auto integer_power{math::MakePositiveIntegerPower<double>(exponent)};
+        double gamma{this->gamma}, coef0{this->coef0};
+        double factor{static_cast<double>(this->degree) * gamma};
+        return [integer_power, gamma, coef0, factor](
+                   Eigen::Ref<math::Matrix_t> dots, math::Matrix_t & beta,
+                   const auto &, size_t, const auto &, size_t) {
+          dots = factor * (gamma * dots.array() + coef0)
+                              .matrix()
+                              .unaryExpr(integer_power);
+          beta.resize(0, 0);
+        };
+      }
+    };
+
+    /**
+     * Gaussian (RBF) kernel k(x, y) = exp(-gamma |x - y|^2), where the
+     * squared distances are obtained from the dot products and the squared
+     * norms of the features computed once per center.
+     */
+    template <>
+    struct KernelImpl<internal::KernelType::Gaussian>
+        : KernelImplTiled<KernelImpl<internal::KernelType::Gaussian>> {
+      using Hypers_t = typename KernelImplBase::Hypers_t;
+
+      //! inverse of twice the squared width of the gaussian
+      double gamma{1.};
+
+      KernelImpl() = default;
+
+      explicit KernelImpl(const Hypers_t & hypers) {
+        this->set_hyperparmeters(hypers);
+      }
+
+      void set_hyperparmeters(const Hypers_t & hypers) {
+        if (hypers.count("gamma") == 1) {
+          this->gamma = hypers["gamma"].get<double>();
+        } else {
+          throw std::runtime_error(
+              R"(gamma should be specified for the gaussian kernel)");
+        }
+        this->set_common_hyperparameters(hypers);
+      }
+
+      decltype(auto) get_center_kernel() const {
+        double gamma{this->gamma};
+        return [gamma](Eigen::Ref<math::Matrix_t> dots, const auto & features_a,
+                       size_t a_begin, const auto & features_b,
+                       size_t b_begin) {
+          auto && norms_a{features_a.squared_norms};
+          auto && norms_b{features_b.squared_norms};
+          // |x - y|^2 = |x|^2 + |y|^2 - 2 x . y, clipped to positive values
+          // to avoid the round-off errors on identical features
+          dots *= -2.;
+          dots.array().colwise() +=
+              norms_a.segment(a_begin, dots.rows()).array();
+          dots.array().rowwise() +=
+              norms_b.segment(b_begin, dots.cols()).transpose().array();
+          dots = (-gamma * dots.array().max(0.)).exp().matrix();
+        };
+      }
+      decltype(auto) get_center_kernel_derivative() const {
+        double gamma{this->gamma};
+        auto center_kernel{this->get_center_kernel()};
+        // d k / d x = 2 gamma k (s - x)
+        return [gamma, center_kernel](Eigen::Ref<math::Matrix_t> dots,
+                                      math::Matrix_t & beta,
+                                      const auto & features_a, size_t a_begin,
+                                      const auto & features_b,
+                                      size_t b_begin) {
+          center_kernel(dots, features_a, a_begin, features_b, b_begin);
+          dots *= 2. * gamma;
+          beta = -dots;
+        };
       }
     };
   }  // namespace internal
@@ -190,10 +1075,17 @@ namespace rascal {
       if (kernel_type_str.compare("Cosine") == 0) {
         this->kernel_type = KernelType::Cosine;
         this->kernel_impl = make_kernel_impl<KernelType::Cosine>(hypers);
+      } else if (kernel_type_str.compare("Polynomial") == 0) {
+        this->kernel_type = KernelType::Polynomial;
+        this->kernel_impl = make_kernel_impl<KernelType::Polynomial>(hypers);
+      } else if (kernel_type_str.compare("Gaussian") == 0) {
+        this->kernel_type = KernelType::Gaussian;
+        this->kernel_impl = make_kernel_impl<KernelType::Gaussian>(hypers);
       } else {
         throw std::logic_error("Requested Kernel \'" + kernel_type_str +
                                "\' has not been implemented.  Must be one of" +
-                               ": \'Cosine\'.");
+                               ": \'Cosine\', \'Polynomial\', " +
+                               "\'Gaussian\'.");
       }
     }
 
@@ -215,19 +1107,201 @@ namespace rascal {
                            const StructureManagers & managers_b) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
-      using Property_t = typename Calculator::template Property_t<Manager_t>;
-      auto && representation_name{calculator.get_name()};
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [&](auto property_type) {
+            using Property_t = typename decltype(property_type)::type;
+            auto && representation_name{calculator.get_name()};
+            using internal::TargetType;
+
+            switch (this->target_type) {
+            case TargetType::Structure: {
+              return this->compute_helper<Property_t, TargetType::Structure>(
+                  representation_name, managers_a, managers_b);
+              break;
+            }
+            case TargetType::Atom: {
+              return this->compute_helper<Property_t, TargetType::Atom>(
+                  representation_name, managers_a, managers_b);
+              break;
+            }
+            default:
+              throw std::logic_error(
+                  "The combination of parameter is not handdled.");
+              break;
+            }
+          });
+    }
+
+    template <class Property_t, internal::TargetType Type,
+              class StructureManagers>
+    inline math::Matrix_t
+    compute_helper(const std::string & representation_name,
+                   const StructureManagers & managers_a,
+                   const StructureManagers & managers_b) {
+      using internal::KernelType;
+
+      switch (this->kernel_type) {
+      case KernelType::Cosine: {
+        auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
+        return kernel->template compute<Property_t, Type>(
+            managers_a, managers_b, representation_name);
+        break;
+      }
+      case KernelType::Polynomial: {
+        auto kernel = downcast_kernel_impl<KernelType::Polynomial>(kernel_impl);
+        return kernel->template compute<Property_t, Type>(
+            managers_a, managers_b, representation_name);
+        break;
+      }
+      case KernelType::Gaussian: {
+        auto kernel = downcast_kernel_impl<KernelType::Gaussian>(kernel_impl);
+        return kernel->template compute<Property_t, Type>(
+            managers_a, managers_b, representation_name);
+        break;
+      }
+      default:
+        throw std::logic_error("The combination of parameter is not handdled.");
+        break;
+      }
+    }
+
+    /**
+     * Compute the kernel like compute() but as a stream of tiles of rows,
+     * so that the kernel matrix is never held in memory, e.g. to accumulate
+     * K^T K and K^T y while training a (sparse) kernel ridge regression.
+     * The number of rows of the tiles and of columns computed at once are
+     * set by the optional `tile_rows` and `tile_cols` hypers (in numbers of
+     * centers).
+     *
+     * @param callback called as
+     *        callback(size_t first_row,
+     *                 const Eigen::Ref<const math::Matrix_t> & tile)
+     *        with each tile of consecutive rows of the kernel, in order. The
+     *        tile is only valid during the call.
+     */
+    template <class Calculator, class StructureManagers, class Callback>
+    void compute_tiles(const Calculator & calculator,
+                       const StructureManagers & managers_a,
+                       const StructureManagers & managers_b,
+                       Callback && callback) {
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      using Manager_t = typename ManagerPtr_t::element_type;
+      internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [&](auto property_type) {
+            using Property_t = typename decltype(property_type)::type;
+            auto && representation_name{calculator.get_name()};
+            using internal::TargetType;
+
+            switch (this->target_type) {
+            case TargetType::Structure: {
+              this->compute_tiles_helper<Property_t, TargetType::Structure>(
+                  representation_name, managers_a, managers_b,
+                  std::forward<Callback>(callback));
+              break;
+            }
+            case TargetType::Atom: {
+              this->compute_tiles_helper<Property_t, TargetType::Atom>(
+                  representation_name, managers_a, managers_b,
+                  std::forward<Callback>(callback));
+              break;
+            }
+            default:
+              throw std::logic_error(
+                  "The combination of parameter is not handdled.");
+              break;
+            }
+          });
+    }
+
+    template <class Property_t, internal::TargetType Type,
+              class StructureManagers, class Callback>
+    inline void compute_tiles_helper(const std::string & representation_name,
+                                     const StructureManagers & managers_a,
+                                     const StructureManagers & managers_b,
+                                     Callback && callback) {
+      using internal::KernelType;
+
+      switch (this->kernel_type) {
+      case KernelType::Cosine: {
+        auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
+        kernel->template compute_tiles<Property_t, Type>(
+            managers_a, managers_b, representation_name,
+            std::forward<Callback>(callback));
+        break;
+      }
+      case KernelType::Polynomial: {
+        auto kernel = downcast_kernel_impl<KernelType::Polynomial>(kernel_impl);
+        kernel->template compute_tiles<Property_t, Type>(
+            managers_a, managers_b, representation_name,
+            std::forward<Callback>(callback));
+        break;
+      }
+      case KernelType::Gaussian: {
+        auto kernel = downcast_kernel_impl<KernelType::Gaussian>(kernel_impl);
+        kernel->template compute_tiles<Property_t, Type>(
+            managers_a, managers_b, representation_name,
+            std::forward<Callback>(callback));
+        break;
+      }
+      default:
+        throw std::logic_error("The combination of parameter is not handdled.");
+        break;
+      }
+    }
+
+    /**
+     * Compute the kernel between the features saved in two FeatureStore (see
+     * FeatureStore::write), which are read in place from the mapped files
+     * instead of being computed again. The features of both stores should
+     * be the same representation.
+     */
+    math::Matrix_t compute(const FeatureStore & store_a,
+                           const FeatureStore & store_b) {
       using internal::TargetType;
+      auto n_targets = [this](const FeatureStore & store) {
+        return (this->target_type == TargetType::Structure)
+                   ? store.get_n_structures()
+                   : store.get_n_centers();
+      };
+      math::Matrix_t kernel(n_targets(store_a), n_targets(store_b));
+      this->compute_tiles(
+          store_a, store_b,
+          [&kernel](size_t first_row,
+                    const Eigen::Ref<const math::Matrix_t> & tile) {
+            kernel.middleRows(first_row, tile.rows()) = tile;
+          });
+      return kernel;
+    }
+
+    /**
+     * Compute the kernel between the features of two FeatureStore as a
+     * stream of tiles of rows, see compute() and compute_tiles() above.
+     */
+    template <class Callback>
+    void compute_tiles(const FeatureStore & store_a,
+                       const FeatureStore & store_b, Callback && callback) {
+      using Features_t = internal::KeyBlockedFeatures<FeatureStore::Key_t>;
+      using internal::TargetType;
+      if (store_a.get_name() != store_b.get_name()) {
+        throw std::runtime_error(
+            "The feature stores do not hold the same representation.");
+      }
+      Features_t features_a{}, features_b{};
+      features_a.map(store_a);
+      if (&store_a != &store_b) {
+        features_b.map(store_b);
+      }
+      auto & features_b_ref{&store_a != &store_b ? features_b : features_a};
 
       switch (this->target_type) {
       case TargetType::Structure: {
-        return this->compute_helper<Property_t, TargetType::Structure>(
-            representation_name, managers_a, managers_b);
+        this->compute_tiles_helper<TargetType::Structure>(
+            features_a, features_b_ref, std::forward<Callback>(callback));
         break;
       }
       case TargetType::Atom: {
-        return this->compute_helper<Property_t, TargetType::Atom>(
-            representation_name, managers_a, managers_b);
+        this->compute_tiles_helper<TargetType::Atom>(
+            features_a, features_b_ref, std::forward<Callback>(callback));
         break;
       }
       default:
@@ -236,19 +1310,130 @@ namespace rascal {
       }
     }
 
-    template <class Property_t, internal::TargetType Type,
-              class StructureManagers>
+    template <internal::TargetType Type, class Key, class Precision,
+              class Callback>
+    inline void
+    compute_tiles_helper(
+        const internal::KeyBlockedFeatures<Key, Precision> & features_a,
+        const internal::KeyBlockedFeatures<Key, Precision> & features_b,
+        Callback && callback) {
+      using internal::KernelType;
+
+      switch (this->kernel_type) {
+      case KernelType::Cosine: {
+        auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
+        kernel->template compute_tiles<Type>(features_a, features_b,
+                                             std::forward<Callback>(callback));
+        break;
+      }
+      case KernelType::Polynomial: {
+        auto kernel = downcast_kernel_impl<KernelType::Polynomial>(kernel_impl);
+        kernel->template compute_tiles<Type>(features_a, features_b,
+                                             std::forward<Callback>(callback));
+        break;
+      }
+      case KernelType::Gaussian: {
+        auto kernel = downcast_kernel_impl<KernelType::Gaussian>(kernel_impl);
+        kernel->template compute_tiles<Type>(features_a, features_b,
+                                             std::forward<Callback>(callback));
+        break;
+      }
+      default:
+        throw std::logic_error("The combination of parameter is not handdled.");
+        break;
+      }
+    }
+
+    /**
+     * Compute the derivative of the kernel between the structures of managers
+     * and the centers of sparse_points (e.g. environments selected as sparse
+     * points of a sparse kernel model) with respect to the positions of the
+     * atoms of managers, for the prediction of forces. The gradients of the
+     * representation must have been computed (`compute_gradients`) on
+     * managers, whose stacks need the center contribution adaptor.
+     *
+     * The rows are the 3 cartesian components of the gradient for each atom
+     * of each structure, followed when compute_stress is true by 6 rows per
+     * structure with the derivative with respect to the strain, in Voigt
+     * order (xx, yy, zz, yz, xz, xy). With the weights w of the sparse
+     * points, the forces are -derivative * w and the virial stress is the
+     * strain rows times w divided by the volume of the cell.
+     *
+     * The structures and the tiles of `tile_cols` sparse points are split
+     * over the `n_threads` threads given in the hypers.
+     */
+    template <class Calculator, class StructureManagers>
+    math::Matrix_t compute_derivative(const Calculator & calculator,
+                                      const StructureManagers & managers,
+                                      const StructureManagers & sparse_points,
+                                      bool compute_stress = false) {
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      using Manager_t = typename ManagerPtr_t::element_type;
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [&](auto property_type) {
+            using Property_t = typename decltype(property_type)::type;
+            using PropertyGradient_t =
+                typename Calculator::template PropertyGradient_t<Manager_t>;
+            auto && representation_name{calculator.get_name()};
+            auto && gradient_name{calculator.get_gradient_name()};
+            using internal::TargetType;
+
+            switch (this->target_type) {
+            case TargetType::Structure: {
+              return this->compute_derivative_helper<
+                  Property_t, PropertyGradient_t, TargetType::Structure>(
+                  representation_name, gradient_name, managers, sparse_points,
+                  compute_stress);
+              break;
+            }
+            case TargetType::Atom: {
+              return this->compute_derivative_helper<
+                  Property_t, PropertyGradient_t, TargetType::Atom>(
+                  representation_name, gradient_name, managers, sparse_points,
+                  compute_stress);
+              break;
+            }
+            default:
+              throw std::logic_error(
+                  "The combination of parameter is not handdled.");
+              break;
+            }
+          });
+    }
+
+    template <class Property_t, class PropertyGradient_t,
+              internal::TargetType Type, class StructureManagers>
     inline math::Matrix_t
-    compute_helper(const std::string & representation_name,
-                   const StructureManagers & managers_a,
-                   const StructureManagers & managers_b) {
+    compute_derivative_helper(const std::string & representation_name,
+                              const std::string & gradient_name,
+                              const StructureManagers & managers,
+                              const StructureManagers & sparse_points,
+                              bool compute_stress) {
       using internal::KernelType;
 
       switch (this->kernel_type) {
       case KernelType::Cosine: {
         auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
-        return kernel->template compute<Property_t, Type>(
-            managers_a, managers_b, representation_name);
+        return kernel->template compute_derivative<Property_t,
+                                                   PropertyGradient_t, Type>(
+            managers, sparse_points, representation_name, gradient_name,
+            compute_stress);
+        break;
+      }
+      case KernelType::Polynomial: {
+        auto kernel = downcast_kernel_impl<KernelType::Polynomial>(kernel_impl);
+        return kernel->template compute_derivative<Property_t,
+                                                   PropertyGradient_t, Type>(
+            managers, sparse_points, representation_name, gradient_name,
+            compute_stress);
+        break;
+      }
+      case KernelType::Gaussian: {
+        auto kernel = downcast_kernel_impl<KernelType::Gaussian>(kernel_impl);
+        return kernel->template compute_derivative<Property_t,
+                                                   PropertyGradient_t, Type>(
+            managers, sparse_points, representation_name, gradient_name,
+            compute_stress);
         break;
       }
       default:
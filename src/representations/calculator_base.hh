@@ -31,11 +31,18 @@
 #include "structure_managers/structure_manager_base.hh"
 #include "structure_managers/property_block_sparse.hh"
 #include "json_io.hh"
+#include "utils/parallel_for.hh"
+#include "rascal_utility.hh"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 #include <Eigen/Dense>
 
@@ -115,6 +122,23 @@ namespace rascal {
     // template<class StructureManager>
     // virtual void compute(StructureManager& ) = 0;
 
+    /**
+     * Set the number of threads used by compute(). The managers of a
+     * collection are distributed over the threads, or the centers of a
+     * structure when there are fewer managers than threads (see
+     * internal::compute_managers()). Each thread works with its own copy of
+     * the mutable calculator state so the results are identical to the
+     * serial computation.
+     *
+     * @param n_threads number of threads, 0 means all the available hardware
+     * threads and 1 (the default) the serial computation.
+     */
+    inline void set_n_threads(size_t n_threads) {
+      this->n_threads = n_threads;
+    }
+
+    inline size_t get_n_threads() const { return this->n_threads; }
+
     //! returns a string representation of the current options values
     //! in alphabetical order
     std::string get_options_string();
@@ -126,6 +150,8 @@ namespace rascal {
     std::string name{""};
     //! default prefix of the calculator
     std::string default_prefix{""};
+    //! number of threads used by compute(), see set_n_threads()
+    size_t n_threads{1};
 
     //! stores all the hyper parameters of the representation
     Hypers_t hypers{};
@@ -134,6 +160,366 @@ namespace rascal {
     std::map<std::string, std::string> options{};
   };
 
+  namespace internal {
+    /**
+     * Make n_copies independent copies of a calculator, e.g. to give each
+     * thread its own scratch data. The copies are built from the hypers of
+     * the calculator and are registered under the same name so that they
+     * read and write the same properties in the managers.
+     */
+    template <class Calculator>
+    std::vector<std::unique_ptr<Calculator>>
+    make_calculator_copies(const Calculator & calculator, size_t n_copies) {
+      std::vector<std::unique_ptr<Calculator>> copies{};
+      copies.reserve(n_copies);
+      for (size_t i_copy{0}; i_copy < n_copies; ++i_copy) {
+        copies.emplace_back(std::make_unique<Calculator>(calculator.hypers));
+        copies.back()->set_name(calculator.get_name());
+      }
+      return copies;
+    }
+
+    /**
+     * Make sure that copies holds at least n_copies copies of calculator
+     * (see make_calculator_copies()), so that the copies can be kept from
+     * one computation to the next instead of being built again from the
+     * hypers. The copies have to be dropped when the hypers change.
+     */
+    template <class Calculator>
+    void reserve_calculator_copies(
+        const Calculator & calculator,
+        std::vector<std::unique_ptr<Calculator>> & copies, size_t n_copies) {
+      for (auto & copy : copies) {
+        copy->set_name(calculator.get_name());
+      }
+      while (copies.size() < n_copies) {
+        copies.emplace_back(std::make_unique<Calculator>(calculator.hypers));
+        copies.back()->set_name(calculator.get_name());
+      }
+    }
+
+    /**
+     * Apply compute_impl(calculator, manager, i_manager) to every manager of
+     * a collection using calculator.get_n_threads() threads.
+     *
+     * When there are at least as many managers as threads, the managers are
+     * distributed dynamically over the threads and each thread uses its own
+     * single threaded copy of the calculator, so compute_impl only touches
+     * the state of one manager and of one calculator at a time. The copies
+     * are kept in copies by the calculator (see reserve_calculator_copies()).
+     * The managers have to be distinct stacks, which is always the case in a
+     * ManagerCollection.
+     *
+     * Otherwise (e.g. a few large periodic cells) the managers are computed
+     * one after the other by calculator itself and the threads are used to
+     * split the centers of each manager, see for_each_center().
+     */
+    template <class Calculator, class StructureManagers, class ComputeImpl>
+    void compute_managers(Calculator & calculator, StructureManagers & managers,
+                          std::vector<std::unique_ptr<Calculator>> & copies,
+                          ComputeImpl && compute_impl) {
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      std::vector<ManagerPtr_t> manager_list{managers.begin(), managers.end()};
+      size_t n_managers{manager_list.size()};
+      size_t n_threads{utils::resolve_n_threads(
+          calculator.get_n_threads(), std::numeric_limits<size_t>::max())};
+
+      if (n_threads == 1 or n_managers < n_threads) {
+        for (size_t i_manager{0}; i_manager < n_managers; ++i_manager) {
+          compute_impl(calculator, manager_list[i_manager], i_manager);
+        }
+        return;
+      }
+
+      reserve_calculator_copies(calculator, copies, n_threads);
+      utils::parallel_for(
+          n_managers, n_threads, [&](size_t thread_id, size_t i_manager) {
+            compute_impl(*copies[thread_id], manager_list[i_manager],
+                         i_manager);
+          });
+    }
+
+    /**
+     * Call function(thread_id, center) for every center of manager using
+     * n_threads threads (0 means all the available hardware threads).
+     *
+     * The centers are handed out dynamically and thread_id is meant to select
+     * per-thread scratch data (e.g. a copy of the calculator made with
+     * make_calculator_copies()). The properties written by function have to
+     * be sized beforehand (e.g. BlockSparseProperty::resize()) so that the
+     * threads only touch the entries that belong to their own center and
+     * never reallocate a shared container. Entries indexed by the pairs of a
+     * center belong to that center, so pair gradients can be accumulated
+     * without synchronization.
+     */
+    template <class StructureManager, class Function>
+    void for_each_center(std::shared_ptr<StructureManager> & manager,
+                         size_t n_threads, Function && function) {
+      utils::parallel_for(
+          manager->size(), n_threads, [&](size_t thread_id, size_t i_center) {
+            auto center_it{manager->get_iterator_at(i_center)};
+            auto center{*center_it};
+            function(thread_id, center);
+          });
+    }
+
+    /**
+     * Features of a center computed in double precision before being stored
+     * in a BlockSparseProperty of lower precision, e.g. with the "single"
+     * precision of CalculatorSphericalInvariants, so that all the sums are
+     * accumulated in double. get() returns the buffer of the thread, with
+     * the keys and the shape of the entry of the center and set to zero, and
+     * store() converts it into the entry. For properties in double the
+     * features are computed in place and both are no-ops.
+     */
+    template <class Property, bool InPlace = std::is_same<
+                                  typename Property::Scalar_t, double>::value>
+    class DoubleCenterFeatures {
+     public:
+      DoubleCenterFeatures(const Property &, size_t) {}
+
+      template <class CenterFeatures>
+      inline CenterFeatures & get(size_t, CenterFeatures & features) {
+        return features;
+      }
+
+      template <class CenterFeatures>
+      inline void store(size_t, CenterFeatures &) {}
+    };
+
+    template <class Property>
+    class DoubleCenterFeatures<Property, false> {
+     public:
+      using Buffer_t =
+          InternallySortedKeyMap<typename Property::Key_t, math::Matrix_t>;
+
+      //! @param n_threads number of threads that compute the centers
+      DoubleCenterFeatures(const Property & property, size_t n_threads)
+          : n_row{property.get_nb_row()}, n_col{property.get_nb_col()},
+            buffers(n_threads) {}
+
+      template <class CenterFeatures>
+      inline Buffer_t & get(size_t thread_id,
+                            const CenterFeatures & features) {
+        auto & buffer{this->buffers[thread_id]};
+        buffer.clear();
+        buffer.resize(features.get_keys(), this->n_row, this->n_col, 0.);
+        return buffer;
+      }
+
+      template <class CenterFeatures>
+      inline void store(size_t thread_id, CenterFeatures & features) {
+        using Scalar_t = typename Property::Scalar_t;
+        auto & buffer{this->buffers[thread_id]};
+        for (auto element : features) {
+          element.second = buffer[element.first].template cast<Scalar_t>();
+        }
+      }
+
+     protected:
+      int n_row;
+      int n_col;
+      std::vector<Buffer_t> buffers;
+    };
+
+    /**
+     * The calculators whose features can be stored in single precision
+     * provide PropertySingle_t and is_single_precision().
+     */
+    template <class Calculator, class Manager, class = void_t<>>
+    struct HasSinglePrecision : std::false_type {};
+
+    template <class Calculator, class Manager>
+    struct HasSinglePrecision<
+        Calculator, Manager,
+        void_t<typename Calculator::template PropertySingle_t<Manager>>>
+        : std::true_type {};
+
+    //! tag that holds the type of a property
+    template <class Property>
+    struct PropertyType {
+      using type = Property;
+    };
+
+    /**
+     * Call function(PropertyType<Property_t>{}) with the type of the
+     * property in which calculator stored its features in the managers of
+     * type Manager, i.e. Calculator::Property_t or
+     * Calculator::PropertySingle_t when it is set to single precision.
+     */
+    template <class Calculator, class Manager, class Function,
+              std::enable_if_t<HasSinglePrecision<Calculator, Manager>::value,
+                               int> = 0>
+    decltype(auto) visit_feature_property(const Calculator & calculator,
+                                          Function && function) {
+      using Property_t = typename Calculator::template Property_t<Manager>;
+      using PropertySingle_t =
+          typename Calculator::template PropertySingle_t<Manager>;
+      if (calculator.is_single_precision()) {
+        return function(PropertyType<PropertySingle_t>{});
+      }
+      return function(PropertyType<Property_t>{});
+    }
+
+    template <
+        class Calculator, class Manager, class Function,
+        std::enable_if_t<not HasSinglePrecision<Calculator, Manager>::value,
+                         int> = 0>
+    decltype(auto) visit_feature_property(const Calculator &,
+                                          Function && function) {
+      using Property_t = typename Calculator::template Property_t<Manager>;
+      return function(PropertyType<Property_t>{});
+    }
+
+    /**
+     * Associate every ij-pair of a full neighbour list with its ji-pair,
+     * i.e. the pair of the center of atom j whose neighbour is atom i and
+     * whose distance vector is r_i - r_j. With periodic boundary conditions
+     * both atoms can be ghosts so the reverse of (i, j + T) is (j, i - T).
+     *
+     * The pairs are numbered in the order of the iteration over the centers
+     * and their neighbours (the self pair excluded). Of every pair that has
+     * a reverse, only the one with the lower number is "evaluated", so that
+     * quantities which are symmetric (or antisymmetric) under the exchange
+     * of i and j can be computed once per pair of atoms.
+     */
+    class ReversePairs {
+     public:
+      //! value of get_reverse() for pairs whose center of atom j is not
+      //! part of the manager (e.g. masked centers)
+      constexpr static int NoReverse{-1};
+
+      template <class StructureManager>
+      void update(StructureManager & manager) {
+        constexpr static int Dim{StructureManager::dim()};
+        using Vector_t = Eigen::Matrix<double, Dim, 1, Eigen::DontAlign>;
+        // images of an atom differ by a lattice vector so a loose tolerance
+        // only has to absorb the rounding of the positions
+        constexpr double tolerance{1e-8};
+
+        std::vector<int> center_of_atom(manager.size_with_ghosts(),
+                                        int{NoReverse});
+        std::vector<size_t> center_atoms{};
+        std::vector<size_t> neighbour_atoms{};
+        std::vector<Vector_t> pair_vectors{};
+        this->offsets.assign(1, 0);
+        this->cluster_indices.clear();
+        for (auto center : manager) {
+          auto atom_i{manager.get_atom_index(center.get_atom_tag())};
+          center_of_atom[atom_i] = center_atoms.size();
+          center_atoms.push_back(atom_i);
+          Vector_t position_i{center.get_position()};
+          for (auto neigh : center) {
+            this->cluster_indices.push_back(
+                neigh.get_cluster_index(neigh.cluster_layer()));
+            neighbour_atoms.push_back(
+                manager.get_atom_index(neigh.get_atom_tag()));
+            pair_vectors.push_back(neigh.get_position() - position_i);
+          }
+          this->offsets.push_back(this->cluster_indices.size());
+        }
+
+        // sort the pairs of each center by the atom index of the neighbour
+        size_t n_pairs{this->cluster_indices.size()};
+        std::vector<size_t> sorted_pairs(n_pairs);
+        std::iota(sorted_pairs.begin(), sorted_pairs.end(), 0);
+        auto by_neighbour = [&neighbour_atoms](size_t pair, size_t atom) {
+          return neighbour_atoms[pair] < atom;
+        };
+        for (size_t i_center{0}; i_center < center_atoms.size(); ++i_center) {
+          std::sort(sorted_pairs.begin() + this->offsets[i_center],
+                    sorted_pairs.begin() + this->offsets[i_center + 1],
+                    [&neighbour_atoms](size_t a, size_t b) {
+                      return neighbour_atoms[a] < neighbour_atoms[b];
+                    });
+        }
+
+        this->reverse.assign(n_pairs, int{NoReverse});
+        for (size_t i_center{0}; i_center < center_atoms.size(); ++i_center) {
+          for (size_t i_pair{this->offsets[i_center]};
+               i_pair < this->offsets[i_center + 1]; ++i_pair) {
+            int j_center{center_of_atom[neighbour_atoms[i_pair]]};
+            if (j_center == NoReverse) {
+              continue;
+            }
+            auto last{sorted_pairs.begin() + this->offsets[j_center + 1]};
+            auto candidate{std::lower_bound(
+                sorted_pairs.begin() + this->offsets[j_center], last,
+                center_atoms[i_center], by_neighbour)};
+            for (; candidate != last and
+                   neighbour_atoms[*candidate] == center_atoms[i_center];
+                 ++candidate) {
+              if ((pair_vectors[*candidate] + pair_vectors[i_pair]).norm() <
+                  tolerance) {
+                this->reverse[i_pair] = static_cast<int>(*candidate);
+                break;
+              }
+            }
+          }
+        }
+
+        // number the evaluated pairs that have a reverse, both pairs sharing
+        // the number of the evaluated one
+        this->shared_indices.assign(n_pairs, int{NoReverse});
+        this->n_shared_pairs = 0;
+        for (size_t i_pair{0}; i_pair < n_pairs; ++i_pair) {
+          int reverse_pair{this->reverse[i_pair]};
+          if (reverse_pair != NoReverse and
+              i_pair < static_cast<size_t>(reverse_pair)) {
+            int shared_index{static_cast<int>(this->n_shared_pairs++)};
+            this->shared_indices[i_pair] = shared_index;
+            this->shared_indices[reverse_pair] = shared_index;
+          }
+        }
+      }
+
+      //! number of the first pair of the i_center-th center
+      inline size_t get_offset(size_t i_center) const {
+        return this->offsets[i_center];
+      }
+
+      inline size_t get_nb_pairs() const { return this->reverse.size(); }
+
+      //! number of the ji-pair of the i_pair-th pair or NoReverse
+      inline int get_reverse(size_t i_pair) const {
+        return this->reverse[i_pair];
+      }
+
+      //! whether the i_pair-th pair has to be evaluated explicitly
+      inline bool is_evaluated(size_t i_pair) const {
+        int reverse_pair{this->reverse[i_pair]};
+        return reverse_pair == NoReverse or
+               i_pair < static_cast<size_t>(reverse_pair);
+      }
+
+      //! number of evaluated pairs that have a reverse
+      inline size_t get_nb_shared_pairs() const {
+        return this->n_shared_pairs;
+      }
+
+      /**
+       * index in [0, get_nb_shared_pairs()) shared by the i_pair-th pair and
+       * its reverse, e.g. to store the contribution of the evaluated one,
+       * or NoReverse
+       */
+      inline int get_shared_index(size_t i_pair) const {
+        return this->shared_indices[i_pair];
+      }
+
+      //! index of the i_pair-th pair in the properties of the manager
+      inline size_t get_cluster_index(size_t i_pair) const {
+        return this->cluster_indices[i_pair];
+      }
+
+     protected:
+      std::vector<size_t> offsets{};
+      std::vector<int> reverse{};
+      std::vector<size_t> cluster_indices{};
+      std::vector<int> shared_indices{};
+      size_t n_shared_pairs{0};
+    };
+  }  // namespace internal
+
 }  // namespace rascal
 
 #endif  // SRC_REPRESENTATIONS_CALCULATOR_BASE_HH_
@@ -243,15 +243,46 @@ namespace rascal {
 
     /* -------------------- compute-loop-begin -------------------- */
     //! loop over a collection of manangers (note that maps would raise a
-    //! compilation error)
+    //! compilation error). The managers are distributed over
+    //! get_n_threads() threads.
     template <
         internal::CMSortAlgorithm AlgorithmType, class StructureManager,
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     inline void compute_loop(StructureManager & managers) {
+      // the feature size and the decays/cutoffs stored in the hypers depend
+      // on the managers computed before so replay the serial loop to record
+      // the state each manager would see
+      using Prop_t =
+          Property_t<typename StructureManager::value_type::element_type>;
+      std::vector<size_t> sizes{};
+      std::vector<Hypers_t> hypers_list{};
       for (auto & manager : managers) {
-        this->compute_impl<AlgorithmType>(manager);
+        sizes.push_back(this->size);
+        hypers_list.push_back(this->hypers);
+        this->update_central_cutoff(manager->get_cutoff());
+        auto && coulomb_matrices{
+            manager->template get_property_ref<Prop_t>(this->get_name())};
+        if (not coulomb_matrices.is_updated()) {
+          this->check_size_compatibility(manager);
+        }
       }
+      size_t final_size{this->size};
+      Hypers_t final_hypers = this->hypers;
+      double final_central_cutoff{this->central_cutoff};
+
+      internal::compute_managers(
+          *this, managers, this->calculator_copies,
+          [&sizes, &hypers_list](CalculatorSortedCoulomb & calculator,
+                                 auto & manager, size_t i_manager) {
+            calculator.size = sizes[i_manager];
+            calculator.hypers = hypers_list[i_manager];
+            calculator.template compute_impl<AlgorithmType>(manager);
+          });
+      // leave the calculator in the same state as after the serial loop
+      this->size = final_size;
+      this->hypers = final_hypers;
+      this->update_central_cutoff(final_central_cutoff);
     }
     //! if it is not a list of managers
     template <internal::CMSortAlgorithm AlgorithmType, class StructureManager,
@@ -330,6 +361,10 @@ namespace rascal {
     // at least equal to the largest number of neighours
     size_t size{};
 
+    //! copies used by the threads of compute_loop(), kept from one call to
+    //! the next (see internal::compute_managers())
+    std::vector<std::unique_ptr<CalculatorSortedCoulomb>> calculator_copies{};
+
     //! reference the requiered hypers
     ReferenceHypers_t reference_hypers{
         {"central_cutoff", {}},
@@ -346,6 +381,7 @@ namespace rascal {
   inline void CalculatorSortedCoulomb::set_hyperparameters(
       const CalculatorSortedCoulomb::Hypers_t & hyper) {
     this->hypers = hyper;
+    this->calculator_copies.clear();
     // TODO(felix) potential problem here in the tests and bindings
     this->update_central_cutoff(this->hypers["central_cutoff"]);
 
@@ -443,12 +479,15 @@ namespace rascal {
     coulomb_matrices.resize();
     // coulomb_matrices.set_shape(this->get_n_feature(), 1);
 
-    // initialize the sorted linear coulomb matrix
-    Eigen::MatrixXd lin_sorted_coulomb_mat(this->size * (this->size + 1) / 2,
-                                           1);
+    // initialize the sorted linear coulomb matrix of each thread
+    size_t n_threads{
+        utils::resolve_n_threads(this->n_threads, manager->size())};
+    std::vector<Eigen::MatrixXd> lin_sorted_coulomb_mats(
+        n_threads, Eigen::MatrixXd(this->size * (this->size + 1) / 2, 1));
 
-    // loop over the centers
-    for (auto center : manager) {
+    // loop over the centers (split over the threads)
+    auto compute_center = [&](size_t thread_id, auto & center) {
+      auto & lin_sorted_coulomb_mat{lin_sorted_coulomb_mats[thread_id]};
       // re-use the temporary coulomb mat in linear storage
       // need to be zeroed because old data might not be overwritten
       lin_sorted_coulomb_mat =
@@ -481,7 +520,9 @@ namespace rascal {
           coulomb_mat, lin_sorted_coulomb_mat, sort_order);
 
       coulomb_matrices[center] = lin_sorted_coulomb_mat;
-    }
+    };
+
+    internal::for_each_center(manager, n_threads, compute_center);
   }
   /* -------------------- rep-options-compute-impl-end -------------------- */
 
@@ -231,6 +231,8 @@ namespace rascal {
 
     void set_hyperparameters(const Hypers_t & hypers) {
       using internal::SphericalCovariantsType;
+      this->hypers = hypers;
+      this->calculator_copies.clear();
       this->max_radial = hypers.at("max_radial").get<size_t>();
       this->max_angular = hypers.at("max_angular").get<size_t>();
       this->spherical_covariants_type_str =
@@ -272,15 +274,21 @@ namespace rascal {
     /**
      * loop over a collection of manangers if it is an iterator.
      * Or just call compute_impl
+     *
+     * The managers of a collection are distributed over get_n_threads()
+     * threads, each with its own copy of the spherical expansion calculator.
      */
     template <
         internal::SphericalCovariantsType Type, class StructureManager,
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
-      for (auto & manager : managers) {
-        this->compute_impl<Type>(manager);
-      }
+      internal::compute_managers(
+          *this, managers, this->calculator_copies,
+          [](CalculatorSphericalCovariants & calculator, auto & manager,
+             size_t /*i_manager*/) {
+            calculator.template compute_impl<Type>(manager);
+          });
     }
 
     //! single manager case
@@ -319,6 +327,11 @@ namespace rascal {
     bool inversion_symmetry{false};
     size_t lambda{0};
     bool normalize{true};
+
+    //! copies used by the threads of compute_loop(), kept from one call to
+    //! the next (see internal::compute_managers())
+    std::vector<std::unique_ptr<CalculatorSphericalCovariants>>
+        calculator_copies{};
   };
 
   template <class StructureManager>
@@ -423,6 +436,7 @@ namespace rascal {
     auto & wigner_3js{precomputation->wigner_3js};
 
     // Compute the spherical expansions of the current structure
+    rep_expansion.set_n_threads(this->n_threads);
     rep_expansion.compute(manager);
     auto && expansions_coefficients{
         manager->template get_property_ref<PropExp_t>(
@@ -440,10 +454,11 @@ namespace rascal {
     this->initialize_per_center_lambda_soap_vectors(
         soap_vectors, expansions_coefficients, manager);
 
-    Key_t p_type{0, 0};
-    internal::SortedKey<Key_t> pair_type{p_type};
+    // the centers are independent so they can be split over the threads
+    auto compute_center = [&](size_t /*thread_id*/, auto & center) {
+      Key_t p_type{0, 0};
+      internal::SortedKey<Key_t> pair_type{p_type};
 
-    for (auto center : manager) {
       auto & coefficients{expansions_coefficients[center]};
       auto & soap_vector{soap_vectors[center]};
 
@@ -559,8 +574,10 @@ namespace rascal {
       if (this->normalize) {
         soap_vector.normalize();
       }
-    }  // center
-  }    // compute_lambdaspectrum
+    };  // compute_center
+
+    internal::for_each_center(manager, this->n_threads, compute_center);
+  }  // compute_lambdaspectrum
 
 }  // namespace rascal
 
@@ -39,12 +39,15 @@
 #include "math/hyp1f1.hh"
 #include "math/bessel.hh"
 #include "math/gauss_legendre.hh"
+#include "math/interpolator.hh"
 #include "structure_managers/property_block_sparse.hh"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <exception>
 #include <sstream>
 #include <vector>
@@ -60,7 +63,7 @@ namespace rascal {
      * List of possible Radial basis that can be used by the spherical
      * expansion.
      */
-    enum class RadialBasisType { GTO, DVR, End_ };
+    enum class RadialBasisType { GTO, DVR, Spline, End_ };
 
     /**
      * List of possible atomic smearing for the definition of the atomic
@@ -377,18 +380,7 @@ namespace rascal {
               this->distance_fac_a_l(angular_l - 1) * distance_fac_a;
         }
 
-        // computes (a+b_n)^{-0.5*(3+l+n)}
-        Eigen::ArrayXd a_b_l{Eigen::rsqrt(fac_a + this->fac_b.array())};
-        for (size_t radial_n{0}; radial_n < this->max_radial; radial_n++) {
-          this->a_b_l_n(radial_n, 0) = pow(a_b_l(radial_n), 3 + radial_n);
-        }
-        // seems like vetorization does not improve things here because it is
-        // memory is not contiguous ?
-        for (size_t angular_l{1}; angular_l < this->max_angular + 1;
-             ++angular_l) {
-          this->a_b_l_n.col(angular_l) =
-              (this->a_b_l_n.col(angular_l - 1).array() * a_b_l).matrix();
-        }
+        this->update_a_b_l_n(fac_a);
 
         this->hyp1f1_calculator.calc(distance, fac_a, this->fac_b,
                                      this->compute_gradients);
@@ -457,6 +449,115 @@ namespace rascal {
         return Matrix_Ref(this->radial_neighbour_derivative);
       }
 
+      /**
+       * Compute the contributions (and their radial derivatives when
+       * computing gradients) of all the neighbours of a center at once.
+       *
+       * Same as compute_neighbour_contribution() and
+       * compute_neighbour_derivative() but the (a+b_n) factors are computed
+       * once per center and the hypergeometric functions and all the
+       * products are evaluated in a structure of arrays layout, i.e.
+       * vectorized over the neighbours. The smearing is taken from the
+       * center so it must not depend on the neighbour.
+       *
+       * @param distances distances of the neighbours in the order in which
+       *                  they are iterated
+       *
+       * The results are accessed with get_neighbour_contribution() and
+       * get_neighbour_derivative().
+       */
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      void compute_neighbour_contributions(
+          const Eigen::Ref<const Eigen::ArrayXd> & distances,
+          ClusterRefKey<Order, Layer> & center) {
+        using math::pow;
+
+        auto smearing{downcast_atomic_smearing<AST>(this->atomic_smearing)};
+        // a = 1 / (2*\sigma^2)
+        double fac_a{0.5 * pow(smearing->get_gaussian_sigma(center), -2)};
+        this->compute_neighbour_contributions(distances, fac_a);
+      }
+
+      //! same as above for a given a = 1 / (2*\sigma^2)
+      void compute_neighbour_contributions(
+          const Eigen::Ref<const Eigen::ArrayXd> & distances, double fac_a) {
+        auto n_neighbours{distances.size()};
+        size_t n_l{this->max_angular + 1};
+        size_t n_cols{this->max_radial * n_l};
+
+        this->update_a_b_l_n(fac_a);
+
+        // computes (r_{ij}*a)^l incrementally, one column per l
+        this->distance_fac_a_l_batch.resize(n_neighbours, n_l);
+        this->distance_fac_a_l_batch.col(0).setOnes();
+        Eigen::ArrayXd distance_fac_a{distances * fac_a};
+        for (size_t angular_l{1}; angular_l < n_l; angular_l++) {
+          this->distance_fac_a_l_batch.col(angular_l) =
+              this->distance_fac_a_l_batch.col(angular_l - 1) * distance_fac_a;
+        }
+
+        this->hyp1f1_calculator.calc_batch(distances, fac_a, this->fac_b,
+                                           this->compute_gradients);
+        auto && values{this->hyp1f1_calculator.get_values_batch()};
+
+        // column n + max_radial * l holds the (n, l) element of every
+        // neighbour
+        this->radial_integral_batch.resize(n_neighbours, n_cols);
+        for (size_t angular_l{0}; angular_l < n_l; angular_l++) {
+          for (size_t radial_n{0}; radial_n < this->max_radial; radial_n++) {
+            size_t i_col{radial_n + this->max_radial * angular_l};
+            this->radial_integral_batch.col(i_col) =
+                this->a_b_l_n(radial_n, angular_l) * values.col(i_col) *
+                this->distance_fac_a_l_batch.col(angular_l);
+          }
+        }
+        // and transpose to get one (n, l) block per neighbour
+        this->radial_integral_neighbours.resize(this->max_radial,
+                                                n_l * n_neighbours);
+        Eigen::Map<Matrix_t>(this->radial_integral_neighbours.data(), n_cols,
+                             n_neighbours) =
+            this->radial_integral_batch.matrix().transpose();
+
+        if (this->compute_gradients) {
+          auto && derivatives{
+              this->hyp1f1_calculator.get_derivatives_batch()};
+          Eigen::ArrayXd inv_distances{distances.inverse()};
+          this->radial_derivative_batch.resize(n_neighbours, n_cols);
+          for (size_t angular_l{0}; angular_l < n_l; angular_l++) {
+            for (size_t radial_n{0}; radial_n < this->max_radial;
+                 radial_n++) {
+              size_t i_col{radial_n + this->max_radial * angular_l};
+              this->radial_derivative_batch.col(i_col) =
+                  this->a_b_l_n(radial_n, angular_l) * derivatives.col(i_col) *
+                      this->distance_fac_a_l_batch.col(angular_l) +
+                  this->radial_integral_batch.col(i_col) *
+                      (static_cast<double>(angular_l) * inv_distances);
+            }
+          }
+          this->radial_neighbour_derivatives.resize(this->max_radial,
+                                                    n_l * n_neighbours);
+          Eigen::Map<Matrix_t>(this->radial_neighbour_derivatives.data(),
+                               n_cols, n_neighbours) =
+              this->radial_derivative_batch.matrix().transpose();
+        }
+      }
+
+      //! contribution of the i-th neighbour computed by
+      //! compute_neighbour_contributions()
+      inline Matrix_Ref get_neighbour_contribution(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_integral_neighbours.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
+      //! radial derivative of the contribution of the i-th neighbour computed
+      //! by compute_neighbour_contributions()
+      inline Matrix_Ref get_neighbour_derivative(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_neighbour_derivatives.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
       template <typename Coeffs>
       void finalize_coefficients(Coeffs & coefficients) const {
         coefficients.lhs_dot(this->ortho_norm_matrix);
@@ -473,6 +574,29 @@ namespace rascal {
         }  // for (neigh : center)
       }
 
+      /**
+       * Compute the (a+b_n)^{-0.5*(3+l+n)} factors, they only depend on the
+       * smearing so they are kept until fac_a changes.
+       */
+      void update_a_b_l_n(double fac_a) {
+        using math::pow;
+        if (fac_a == this->a_b_l_n_fac_a) {
+          return;
+        }
+        Eigen::ArrayXd a_b_l{Eigen::rsqrt(fac_a + this->fac_b.array())};
+        for (size_t radial_n{0}; radial_n < this->max_radial; radial_n++) {
+          this->a_b_l_n(radial_n, 0) = pow(a_b_l(radial_n), 3 + radial_n);
+        }
+        // seems like vetorization does not improve things here because it is
+        // memory is not contiguous ?
+        for (size_t angular_l{1}; angular_l < this->max_angular + 1;
+             ++angular_l) {
+          this->a_b_l_n.col(angular_l) =
+              (this->a_b_l_n.col(angular_l - 1).array() * a_b_l).matrix();
+        }
+        this->a_b_l_n_fac_a = fac_a;
+      }
+
       /** Compute common prefactors for the radial Gaussian basis functions */
       void precompute_radial_sigmas() {
         using math::pow;
@@ -559,6 +683,15 @@ namespace rascal {
       Matrix_t radial_neighbour_derivative{};
       // and of course, d/dr of the center contribution is zero
 
+      // contributions of all the neighbours of a center, one block per
+      // neighbour (see compute_neighbour_contributions())
+      Matrix_t radial_integral_neighbours{};
+      Matrix_t radial_neighbour_derivatives{};
+      // and the same in the structure of arrays layout
+      Eigen::ArrayXXd radial_integral_batch{};
+      Eigen::ArrayXXd radial_derivative_batch{};
+      Eigen::ArrayXXd distance_fac_a_l_batch{};
+
       Hypers_t hypers{};
       // some usefull parameters
       double interaction_cutoff{};
@@ -572,6 +705,8 @@ namespace rascal {
       // b = 1 / (2*\sigma_n^2)
       Vector_t fac_b{};
       Matrix_t a_b_l_n{};
+      // fac_a used to compute a_b_l_n (a is strictly positive)
+      double a_b_l_n_fac_a{-1.};
       Vector_t distance_fac_a_l{};
       Vector_t radial_norm_factors{};
       Vector_t radial_n_factors{};
@@ -737,6 +872,60 @@ namespace rascal {
         return Matrix_Ref(this->radial_neighbour_derivative);
       }
 
+      /**
+       * Compute the contributions of all the neighbours of a center at once,
+       * see RadialContribution<RadialBasisType::GTO>.
+       *
+       * @todo the derivatives still need to be implemented for the DVR
+       * radial basis
+       */
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      void compute_neighbour_contributions(
+          const Eigen::Ref<const Eigen::ArrayXd> & distances,
+          ClusterRefKey<Order, Layer> & center) {
+        using math::pow;
+
+        auto smearing{downcast_atomic_smearing<AST>(this->atomic_smearing)};
+        // a = 1 / (2*\sigma^2)
+        double fac_a{0.5 * pow(smearing->get_gaussian_sigma(center), -2)};
+        this->compute_neighbour_contributions(distances, fac_a);
+      }
+
+      //! same as above for a given a = 1 / (2*\sigma^2)
+      void compute_neighbour_contributions(
+          const Eigen::Ref<const Eigen::ArrayXd> & distances, double fac_a) {
+        auto n_neighbours{distances.size()};
+        size_t n_l{this->max_angular + 1};
+
+        this->radial_integral_neighbours.resize(this->max_radial,
+                                                n_l * n_neighbours);
+        this->radial_neighbour_derivatives.setZero(this->max_radial,
+                                                   n_l * n_neighbours);
+        for (int i_neighbour{0}; i_neighbour < n_neighbours; ++i_neighbour) {
+          this->bessel.calc(distances(i_neighbour), fac_a);
+          this->radial_integral_neighbours.block(0, i_neighbour * n_l,
+                                                 this->max_radial, n_l) =
+              this->legendre_radial_factor.asDiagonal() *
+              this->bessel.get_values().matrix();
+        }
+      }
+
+      //! contribution of the i-th neighbour computed by
+      //! compute_neighbour_contributions()
+      inline Matrix_Ref get_neighbour_contribution(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_integral_neighbours.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
+      //! radial derivative of the contribution of the i-th neighbour
+      //! (dummy values, see compute_neighbour_derivative())
+      inline Matrix_Ref get_neighbour_derivative(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_neighbour_derivatives.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
       template <typename Coeffs>
       void finalize_coefficients(Coeffs & /*coefficients*/) const {}
 
@@ -753,6 +942,10 @@ namespace rascal {
       Matrix_t radial_integral_neighbour{};
       Matrix_t radial_neighbour_derivative{};
       Vector_t radial_integral_center{};
+      // contributions of all the neighbours of a center, one block per
+      // neighbour (see compute_neighbour_contributions())
+      Matrix_t radial_integral_neighbours{};
+      Matrix_t radial_neighbour_derivatives{};
 
       Hypers_t hypers{};
       // some useful parameters
@@ -767,6 +960,395 @@ namespace rascal {
       Vector_t legendre_points2{};
     };
 
+    /**
+     * Implementation of the radial contribution as a cubic Hermite spline of
+     * the radial integral of another radial basis (GTO by default).
+     *
+     * Since the atomic smearing is constant, the radial integral and its
+     * derivative are functions of the pair distance only. They are tabulated
+     * once on a uniform grid of [0, r_cut] when the hyperparameters are set.
+     * The grid is refined until the interpolation reaches the requested
+     * accuracy (see math::CubicHermiteSpline), which is worth it when
+     * many structures are computed with the same hyperparameters.
+     *
+     * The relevant hyperparameters are taken from "radial_contribution":
+     *   - "basis": radial basis to tabulate, "GTO" (default) or "DVR"
+     *   - "accuracy": target of the interpolation error relative to the
+     *     largest value of the radial integral (default 1e-8)
+     *
+     * The DVR basis does not provide the radial derivative so it is
+     * estimated with central finite differences for the tabulation, which
+     * limits the accuracy to about 1e-10.
+     *
+     * The tables are shared between the radial contributions built with the
+     * same hyperparameters (e.g. the per-thread copies of a calculator) so
+     * the tabulation is done only once.
+     */
+    template <>
+    struct RadialContribution<RadialBasisType::Spline>
+        : RadialContributionBase {
+      //! Constructor
+      explicit RadialContribution(const Hypers_t & hypers) {
+        this->set_hyperparameters(hypers);
+        this->precompute();
+      }
+      //! Destructor
+      virtual ~RadialContribution() = default;
+      //! Copy constructor
+      RadialContribution(const RadialContribution & other) = delete;
+      //! Move constructor
+      RadialContribution(RadialContribution && other) = default;
+      //! Copy assignment operator
+      RadialContribution & operator=(const RadialContribution & other) = delete;
+      //! Move assignment operator
+      RadialContribution & operator=(RadialContribution && other) = default;
+
+      using Parent = RadialContributionBase;
+      using Hypers_t = typename Parent::Hypers_t;
+      using Matrix_t = Eigen::MatrixXd;
+      using Vector_t = typename Parent::Vector_t;
+      using Matrix_Ref = typename Parent::Matrix_Ref;
+      using Vector_Ref = typename Parent::Vector_Ref;
+
+      /**
+       * Set hyperparameters.
+       *
+       * @param hypers is expected to be the same as the the input of
+       *         the spherical expansion
+       */
+      void set_hyperparameters(const Hypers_t & hypers) {
+        this->hypers = hypers;
+
+        this->max_radial = hypers.at("max_radial");
+        this->max_angular = hypers.at("max_angular");
+
+        if (hypers.find("compute_gradients") != hypers.end()) {
+          this->compute_gradients = hypers.at("compute_gradients").get<bool>();
+        } else {  // Default false (don't compute gradients)
+          this->compute_gradients = false;
+        }
+
+        this->radial_integral_neighbour.resize(this->max_radial,
+                                               this->max_angular + 1);
+        this->radial_neighbour_derivative.resize(this->max_radial,
+                                                 this->max_angular + 1);
+
+        auto fc_hypers = hypers.at("cutoff_function").get<json>();
+        this->interaction_cutoff =
+            fc_hypers.at("cutoff").at("value").get<double>();
+
+        auto smearing_hypers = hypers.at("gaussian_density").get<json>();
+        auto smearing_type = smearing_hypers.at("type").get<std::string>();
+        if (smearing_type.compare("Constant") == 0) {
+          this->atomic_smearing_type = AtomicSmearingType::Constant;
+          this->atomic_smearing =
+              make_atomic_smearing<AtomicSmearingType::Constant>(
+                  smearing_hypers);
+          this->smearing =
+              smearing_hypers.at("gaussian_sigma").at("value").get<double>();
+        } else {
+          throw std::logic_error(
+              "Requested Gaussian sigma type \'" + smearing_type +
+              "\' has not been implemented.  Must be one of" +
+              ": \'Constant\'.");
+        }
+
+        auto radial_contribution_hypers =
+            hypers.at("radial_contribution").get<json>();
+        if (radial_contribution_hypers.find("accuracy") !=
+            radial_contribution_hypers.end()) {
+          this->accuracy =
+              radial_contribution_hypers.at("accuracy").get<double>();
+        }
+        std::string basis_type{"GTO"};
+        if (radial_contribution_hypers.find("basis") !=
+            radial_contribution_hypers.end()) {
+          basis_type =
+              radial_contribution_hypers.at("basis").get<std::string>();
+        }
+
+        // the derivatives are always needed to build the spline
+        Hypers_t basis_hypers = hypers;
+        basis_hypers["compute_gradients"] = true;
+        if (basis_type.compare("GTO") == 0) {
+          this->basis_type = RadialBasisType::GTO;
+          this->basis =
+              std::make_shared<RadialContribution<RadialBasisType::GTO>>(
+                  basis_hypers);
+        } else if (basis_type.compare("DVR") == 0) {
+          this->basis_type = RadialBasisType::DVR;
+          this->basis =
+              std::make_shared<RadialContribution<RadialBasisType::DVR>>(
+                  basis_hypers);
+        } else {
+          throw std::logic_error("Requested Radial basis \'" + basis_type +
+                                 "\' can't be splined.  Must be one of" +
+                                 ": \'GTO\' or \'DVR\'. ");
+        }
+      }
+
+      //! tabulate the radial integral of the basis or reuse existing tables
+      void precompute() {
+        // the only hyperparameters the tables depend on
+        json table_hypers{};
+        for (auto && key : {"max_radial", "max_angular", "cutoff_function",
+                            "gaussian_density", "radial_contribution"}) {
+          table_hypers[key] = this->hypers.at(key);
+        }
+        std::string table_key{table_hypers.dump()};
+
+        static std::mutex tables_mutex{};
+        static std::map<std::string,
+                        std::weak_ptr<const math::CubicHermiteSpline>>
+            tables{};
+        std::lock_guard<std::mutex> lock{tables_mutex};
+        for (auto it{tables.begin()}; it != tables.end();) {
+          if (it->second.expired() and it->first != table_key) {
+            it = tables.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        this->spline = tables[table_key].lock();
+        if (not this->spline) {
+          auto spline{std::make_shared<math::CubicHermiteSpline>()};
+          this->tabulate(*spline);
+          this->spline = spline;
+          tables[table_key] = this->spline;
+        }
+      }
+
+      //! tabulate the radial integral of the basis and its derivative
+      void tabulate(math::CubicHermiteSpline & spline) {
+        using math::pow;
+        // a = 1 / (2*\sigma^2)
+        double fac_a{0.5 * pow(this->smearing, -2)};
+        size_t n_l{this->max_angular + 1};
+        size_t n_outputs{this->max_radial * n_l};
+
+        auto tabulate = [this, fac_a, n_l, n_outputs](
+                            const Eigen::ArrayXd & points, Matrix_t & values,
+                            Matrix_t & derivatives) {
+          // the l/r factor of the derivative (and the DVR recursion) is
+          // singular at r = 0 while the radial integral is smooth
+          double r_min{std::numeric_limits<double>::epsilon()};
+          Eigen::ArrayXd distances{points.max(r_min)};
+          switch (this->basis_type) {
+          case RadialBasisType::GTO: {
+            auto gto{std::static_pointer_cast<
+                RadialContribution<RadialBasisType::GTO>>(this->basis)};
+            gto->compute_neighbour_contributions(distances, fac_a);
+            for (int i_point{0}; i_point < distances.size(); ++i_point) {
+              Eigen::Map<Matrix_t>(values.col(i_point).data(),
+                                   this->max_radial, n_l) =
+                  gto->get_neighbour_contribution(i_point);
+              Eigen::Map<Matrix_t>(derivatives.col(i_point).data(),
+                                   this->max_radial, n_l) =
+                  gto->get_neighbour_derivative(i_point);
+            }
+            break;
+          }
+          case RadialBasisType::DVR: {
+            auto dvr{std::static_pointer_cast<
+                RadialContribution<RadialBasisType::DVR>>(this->basis)};
+            double delta{1e-5 * this->interaction_cutoff};
+            Eigen::ArrayXd distances_m{(distances - delta).max(r_min)};
+            Eigen::ArrayXd distances_p{distances + delta};
+            Matrix_t values_m(n_outputs, distances.size());
+            dvr->compute_neighbour_contributions(distances_m, fac_a);
+            for (int i_point{0}; i_point < distances.size(); ++i_point) {
+              Eigen::Map<Matrix_t>(values_m.col(i_point).data(),
+                                   this->max_radial, n_l) =
+                  dvr->get_neighbour_contribution(i_point);
+            }
+            dvr->compute_neighbour_contributions(distances_p, fac_a);
+            for (int i_point{0}; i_point < distances.size(); ++i_point) {
+              Eigen::Map<Matrix_t>(derivatives.col(i_point).data(),
+                                   this->max_radial, n_l) =
+                  dvr->get_neighbour_contribution(i_point);
+            }
+            Eigen::VectorXd inv_steps{
+                (distances_p - distances_m).inverse().matrix()};
+            derivatives = (derivatives - values_m) * inv_steps.asDiagonal();
+            dvr->compute_neighbour_contributions(distances, fac_a);
+            for (int i_point{0}; i_point < distances.size(); ++i_point) {
+              Eigen::Map<Matrix_t>(values.col(i_point).data(),
+                                   this->max_radial, n_l) =
+                  dvr->get_neighbour_contribution(i_point);
+            }
+            break;
+          }
+          default:
+            throw std::logic_error("Invalid radial basis for the spline");
+          }
+        };
+
+        spline.initialize(0., this->interaction_cutoff, n_outputs,
+                          this->accuracy, tabulate);
+      }
+
+      //! define the contribution from the central atom to the expansion
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      Vector_Ref
+      compute_center_contribution(ClusterRefKey<Order, Layer> & center) {
+        switch (this->basis_type) {
+        case RadialBasisType::GTO:
+          return std::static_pointer_cast<
+                     RadialContribution<RadialBasisType::GTO>>(this->basis)
+              ->template compute_center_contribution<AST>(center);
+        case RadialBasisType::DVR:
+          return std::static_pointer_cast<
+                     RadialContribution<RadialBasisType::DVR>>(this->basis)
+              ->template compute_center_contribution<AST>(center);
+        default:
+          throw std::logic_error("Invalid radial basis for the spline");
+        }
+      }
+
+      //! define the contribution from a neighbour atom to the expansion
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      Matrix_Ref
+      compute_neighbour_contribution(double distance,
+                                     ClusterRefKey<Order, Layer> & /*pair*/) {
+        this->spline->interpolate(
+            distance, Eigen::Map<Eigen::VectorXd>(
+                          this->radial_integral_neighbour.data(),
+                          this->radial_integral_neighbour.size()));
+        return Matrix_Ref(this->radial_integral_neighbour);
+      }
+
+      //! Compute the radial derivative of the neighbour contribution
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      Matrix_Ref
+      compute_neighbour_derivative(double distance,
+                                   ClusterRefKey<Order, Layer> & /*pair*/) {
+        this->spline->interpolate_derivative(
+            distance, Eigen::Map<Eigen::VectorXd>(
+                          this->radial_neighbour_derivative.data(),
+                          this->radial_neighbour_derivative.size()));
+        return Matrix_Ref(this->radial_neighbour_derivative);
+      }
+
+      /**
+       * Interpolate the contributions (and their radial derivatives when
+       * computing gradients) of all the neighbours of a center, see
+       * RadialContribution<RadialBasisType::GTO>.
+       */
+      template <AtomicSmearingType AST, size_t Order, size_t Layer>
+      void compute_neighbour_contributions(
+          const Eigen::Ref<const Eigen::ArrayXd> & distances,
+          ClusterRefKey<Order, Layer> & /*center*/) {
+        auto n_neighbours{distances.size()};
+        size_t n_l{this->max_angular + 1};
+        size_t n_outputs{this->max_radial * n_l};
+
+        this->radial_integral_neighbours.resize(this->max_radial,
+                                                n_l * n_neighbours);
+        Eigen::Map<Matrix_t> contributions(
+            this->radial_integral_neighbours.data(), n_outputs, n_neighbours);
+        for (int i_neighbour{0}; i_neighbour < n_neighbours; ++i_neighbour) {
+          this->spline->interpolate(distances(i_neighbour),
+                                   contributions.col(i_neighbour));
+        }
+
+        if (this->compute_gradients) {
+          this->radial_neighbour_derivatives.resize(this->max_radial,
+                                                    n_l * n_neighbours);
+          Eigen::Map<Matrix_t> derivatives(
+              this->radial_neighbour_derivatives.data(), n_outputs,
+              n_neighbours);
+          for (int i_neighbour{0}; i_neighbour < n_neighbours;
+               ++i_neighbour) {
+            this->spline->interpolate_derivative(distances(i_neighbour),
+                                                derivatives.col(i_neighbour));
+          }
+        }
+      }
+
+      //! contribution of the i-th neighbour computed by
+      //! compute_neighbour_contributions()
+      inline Matrix_Ref get_neighbour_contribution(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_integral_neighbours.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
+      //! radial derivative of the contribution of the i-th neighbour computed
+      //! by compute_neighbour_contributions()
+      inline Matrix_Ref get_neighbour_derivative(size_t i_neighbour) const {
+        size_t n_l{this->max_angular + 1};
+        return Matrix_Ref(this->radial_neighbour_derivatives.block(
+            0, i_neighbour * n_l, this->max_radial, n_l));
+      }
+
+      template <typename Coeffs>
+      void finalize_coefficients(Coeffs & coefficients) const {
+        if (this->basis_type == RadialBasisType::GTO) {
+          std::static_pointer_cast<RadialContribution<RadialBasisType::GTO>>(
+              this->basis)
+              ->finalize_coefficients(coefficients);
+        }
+      }
+
+      template <int n_spatial_dimensions, typename Coeffs, typename Center>
+      void finalize_coefficients_der(Coeffs & coefficients_gradient,
+                                     Center & center) const {
+        if (this->basis_type == RadialBasisType::GTO) {
+          std::static_pointer_cast<RadialContribution<RadialBasisType::GTO>>(
+              this->basis)
+              ->template finalize_coefficients_der<n_spatial_dimensions>(
+                  coefficients_gradient, center);
+        }
+      }
+
+      //! number of intervals of the tabulation grid
+      size_t get_n_intervals() const {
+        return this->spline->get_n_intervals();
+      }
+
+      //! tabulated radial basis
+      std::shared_ptr<RadialContributionBase> basis{};
+      RadialBasisType basis_type{};
+
+      std::shared_ptr<const math::CubicHermiteSpline> spline{};
+
+      std::shared_ptr<AtomicSmearingSpecificationBase> atomic_smearing{};
+      AtomicSmearingType atomic_smearing_type{};
+
+      // data member used to store the contributions to the expansion
+      Matrix_t radial_integral_neighbour{};
+      Matrix_t radial_neighbour_derivative{};
+      // contributions of all the neighbours of a center, one block per
+      // neighbour (see compute_neighbour_contributions())
+      Matrix_t radial_integral_neighbours{};
+      Matrix_t radial_neighbour_derivatives{};
+
+      Hypers_t hypers{};
+      // some useful parameters
+      double interaction_cutoff{};
+      double smearing{};
+      double accuracy{1e-8};
+      size_t max_radial{};
+      size_t max_angular{};
+      bool compute_gradients{};
+    };
+
+    /**
+     * The managers that store the distances and direction vectors of all
+     * their pairs contiguously, i.e. AdaptorStrict, provide get_distances()
+     * and get_direction_vectors().
+     */
+    template <class Manager, class = void_t<>>
+    struct HasPairGeometry : std::false_type {};
+
+    template <class Manager>
+    struct HasPairGeometry<
+        Manager,
+        void_t<decltype(std::declval<const Manager &>().get_distances()),
+               decltype(
+                   std::declval<const Manager &>().get_direction_vectors())>>
+        : std::true_type {};
+
   }  // namespace internal
 
   template <internal::RadialBasisType Type, class Hypers>
@@ -792,6 +1374,9 @@ namespace rascal {
    * of spherical harmonics (à la SOAP) and a radial basis of
    * either Gaussians (again, as in SOAP/SphericalInvariants) or one of the more
    * recent bases currently under development.
+   *
+   * The distances and direction vectors of the pairs are read from
+   * AdaptorStrict, which has to be the top adaptor of the managers.
    */
   class CalculatorSphericalExpansion : public CalculatorBase {
    public:
@@ -836,6 +1421,7 @@ namespace rascal {
       using internal::CutoffFunctionType;
       using internal::RadialBasisType;
       this->hypers = hypers;
+      this->calculator_copies.clear();
 
       this->max_radial = hypers.at("max_radial");
       this->max_angular = hypers.at("max_angular");
@@ -851,6 +1437,11 @@ namespace rascal {
       }
       this->spherical_harmonics.precompute(this->max_angular,
                                            this->compute_gradients);
+      if (hypers.find("use_pair_parity") != hypers.end()) {
+        this->use_pair_parity = hypers.at("use_pair_parity").get<bool>();
+      } else {
+        this->use_pair_parity = false;
+      }
 
       auto radial_contribution_hypers =
           hypers.at("radial_contribution").get<json>();
@@ -873,11 +1464,17 @@ namespace rascal {
         this->atomic_smearing_type = rc_shared->atomic_smearing_type;
         this->radial_integral = rc_shared;
         this->radial_integral_type = RadialBasisType::DVR;
+      } else if (radial_contribution_type.compare("Spline") == 0) {
+        auto rc_shared = std::make_shared<
+            internal::RadialContribution<RadialBasisType::Spline>>(hypers);
+        this->atomic_smearing_type = rc_shared->atomic_smearing_type;
+        this->radial_integral = rc_shared;
+        this->radial_integral_type = RadialBasisType::Spline;
       } else {
         throw std::logic_error("Requested Radial contribution type \'" +
                                radial_contribution_type +
                                "\' has not been implemented.  Must be one of" +
-                               ": \'GTO\' or \'DVR\'. ");
+                               ": \'GTO\', \'DVR\' or \'Spline\'. ");
       }
 
       auto fc_hypers = hypers.at("cutoff_function").get<json>();
@@ -956,6 +1553,10 @@ namespace rascal {
     /**
      * loop over a collection of manangers if it is an iterator.
      * Or just call compute_impl() if it's a single manager (see below)
+     *
+     * The managers of a collection are distributed over get_n_threads()
+     * threads, each with its own spherical harmonics and radial integral
+     * scratch data.
      */
     template <
         internal::CutoffFunctionType FcType,
@@ -964,9 +1565,14 @@ namespace rascal {
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     inline void compute_loop(StructureManager & managers) {
-      for (auto & manager : managers) {
-        this->compute_impl<FcType, RadialType, SmearingType>(manager);
-      }
+      internal::compute_managers(
+          *this, managers, this->calculator_copies,
+          [](CalculatorSphericalExpansion & calculator, auto & manager,
+             size_t /*i_manager*/) {
+            calculator
+                .template compute_impl<FcType, RadialType, SmearingType>(
+                    manager);
+          });
     }
 
     //! single manager case
@@ -993,6 +1599,8 @@ namespace rascal {
     size_t max_angular{};
     size_t n_species{};
     bool compute_gradients{};
+    //! evaluate only one of the ij- and ji-pairs, see compute_impl()
+    bool use_pair_parity{};
 
     internal::AtomicSmearingType atomic_smearing_type{};
 
@@ -1002,9 +1610,13 @@ namespace rascal {
     std::shared_ptr<internal::CutoffFunctionBase> cutoff_function{};
     internal::CutoffFunctionType cutoff_function_type{};
 
-    Hypers_t hypers{};
-
     math::SphericalHarmonics spherical_harmonics{};
+
+    //! copies used by the threads of compute_loop() and compute_impl(),
+    //! kept from one call to the next since building them repeats the setup
+    //! of the radial basis
+    std::vector<std::unique_ptr<CalculatorSphericalExpansion>>
+        calculator_copies{};
   };
 
   // compute classes template construction
@@ -1059,6 +1671,12 @@ namespace rascal {
                          AtomicSmearingType::Constant>(managers);
       break;
     }
+    case internal::combineEnums(RadialBasisType::Spline,
+                                AtomicSmearingType::Constant): {
+      this->compute_loop<FcType, RadialBasisType::Spline,
+                         AtomicSmearingType::Constant>(managers);
+      break;
+    }
     default:
       // The control flow really should never reach here.  In this case, any
       // "invalid combination of parameters" should have already been handled at
@@ -1090,6 +1708,10 @@ namespace rascal {
     using Prop_t = Property_t<StructureManager>;
     using PropGrad_t = PropertyGradient_t<StructureManager>;
     constexpr static int n_spatial_dimensions = StructureManager::dim();
+    static_assert(internal::HasPairGeometry<StructureManager>::value,
+                  "The spherical expansion needs AdaptorStrict as the top "
+                  "adaptor of the managers, for get_distances() and "
+                  "get_direction_vectors().");
 
     using math::PI;
     using math::pow;
@@ -1107,11 +1729,9 @@ namespace rascal {
       return;
     }
 
-    // downcast cutoff and radial contributions so they are functional
+    // downcast cutoff function so it is functional
     auto cutoff_function{
         downcast_cutoff_function<FcType>(this->cutoff_function)};
-    auto radial_integral{
-        downcast_radial_integral<RadialType>(this->radial_integral)};
 
     auto n_row{this->max_radial};
     auto n_col{(this->max_angular + 1) * (this->max_angular + 1)};
@@ -1127,10 +1747,44 @@ namespace rascal {
       expansions_coefficients_gradient.resize();
     }
 
-    /* @TODO(felix,max) use the parity of the spherical harmonics to use half
-     * neighbourlist, i.e. C^{ij}_{nlm} = (-1)^l C^{ji}_{nlm}.
+    // the centers are split over the threads and each thread gets its own
+    // spherical harmonics and radial integral scratch data through a copy of
+    // the calculator. The properties have been sized above and every
+    // gradient entry belongs to a pair of the current center, so the threads
+    // never write to the same memory.
+    size_t n_threads{
+        utils::resolve_n_threads(this->n_threads, manager->size())};
+    internal::reserve_calculator_copies(*this, this->calculator_copies,
+                                        n_threads - 1);
+    auto & calculator_copies{this->calculator_copies};
+
+    /*
+     * The contributions of the ij- and ji-pairs only differ by the parity of
+     * the spherical harmonics, i.e. C^{ij}_{nlm} = (-1)^l C^{ji}_{nlm}, since
+     * r_{ji} = -r_{ij} and the radial integral and the cutoff function only
+     * depend on the distance. With use_pair_parity only one pair of each is
+     * evaluated: its contribution is stored in pair_coefficients, which only
+     * holds the evaluated pairs that have a reverse (its gradient is already
+     * stored in the gradient of the pair), and added to the center of the
+     * reverse pair once all the centers are done.
      */
-    for (auto center : manager) {
+    internal::ReversePairs reverse_pairs{};
+    Matrix_t pair_coefficients{};
+    if (this->use_pair_parity) {
+      reverse_pairs.update(*manager);
+      pair_coefficients.resize(n_row,
+                               n_col * reverse_pairs.get_nb_shared_pairs());
+    }
+
+    auto && all_distances{manager->get_distances()};
+    auto && all_directions{manager->get_direction_vectors()};
+
+    auto compute_center = [&](size_t thread_id, auto & center) {
+      auto & calculator{thread_id == 0 ? *this
+                                       : *calculator_copies[thread_id - 1]};
+      auto radial_integral{
+          downcast_radial_integral<RadialType>(calculator.radial_integral)};
+
       auto & coefficients_center = expansions_coefficients[center];
       auto & coefficients_center_gradient =
           expansions_coefficients_gradient[center.get_atom_ii()];
@@ -1156,35 +1810,77 @@ namespace rascal {
               center) /
           sqrt(4.0 * PI);
 
+      size_t pair_offset{
+          this->use_pair_parity ? reverse_pairs.get_offset(center.get_index())
+                                : 0};
+      auto is_evaluated = [&](size_t i_pair) {
+        return not this->use_pair_parity or reverse_pairs.is_evaluated(i_pair);
+      };
+
+      // compute the radial contributions and the spherical harmonics of all
+      // the neighbours at once, the pair distances and directions being read
+      // from the contiguous storage of the manager
+      Eigen::ArrayXd distances(center.size());
+      Eigen::Matrix3Xd directions(3, center.size());
+      int n_neighbours{0};
+      size_t next_pair{pair_offset};
+      for (auto neigh : center) {
+        if (not is_evaluated(next_pair++)) {
+          continue;
+        }
+        size_t pair_index{neigh.get_global_index()};
+        distances(n_neighbours) = all_distances(pair_index);
+        directions.col(n_neighbours) = all_directions.col(pair_index);
+        ++n_neighbours;
+      }
+      radial_integral
+          ->template compute_neighbour_contributions<SmearingType>(
+              distances.head(n_neighbours), center);
+      Eigen::MatrixXd harmonics_neighbours{}, harmonics_gradients_neighbours{};
+      this->spherical_harmonics.calc_batch(
+          directions.leftCols(n_neighbours), harmonics_neighbours,
+          harmonics_gradients_neighbours, this->compute_gradients);
+
+      size_t i_neighbour{0};
+      next_pair = pair_offset;
       for (auto neigh : center) {
-        auto dist{manager->get_distance(neigh)};
-        auto direction{manager->get_direction_vector(neigh)};
+        size_t i_pair{next_pair++};
+        if (not is_evaluated(i_pair)) {
+          continue;
+        }
+        double dist{distances(i_neighbour)};
+        auto && direction{directions.col(i_neighbour)};
         Key_t neigh_type{neigh.get_atom_type()};
         auto & coefficients_neigh_gradient =
             expansions_coefficients_gradient[neigh];
 
-        this->spherical_harmonics.calc(direction, this->compute_gradients);
-        auto && harmonics{spherical_harmonics.get_harmonics()};
-        auto && harmonics_gradients{
-            spherical_harmonics.get_harmonics_derivatives()};
+        auto && harmonics{harmonics_neighbours.row(i_neighbour)};
 
         auto && neighbour_contribution =
-            radial_integral
-                ->template compute_neighbour_contribution<SmearingType>(dist,
-                                                                        neigh);
+            radial_integral->get_neighbour_contribution(i_neighbour);
         double f_c{cutoff_function->f_c(dist)};
         auto && coefficients_center_by_type{coefficients_center[neigh_type]};
 
         // compute the coefficients
-        size_t l_block_idx{0};
-        for (size_t angular_l{0}; angular_l < this->max_angular + 1;
-             ++angular_l) {
-          size_t l_block_size{2 * angular_l + 1};
-          coefficients_center_by_type.block(0, l_block_idx, max_radial,
-                                            l_block_size) +=
-              (neighbour_contribution.col(angular_l) *
-               (harmonics.segment(l_block_idx, l_block_size) * f_c));
-          l_block_idx += l_block_size;
+        auto add_pair_contribution = [&](auto && coefficients) {
+          size_t l_block_idx{0};
+          for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+               ++angular_l) {
+            size_t l_block_size{2 * angular_l + 1};
+            coefficients.block(0, l_block_idx, max_radial, l_block_size) +=
+                (neighbour_contribution.col(angular_l) *
+                 (harmonics.segment(l_block_idx, l_block_size) * f_c));
+            l_block_idx += l_block_size;
+          }
+        };
+        add_pair_contribution(coefficients_center_by_type);
+        if (this->use_pair_parity and
+            reverse_pairs.get_reverse(i_pair) != reverse_pairs.NoReverse) {
+          size_t shared_index(reverse_pairs.get_shared_index(i_pair));
+          auto && coefficients_pair{
+              pair_coefficients.block(0, shared_index * n_col, n_row, n_col)};
+          coefficients_pair.setZero();
+          add_pair_contribution(coefficients_pair);
         }
 
         // compute the gradients of the coefficients with respect to
@@ -1195,9 +1891,7 @@ namespace rascal {
               neigh_types, n_spatial_dimensions * n_row, n_col, 0.);
 
           auto && neighbour_derivative =
-              radial_integral
-                  ->template compute_neighbour_derivative<SmearingType>(dist,
-                                                                        neigh);
+              radial_integral->get_neighbour_derivative(i_neighbour);
           double df_c{cutoff_function->df_c(dist)};
           // The gradients only contribute to the type of the neighbour
           // (the atom that's moving)
@@ -1228,8 +1922,9 @@ namespace rascal {
                 * direction(cartesian_idx);
               pair_gradient_contribution +=
                   neighbour_contribution.col(angular_l)
-                  * harmonics_gradients.block(cartesian_idx, l_block_idx,
-                                              1, l_block_size)
+                  * harmonics_gradients_neighbours.block(
+                      i_neighbour, cartesian_idx * n_col + l_block_idx,
+                      1, l_block_size)
                   * f_c / dist;
 
               // Each Cartesian gradient component occupies a contiguous block
@@ -1245,17 +1940,109 @@ namespace rascal {
             }  // for (angular_l)
           }    // for cartesian_idx
         }      // if (this->compute_gradients)
-      }        // for (neigh : center)
+        ++i_neighbour;
+      }  // for (neigh : center)
+    };   // compute_center
+
+    // add the contributions of the pairs that were evaluated as ji-pairs
+    auto add_reverse_pairs = [&](size_t /*thread_id*/, auto & center) {
+      auto & coefficients_center = expansions_coefficients[center];
+      Key_t center_type{center.get_atom_type()};
+
+      size_t next_pair{reverse_pairs.get_offset(center.get_index())};
+      for (auto neigh : center) {
+        size_t i_pair{next_pair++};
+        if (reverse_pairs.is_evaluated(i_pair)) {
+          continue;
+        }
+        size_t reverse_pair(reverse_pairs.get_reverse(i_pair));
+        Key_t neigh_type{neigh.get_atom_type()};
+        auto && coefficients_center_by_type{coefficients_center[neigh_type]};
+        size_t shared_index(reverse_pairs.get_shared_index(i_pair));
+        auto && coefficients_reverse{
+            pair_coefficients.block(0, shared_index * n_col, n_row, n_col)};
 
-      // Normalize and orthogonalize the radial coefficients
-      radial_integral->finalize_coefficients(coefficients_center);
+        size_t l_block_idx{0};
+        for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+             ++angular_l) {
+          size_t l_block_size{2 * angular_l + 1};
+          double parity{angular_l % 2 == 0 ? 1. : -1.};
+          coefficients_center_by_type.block(0, l_block_idx, max_radial,
+                                            l_block_size) +=
+              parity * coefficients_reverse.block(0, l_block_idx, max_radial,
+                                                  l_block_size);
+          l_block_idx += l_block_size;
+        }
+
+        if (this->compute_gradients) {
+          // grad_j c^{ij} of the evaluated pair, hence
+          // grad_i c^{ji} = -(-1)^l grad_j c^{ij} and
+          // grad_j c^{ji} = (-1)^l grad_j c^{ij}
+          auto && gradient_reverse{expansions_coefficients_gradient
+                                       [reverse_pairs.get_cluster_index(
+                                           reverse_pair)][center_type]};
+          auto & coefficients_neigh_gradient =
+              expansions_coefficients_gradient[neigh];
+          std::vector<Key_t> neigh_types{neigh_type};
+          coefficients_neigh_gradient.resize(
+              neigh_types, n_spatial_dimensions * n_row, n_col, 0.);
+          auto && gradient_center_by_type{
+              expansions_coefficients_gradient[center.get_atom_ii()]
+                                              [neigh_type]};
+          auto && gradient_neigh_by_type{
+              coefficients_neigh_gradient[neigh_type]};
+          for (int cartesian_idx{0}; cartesian_idx < n_spatial_dimensions;
+               ++cartesian_idx) {
+            size_t l_block_idx{0};
+            for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+                 ++angular_l) {
+              size_t l_block_size{2 * angular_l + 1};
+              double parity{angular_l % 2 == 0 ? 1. : -1.};
+              auto && gradient_block{gradient_reverse.block(
+                  cartesian_idx * max_radial, l_block_idx, max_radial,
+                  l_block_size)};
+              gradient_center_by_type.block(cartesian_idx * max_radial,
+                                            l_block_idx, max_radial,
+                                            l_block_size) +=
+                  parity * gradient_block;
+              gradient_neigh_by_type.block(cartesian_idx * max_radial,
+                                           l_block_idx, max_radial,
+                                           l_block_size) -=
+                  parity * gradient_block;
+              l_block_idx += l_block_size;
+            }  // for (angular_l)
+          }    // for cartesian_idx
+        }      // if (this->compute_gradients)
+      }        // for (neigh : center)
+    };         // add_reverse_pairs
+
+    // Normalize and orthogonalize the radial coefficients
+    auto finalize_center = [&](size_t thread_id, auto & center) {
+      auto & calculator{thread_id == 0 ? *this
+                                       : *calculator_copies[thread_id - 1]};
+      auto radial_integral{
+          downcast_radial_integral<RadialType>(calculator.radial_integral)};
+      radial_integral->finalize_coefficients(expansions_coefficients[center]);
       if (this->compute_gradients) {
         radial_integral
             ->template finalize_coefficients_der<n_spatial_dimensions>(
                 expansions_coefficients_gradient, center);
       }
-    }  // for (center : manager)
-  }    // compute()
+    };
+
+    if (this->use_pair_parity) {
+      // every pass reads the results of the previous one for other centers
+      internal::for_each_center(manager, n_threads, compute_center);
+      internal::for_each_center(manager, n_threads, add_reverse_pairs);
+      internal::for_each_center(manager, n_threads, finalize_center);
+    } else {
+      internal::for_each_center(
+          manager, n_threads, [&](size_t thread_id, auto & center) {
+            compute_center(thread_id, center);
+            finalize_center(thread_id, center);
+          });
+    }
+  }  // compute()
 
 }  // namespace rascal
 
@@ -39,8 +39,12 @@
 #include "math/math_utils.hh"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <complex>
 #include <exception>
+#include <map>
+#include <utility>
 #include <vector>
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
@@ -114,44 +118,36 @@ namespace rascal {
         SphericalInvariantsType::BiSpectrum>
         : SphericalInvariantsPrecomputationBase {
       using Hypers_t = typename SphericalInvariantsPrecomputationBase::Hypers_t;
+      using complex = std::complex<double>;
+
+      /**
+       * Non zero coupling of three real expansion coefficients: the l0-th
+       * bispectrum component gets weight * c1(n1, lm1) * c2(n2, lm2) *
+       * c3(n3, lm3) for all n1, n2, n3.
+       */
+      struct RealCoupling {
+        size_t l0;
+        size_t lm1;
+        size_t lm2;
+        size_t lm3;
+        double weight;
+      };
+
+      /**
+       * The bispectrum is defined with the complex expansion coefficients
+       * and the Wigner 3j symbols. Each complex coefficient is a combination
+       * of at most two real ones so the sum over (m1, m2, m3) is expanded
+       * once here into a sparse list of real couplings. The terms that
+       * involve the same real coefficients are merged and the ones that
+       * cancel are dropped.
+       */
       explicit SphericalInvariantsPrecomputation(const Hypers_t & hypers) {
         this->max_angular = hypers.at("max_angular").get<size_t>();
         this->inversion_symmetry = hypers.at("inversion_symmetry").get<bool>();
-        // get the number of non zero elements in the w3j
-        int n_elements{0};
-        for (size_t l1{0}; l1 < this->max_angular + 1; ++l1) {
-          for (size_t l2{0}; l2 < this->max_angular + 1; ++l2) {
-            for (size_t l3{0}; l3 < this->max_angular + 1; ++l3) {
-              if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                  (l1 > l2 + l3)) {
-                continue;
-              }
-              if (this->inversion_symmetry == true) {
-                if ((l1 + l2 + l3) % 2 == 1) {
-                  continue;
-                }
-              }
-              for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                int m1s{static_cast<int>(m1 - l1)};
-                for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                  int m2s{static_cast<int>(m2 - l2)};
-                  for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                    int m3s{static_cast<int>(m3 - l3)};
-                    if (m1s + m2s + m3s != 0) {
-                      continue;
-                    }
-                    ++n_elements;
-                  }
-                }
-              }
-            }
-          }
-        }
 
-        this->wigner_w3js.resize(n_elements);
-        n_elements = 0;
         wig_table_init(2 * (this->max_angular + 1), 3);
         wig_temp_init(2 * (this->max_angular + 1));
+        size_t l0{0};
         for (size_t l1{0}; l1 < this->max_angular + 1; ++l1) {
           for (size_t l2{0}; l2 < this->max_angular + 1; ++l2) {
             for (size_t l3{0}; l3 < this->max_angular + 1; ++l3) {
@@ -164,21 +160,41 @@ namespace rascal {
                   continue;
                 }
               }
-              for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                int m1s{static_cast<int>(m1 - l1)};
-                for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                  int m2s{static_cast<int>(m2 - l2)};
-                  for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                    int m3s{static_cast<int>(m3 - l3)};
-                    if (m1s + m2s + m3s != 0) {
-                      continue;
+              // the components are purely real or imaginary depending on
+              // the parity of l1 + l2 + l3
+              bool is_real{(l1 + l2 + l3) % 2 == 0};
+              std::map<std::array<size_t, 3>, double> block_weights{};
+              int l1s{static_cast<int>(l1)}, l2s{static_cast<int>(l2)},
+                  l3s{static_cast<int>(l3)};
+              for (int m1s{-l1s}; m1s < l1s + 1; ++m1s) {
+                for (int m2s{-l2s}; m2s < l2s + 1; ++m2s) {
+                  int m3s{-m1s - m2s};
+                  if (std::abs(m3s) > l3s) {
+                    continue;
+                  }
+                  double w3j{wig3jj(2 * l1s, 2 * l2s, 2 * l3s, 2 * m1s,
+                                    2 * m2s, 2 * m3s)};
+                  for (auto & term1 : complex_from_real(l1, m1s)) {
+                    for (auto & term2 : complex_from_real(l2, m2s)) {
+                      for (auto & term3 : complex_from_real(l3, m3s)) {
+                        complex product{term1.second * term2.second *
+                                        term3.second};
+                        block_weights[{term1.first, term2.first,
+                                       term3.first}] +=
+                            w3j * (is_real ? product.real() : product.imag());
+                      }
                     }
-                    this->wigner_w3js(n_elements) = wig3jj(
-                        2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, 2 * m3s);
-                    ++n_elements;
                   }
                 }
               }
+              for (auto & block_weight : block_weights) {
+                if (std::abs(block_weight.second) > math::dbl_ftol) {
+                  auto & lms{block_weight.first};
+                  this->couplings.push_back(
+                      {l0, lms[0], lms[1], lms[2], block_weight.second});
+                }
+              }
+              ++l0;
             }
           }
         }
@@ -186,10 +202,61 @@ namespace rascal {
         wig_table_free();
       }
 
+      /**
+       * The complex expansion coefficient (l, m) as a combination of the
+       * real ones, given as (lm index, weight) pairs.
+       * See src/math/spherical_harmonics.hh for the inverse transformation.
+       */
+      static std::vector<std::pair<size_t, complex>>
+      complex_from_real(size_t l, int m) {
+        size_t lm{l * l + l + m};
+        size_t lm_opposite{l * l + l - m};
+        if (m > 0) {
+          double sign{m % 2 == 0 ? 1. : -1.};
+          return {{lm, sign * math::INV_SQRT_TWO},
+                  {lm_opposite, complex{0., sign * math::INV_SQRT_TWO}}};
+        } else if (m == 0) {
+          return {{lm, 1.}};
+        } else {
+          return {{lm_opposite, math::INV_SQRT_TWO},
+                  {lm, complex{0., -math::INV_SQRT_TWO}}};
+        }
+      }
+
       size_t max_angular{0};
       bool inversion_symmetry{};
-      Eigen::ArrayXd wigner_w3js{};
+      std::vector<RealCoupling> couplings{};
     };
+
+    /**
+     * Add the contraction over m of two blocks of expansion coefficients to
+     * a block of power spectrum, i.e.
+     *
+     *   output(n1 * n_max + n2, l) += sum_m coef1(n1, lm) coef2(n2, lm)
+     *
+     * with one (n_max x (2l+1)) * ((2l+1) x n_max) matrix product per l. The
+     * l-th column of output is seen as a strided n_max x n_max matrix so the
+     * products are written in place.
+     */
+    template <class Output, class Coef1, class Coef2>
+    void add_power_spectrum_by_l(Output && output, const Coef1 & coef1,
+                                 const Coef2 & coef2, size_t max_angular) {
+      using Stride_t = Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>;
+      using OutputBlock_t = Eigen::Map<math::Matrix_t, Eigen::Unaligned,
+                                       Stride_t>;
+      const Eigen::Index n_max{coef1.rows()};
+      const Eigen::Index row_stride{output.outerStride()};
+      Eigen::Index l_block_idx{0};
+      for (size_t l{0}; l < max_angular + 1; ++l) {
+        Eigen::Index l_block_size{static_cast<Eigen::Index>(2 * l + 1)};
+        OutputBlock_t output_l(output.data() + l, n_max, n_max,
+                               Stride_t(n_max * row_stride, row_stride));
+        output_l.noalias() +=
+            coef1.middleCols(l_block_idx, l_block_size) *
+            coef2.middleCols(l_block_idx, l_block_size).transpose();
+        l_block_idx += l_block_size;
+      }
+    }
   }  // namespace internal
 
   template <internal::SphericalInvariantsType Type, class Hypers>
@@ -217,6 +284,10 @@ namespace rascal {
     template <class StructureManager>
     using Property_t =
         BlockSparseProperty<double, 1, 0, StructureManager, Key_t>;
+    //! property of the invariants with the "single" precision
+    template <class StructureManager>
+    using PropertySingle_t =
+        BlockSparseProperty<float, 1, 0, StructureManager, Key_t>;
     template <class StructureManager>
     using PropertyGradient_t =
         BlockSparseProperty<double, 2, 0, StructureManager, Key_t>;
@@ -258,6 +329,8 @@ namespace rascal {
       using internal::enumValue;
       using internal::SphericalInvariantsPrecomputationBase;
       using internal::SphericalInvariantsType;
+      this->hypers = hypers;
+      this->calculator_copies.clear();
 
       this->max_radial = hypers.at("max_radial").get<size_t>();
       this->max_angular = hypers.at("max_angular").get<size_t>();
@@ -271,6 +344,20 @@ namespace rascal {
         this->compute_gradients = false;
       }
 
+      // precision in which the invariants are stored, they are computed in
+      // double in any case. Default "double"
+      this->single_precision = false;
+      if (hypers.find("precision") != hypers.end()) {
+        auto precision{hypers.at("precision").get<std::string>()};
+        if (precision == "single") {
+          this->single_precision = true;
+        } else if (precision != "double") {
+          throw std::logic_error("Requested precision \'" + precision +
+                                 "\' is not one of \'double\', " +
+                                 "\'single\'.");
+        }
+      }
+
       if (this->spherical_invariants_type_str.compare("PowerSpectrum") == 0) {
         this->spherical_invariants_type =
             SphericalInvariantsType::PowerSpectrum;
@@ -322,33 +409,51 @@ namespace rascal {
     template <class StructureManager>
     void compute(StructureManager & managers);
 
+    //! compute with the invariants stored in Precision
+    template <class Precision, class StructureManager>
+    void compute_precision(StructureManager & managers);
+
+    /**
+     * @return true if the invariants are stored in single precision, i.e.
+     * in PropertySingle_t instead of Property_t
+     */
+    inline bool is_single_precision() const { return this->single_precision; }
+
     /**
      * loop over a collection of manangers if it is an iterator.
      * Or just call compute_impl
+     *
+     * The managers of a collection are distributed over get_n_threads()
+     * threads, each with its own copy of the spherical expansion calculator.
      */
     template <
-        internal::SphericalInvariantsType BodyOrder, class StructureManager,
+        internal::SphericalInvariantsType BodyOrder, class Precision,
+        class StructureManager,
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
-      for (auto & manager : managers) {
-        this->compute_impl<BodyOrder>(manager);
-      }
+      internal::compute_managers(
+          *this, managers, this->calculator_copies,
+          [](CalculatorSphericalInvariants & calculator, auto & manager,
+             size_t /*i_manager*/) {
+            calculator.template compute_impl<BodyOrder, Precision>(manager);
+          });
     }
 
     //! single manager case
     template <
-        internal::SphericalInvariantsType BodyOrder, class StructureManager,
+        internal::SphericalInvariantsType BodyOrder, class Precision,
+        class StructureManager,
         std::enable_if_t<
             not(internal::is_proper_iterator<StructureManager>::value), int> =
             0>
     void compute_loop(StructureManager & manager) {
-      this->compute_impl<BodyOrder>(manager);
+      this->compute_impl<BodyOrder, Precision>(manager);
     }
 
     //! compute representation @f$ \nu == 1 @f$
     template <
-        internal::SphericalInvariantsType BodyOrder,
+        internal::SphericalInvariantsType BodyOrder, class Precision,
         std::enable_if_t<BodyOrder ==
                              internal::SphericalInvariantsType::RadialSpectrum,
                          int> = 0,
@@ -356,7 +461,7 @@ namespace rascal {
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
     //! compute representation @f$ \nu == 2 @f$
-    template <internal::SphericalInvariantsType BodyOrder,
+    template <internal::SphericalInvariantsType BodyOrder, class Precision,
               std::enable_if_t<
                   BodyOrder == internal::SphericalInvariantsType::PowerSpectrum,
                   int> = 0,
@@ -364,7 +469,7 @@ namespace rascal {
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
     //! compute representation @f$ \nu == 3 @f$
-    template <internal::SphericalInvariantsType BodyOrder,
+    template <internal::SphericalInvariantsType BodyOrder, class Precision,
               std::enable_if_t<
                   BodyOrder == internal::SphericalInvariantsType::BiSpectrum,
                   int> = 0,
@@ -397,6 +502,8 @@ namespace rascal {
     bool normalize{};
     bool compute_gradients{};
     bool inversion_symmetry{false};
+    //! store the invariants in float, see is_single_precision()
+    bool single_precision{false};
 
     CalculatorSphericalExpansion rep_expansion;
 
@@ -406,20 +513,38 @@ namespace rascal {
                internal::enumSize<internal::SphericalInvariantsType>()>
         precompute_spherical_invariants{};
     std::string spherical_invariants_type_str{};
+
+    //! copies used by the threads of compute_loop(), kept from one call to
+    //! the next (see internal::compute_managers())
+    std::vector<std::unique_ptr<CalculatorSphericalInvariants>>
+        calculator_copies{};
   };
 
   template <class StructureManager>
   void CalculatorSphericalInvariants::compute(StructureManager & managers) {
+    if (this->single_precision) {
+      this->compute_precision<float>(managers);
+    } else {
+      this->compute_precision<double>(managers);
+    }
+  }
+
+  template <class Precision, class StructureManager>
+  void CalculatorSphericalInvariants::compute_precision(
+      StructureManager & managers) {
     using internal::SphericalInvariantsType;
     switch (this->spherical_invariants_type) {
     case SphericalInvariantsType::RadialSpectrum:
-      this->compute_loop<SphericalInvariantsType::RadialSpectrum>(managers);
+      this->compute_loop<SphericalInvariantsType::RadialSpectrum, Precision>(
+          managers);
       break;
     case SphericalInvariantsType::PowerSpectrum:
-      this->compute_loop<SphericalInvariantsType::PowerSpectrum>(managers);
+      this->compute_loop<SphericalInvariantsType::PowerSpectrum, Precision>(
+          managers);
       break;
     case SphericalInvariantsType::BiSpectrum:
-      this->compute_loop<SphericalInvariantsType::BiSpectrum>(managers);
+      this->compute_loop<SphericalInvariantsType::BiSpectrum, Precision>(
+          managers);
       break;
     default:
       // Will never reach here (it's an enum...)
@@ -428,7 +553,7 @@ namespace rascal {
   }
 
   template <
-      internal::SphericalInvariantsType BodyOrder,
+      internal::SphericalInvariantsType BodyOrder, class Precision,
       std::enable_if_t<
           BodyOrder == internal::SphericalInvariantsType::PowerSpectrum, int>,
       class StructureManager>
@@ -439,7 +564,8 @@ namespace rascal {
     using PropGradExp_t =
         typename CalculatorSphericalExpansion::PropertyGradient_t<
             StructureManager>;
-    using Prop_t = Property_t<StructureManager>;
+    using Prop_t =
+        BlockSparseProperty<Precision, 1, 0, StructureManager, Key_t>;
     using PropGrad_t = PropertyGradient_t<StructureManager>;
     using internal::enumValue;
     constexpr static int n_spatial_dimensions = StructureManager::dim();
@@ -454,6 +580,7 @@ namespace rascal {
     auto & l_factors{precomputation->l_factors};
 
     // Compute the spherical expansions of the current structure
+    rep_expansion.set_n_threads(this->n_threads);
     rep_expansion.compute(manager);
 
     auto && expansions_coefficients{
@@ -481,14 +608,20 @@ namespace rascal {
     this->initialize_per_center_powerspectrum_soap_vectors(
         soap_vectors, soap_vector_gradients, expansions_coefficients, manager);
 
-    Key_t pair_type{0, 0};
-    // use special container to tell that there is not need to sort when
-    // using operator[] of soap_vector
-    internal::SortedKey<Key_t> spair_type{pair_type};
+    // the invariants are accumulated in double even when stored in float
+    internal::DoubleCenterFeatures<Prop_t> center_features{
+        soap_vectors,
+        utils::resolve_n_threads(this->n_threads, manager->size())};
+
+    // the centers are independent so they can be split over the threads
+    auto compute_center = [&](size_t thread_id, auto & center) {
+      Key_t pair_type{0, 0};
+      // use special container to tell that there is not need to sort when
+      // using operator[] of soap_vector
+      internal::SortedKey<Key_t> spair_type{pair_type};
 
-    for (auto center : manager) {
       auto & coefficients{expansions_coefficients[center]};
-      auto & soap_vector{soap_vectors[center]};
+      auto & soap_vector{center_features.get(thread_id, soap_vectors[center])};
       // Compute the Powerspectrum coefficients
       for (const auto & el1 : coefficients) {
         spair_type[0] = el1.first[0];
@@ -503,24 +636,9 @@ namespace rascal {
           auto & coef2{el2.second};
           auto && soap_vector_by_pair{soap_vector[spair_type]};
 
-          size_t n1n2{0};
-          size_t pos{0}, size{0};
-          for (size_t n1{0}; n1 < this->max_radial; ++n1) {
-            for (size_t n2{0}; n2 < this->max_radial; ++n2) {
-              soap_vector_by_pair(n1n2, 0) = coef1(n1, 0) * coef2(n2, 0);
-              pos = 1;
-              for (size_t l{1}; l < this->max_angular + 1; ++l) {
-                size = 2 * l + 1;
-                // do the reduction over m (with vectorization)
-                soap_vector_by_pair(n1n2, l) =
-                    (coef1.block(n1, pos, 1, size).array() *
-                     coef2.block(n2, pos, 1, size).array())
-                        .sum();
-                pos += size;
-              }
-              ++n1n2;
-            }
-          }
+          soap_vector_by_pair.setZero();
+          internal::add_power_spectrum_by_l(soap_vector_by_pair, coef1, coef2,
+                                            this->max_angular);
           // multiply with the precomputed factors
           soap_vector_by_pair *= l_factors.asDiagonal();
         }  // for el1 : coefficients
@@ -559,49 +677,25 @@ namespace rascal {
                 soap_center_gradient[spair_type]};
 
             // Sum the gradients wrt the central atom position
-            size_t n1n2{0};
-            size_t l_block_idx{0};
-            // TODO(max) looks like this nested loop could be nicely
-            // encapsulated in a separate function
-            for (size_t cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+            // (Leibniz rule for the expansion coefficients)
+            size_t n_rows_n1n2{math::pow(this->max_radial, 2_n)};
+            for (int cartesian_idx{0}; cartesian_idx < n_spatial_dimensions;
+                 ++cartesian_idx) {
               size_t cartesian_offset_n{cartesian_idx * this->max_radial};
-              size_t cartesian_offset_n1n2{
-                  cartesian_idx *
-                  static_cast<size_t>(math::pow(this->max_radial, 2))};
-              n1n2 = 0;
-              for (size_t n1{0}; n1 < this->max_radial; ++n1) {
-                for (size_t n2{0}; n2 < this->max_radial; ++n2) {
-                  // NOTE(max) this is included in the l=0 case, no?
-                  // soap_center_gradient_by_species_pair(n1n2, 0) =
-                  // coef1(n1, 0) * coef2(n2, 0);
-                  // pos = 1;
-                  l_block_idx = 0;
-                  for (size_t l{0}; l < this->max_angular + 1; ++l) {
-                    size_t l_block_size{2 * l + 1};
-                    // do the reduction over m (with vectorization)
-                    // Leibniz rule for the expansion coefficients
-                    // clang-format off
-                    soap_center_gradient_by_species_pair(
-                            n1n2 + cartesian_offset_n1n2, l) =
-                      ((expansion_coefficients_1.block(
-                                n1, l_block_idx,
-                                1,  l_block_size).array() *
-                        grad_center_coefficients_2.block(
-                                n2 + cartesian_offset_n, l_block_idx,
-                                1, l_block_size).array()).sum()) +
-                      ((grad_center_coefficients_1.block(
-                                n1 + cartesian_offset_n, l_block_idx,
-                                1, l_block_size).array() *
-                        expansion_coefficients_2.block(
-                                n2, l_block_idx,
-                                1,  l_block_size).array()).sum());
-                    // clang-format on
-                    l_block_idx += l_block_size;
-                  }
-                  ++n1n2;
-                }  // for n2
-              }    // for n1
-            }      // for cartesian_idx
+              auto && soap_center_gradient_cartesian{
+                  soap_center_gradient_by_species_pair.middleRows(
+                      cartesian_idx * n_rows_n1n2, n_rows_n1n2)};
+              internal::add_power_spectrum_by_l(
+                  soap_center_gradient_cartesian, expansion_coefficients_1,
+                  grad_center_coefficients_2.middleRows(cartesian_offset_n,
+                                                        this->max_radial),
+                  this->max_angular);
+              internal::add_power_spectrum_by_l(
+                  soap_center_gradient_cartesian,
+                  grad_center_coefficients_1.middleRows(cartesian_offset_n,
+                                                        this->max_radial),
+                  expansion_coefficients_2, this->max_angular);
+            }  // for cartesian_idx
 
             // The gradients also need the 1/sqrt(2l + 1) factors
             soap_center_gradient_by_species_pair *= l_factors.asDiagonal();
@@ -633,71 +727,34 @@ namespace rascal {
               if (neigh_type == spair_type[0]) {
                 const auto & grad_neigh_coefficients_1{
                     grad_neigh_coefficients[grad_species_1.first]};
-                for (size_t cartesian_idx{0}; cartesian_idx < 3;
-                     ++cartesian_idx) {
-                  size_t cartesian_offset_n{cartesian_idx * this->max_radial};
-                  size_t cartesian_offset_n1n2{
-                      cartesian_idx * math::pow(this->max_radial, 2_n)};
-                  n1n2 = 0;
-                  for (size_t n1{0}; n1 < this->max_radial; ++n1) {
-                    for (size_t n2{0}; n2 < this->max_radial; ++n2) {
-                      l_block_idx = 0;
-                      for (size_t l{0}; l < this->max_angular + 1; ++l) {
-                        size_t l_block_size{2 * l + 1};
-                        // clang-format off
-                        soap_neigh_gradient_by_species_pair(
-                                n1n2 + cartesian_offset_n1n2, l) +=
-                          (grad_neigh_coefficients_1.block(
-                                n1 + cartesian_offset_n, l_block_idx,
-                                1,                       l_block_size).array() *
-                           expansion_coefficients_2.block(
-                                n2, l_block_idx,
-                                1,  l_block_size).array()).sum();
-                        // clang-format on
-                        l_block_idx += l_block_size;
-                      }
-                      ++n1n2;
-                    }  // for n2
-                  }    // for n1
-                }      // for cartesian_idx
-              }        // if (neigh_type == spair_type[0])
+                for (int cartesian_idx{0};
+                     cartesian_idx < n_spatial_dimensions; ++cartesian_idx) {
+                  internal::add_power_spectrum_by_l(
+                      soap_neigh_gradient_by_species_pair.middleRows(
+                          cartesian_idx * n_rows_n1n2, n_rows_n1n2),
+                      grad_neigh_coefficients_1.middleRows(
+                          cartesian_idx * this->max_radial, this->max_radial),
+                      expansion_coefficients_2, this->max_angular);
+                }
+              }  // if (neigh_type == spair_type[0])
 
               // Same as above, only gradient wrt neighbour of type 2
               // Necessary because we're only doing a half-iteration over
               // species pairs
-              // TODO(max) consider changing to full iteration and just one of
-              // these if-nested-horrible-for-loop blocks
               if (neigh_type == spair_type[1]) {
                 const auto & grad_neigh_coefficients_2{
                     grad_neigh_coefficients[grad_species_2.first]};
-                for (size_t cartesian_idx{0}; cartesian_idx < 3;
-                     ++cartesian_idx) {
-                  size_t cartesian_offset_n{cartesian_idx * this->max_radial};
-                  size_t cartesian_offset_n1n2{
-                      cartesian_idx * math::pow(this->max_radial, 2_n)};
-                  n1n2 = 0;
-                  for (size_t n1{0}; n1 < this->max_radial; ++n1) {
-                    for (size_t n2{0}; n2 < this->max_radial; ++n2) {
-                      l_block_idx = 0;
-                      for (size_t l{0}; l < this->max_angular + 1; ++l) {
-                        size_t l_block_size{2 * l + 1};
-                        // clang-format off
-                        soap_neigh_gradient_by_species_pair(
-                                n1n2 + cartesian_offset_n1n2, l) +=
-                          (expansion_coefficients_1.block(
-                                n1, l_block_idx,
-                                1,  l_block_size).array() *
-                           grad_neigh_coefficients_2.block(
-                                n2 + cartesian_offset_n, l_block_idx,
-                                1, l_block_size).array()).sum();
-                        // clang-format on
-                        l_block_idx += l_block_size;
-                      }
-                      ++n1n2;
-                    }  // for n2
-                  }    // for n1
-                }      // for cartesian_idx
-              }        // if (neigh_type == spair_type[1])
+                for (int cartesian_idx{0};
+                     cartesian_idx < n_spatial_dimensions; ++cartesian_idx) {
+                  internal::add_power_spectrum_by_l(
+                      soap_neigh_gradient_by_species_pair.middleRows(
+                          cartesian_idx * n_rows_n1n2, n_rows_n1n2),
+                      expansion_coefficients_1,
+                      grad_neigh_coefficients_2.middleRows(
+                          cartesian_idx * this->max_radial, this->max_radial),
+                      this->max_angular);
+                }
+              }  // if (neigh_type == spair_type[1])
 
               // Same factors as for the gradient wrt center
               soap_neigh_gradient_by_species_pair *= l_factors.asDiagonal();
@@ -806,11 +863,14 @@ namespace rascal {
           }    // for neigh : center
         }      // if normalize
       }        // if compute gradients
-    }          // for center : manager
-  }            // compute_powerspectrum()
+      center_features.store(thread_id, soap_vectors[center]);
+    };         // compute_center
+
+    internal::for_each_center(manager, this->n_threads, compute_center);
+  }  // compute_powerspectrum()
 
   template <
-      internal::SphericalInvariantsType BodyOrder,
+      internal::SphericalInvariantsType BodyOrder, class Precision,
       std::enable_if_t<
           BodyOrder == internal::SphericalInvariantsType::RadialSpectrum, int>,
       class StructureManager>
@@ -821,10 +881,12 @@ namespace rascal {
     using PropGradExp_t =
         typename CalculatorSphericalExpansion::PropertyGradient_t<
             StructureManager>;
-    using Prop_t = Property_t<StructureManager>;
+    using Prop_t =
+        BlockSparseProperty<Precision, 1, 0, StructureManager, Key_t>;
     using PropGrad_t = PropertyGradient_t<StructureManager>;
     using math::pow;
 
+    rep_expansion.set_n_threads(this->n_threads);
     rep_expansion.compute(manager);
 
     auto && expansions_coefficients{
@@ -849,11 +911,17 @@ namespace rascal {
 
     this->initialize_per_center_radialspectrum_soap_vectors(
         soap_vectors, soap_vector_gradients, expansions_coefficients, manager);
-    Key_t element_type{0};
 
-    for (auto center : manager) {
+    // the invariants are accumulated in double even when stored in float
+    internal::DoubleCenterFeatures<Prop_t> center_features{
+        soap_vectors,
+        utils::resolve_n_threads(this->n_threads, manager->size())};
+
+    // the centers are independent so they can be split over the threads
+    auto compute_center = [&](size_t thread_id, auto & center) {
+      Key_t element_type{0};
       auto & coefficients{expansions_coefficients[center]};
-      auto & soap_vector{soap_vectors[center]};
+      auto & soap_vector{center_features.get(thread_id, soap_vectors[center])};
 
       for (const auto & el : coefficients) {
         element_type[0] = el.first[0];
@@ -966,11 +1034,14 @@ namespace rascal {
           }  // for (auto neigh : center)
         }    // if (this->normalize)
       }      // if (this->compute_gradients)
-    }        // for (auto center : manager)
+      center_features.store(thread_id, soap_vectors[center]);
+    };       // compute_center
+
+    internal::for_each_center(manager, this->n_threads, compute_center);
   }
 
   template <
-      internal::SphericalInvariantsType BodyOrder,
+      internal::SphericalInvariantsType BodyOrder, class Precision,
       std::enable_if_t<
           BodyOrder == internal::SphericalInvariantsType::BiSpectrum, int>,
       class StructureManager>
@@ -980,7 +1051,8 @@ namespace rascal {
         typename CalculatorSphericalExpansion::Property_t<StructureManager>;
     // using PropGradExp_t = typename
     // CalculatorSphericalExpansion::PropertyGradient_t<StructureManager>;
-    using Prop_t = Property_t<StructureManager>;
+    using Prop_t =
+        BlockSparseProperty<Precision, 1, 0, StructureManager, Key_t>;
     // using PropGrad_t = PropertyGradient_t<StructureManager>;
     using internal::enumValue;
     using internal::SphericalInvariantsType;
@@ -990,8 +1062,9 @@ namespace rascal {
         SphericalInvariantsType::BiSpectrum>(
         this->precompute_spherical_invariants[enumValue(
             SphericalInvariantsType::BiSpectrum)])};
-    auto & wigner_w3js{precomputation->wigner_w3js};
+    auto & couplings{precomputation->couplings};
 
+    rep_expansion.set_n_threads(this->n_threads);
     rep_expansion.compute(manager);
 
     auto && expansions_coefficients{
@@ -1010,16 +1083,22 @@ namespace rascal {
     this->initialize_per_center_bispectrum_soap_vectors(
         soap_vectors, expansions_coefficients, manager);
 
-    using complex = std::complex<double>;
-
-    // factor that takes into acount the missing equivalent off diagonal
-    // element with respect to the key (or species) index
-    double mult{1.0};
-    Key_t trip_type{0, 0, 0};
-    internal::SortedKey<Key_t> triplet_type{trip_type};
-    for (auto center : manager) {
+    // the invariants are accumulated in double even when stored in float
+    internal::DoubleCenterFeatures<Prop_t> center_features{
+        soap_vectors,
+        utils::resolve_n_threads(this->n_threads, manager->size())};
+
+    // the centers are independent so they can be split over the threads
+    auto compute_center = [&](size_t thread_id, auto & center) {
+      // factor that takes into acount the missing equivalent off diagonal
+      // element with respect to the key (or species) index
+      double mult{1.0};
+      Key_t trip_type{0, 0, 0};
+      internal::SortedKey<Key_t> triplet_type{trip_type};
       auto & coefficients{expansions_coefficients[center]};
-      auto & soap_vector{soap_vectors[center]};
+      auto & soap_vector{center_features.get(thread_id, soap_vectors[center])};
+      // weight * c1(n1, lm1) * c2(n2, lm2) of every coupling
+      Eigen::ArrayXd products(couplings.size());
 
       for (const auto & el1 : coefficients) {
         triplet_type[0] = el1.first[0];
@@ -1050,102 +1129,22 @@ namespace rascal {
               size_t nn{0};
               for (size_t n1{0}; n1 < this->max_radial; n1++) {
                 for (size_t n2{0}; n2 < this->max_radial; n2++) {
+                  for (size_t i_coupling{0}; i_coupling < couplings.size();
+                       ++i_coupling) {
+                    auto & coupling{couplings[i_coupling]};
+                    products(i_coupling) = mult * coupling.weight *
+                                           coef1(n1, coupling.lm1) *
+                                           coef2(n2, coupling.lm2);
+                  }
                   for (size_t n3{0}; n3 < this->max_radial; n3++) {
-                    size_t l0{0};
-                    int wigner_count{0};
-                    for (size_t l1{0}; l1 < this->max_angular + 1; l1++) {
-                      for (size_t l2{0}; l2 < this->max_angular + 1; l2++) {
-                        for (size_t l3{0}; l3 < this->max_angular + 1; l3++) {
-                          if (this->inversion_symmetry == true) {
-                            if ((l1 + l2 + l3) % 2 == 1) {
-                              continue;
-                            }
-                          }
-
-                          if ((l1 <
-                               static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                              (l1 > l2 + l3)) {
-                            continue;
-                          }
-
-                          for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                            int m1s{static_cast<int>(m1 - l1)};
-                            size_t lm1{math::pow(l1, 2_n) + m1};
-                            for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                              int m2s{static_cast<int>(m2 - l2)};
-                              size_t lm2{math::pow(l2, 2_n) + m2};
-                              for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                                int m3s{static_cast<int>(m3 - l3)};
-                                if (m1s + m2s + m3s != 0) {
-                                  continue;
-                                }
-                                size_t lm3{math::pow(l3, 2_n) + m3};
-                                double w3j = wigner_w3js[wigner_count];
-                                complex coef1c, coef2c, coef3c;
-                                // usual formulae for converting from real to
-                                // complex
-                                // see src/math/spherical_harmonics.hh for the
-                                // inverse transformation
-                                // TODO(andrea, michael) avoid complex
-                                // arithmetic
-                                if (m1s > 0) {
-                                  coef1c = math::pow(-1, m1s) *
-                                           complex{coef1(n1, lm1),
-                                                   coef1(n1, lm1 - 2 * m1s)};
-                                } else if (m1s == 0) {
-                                  coef1c = complex(coef1(n1, lm1), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m1s < 0) {
-                                  coef1c = complex{coef1(n1, lm1 - 2 * m1s),
-                                                   -coef1(n1, lm1)};
-                                }
-                                if (m2s > 0) {
-                                  coef2c = math::pow(-1.0, m2s) *
-                                           complex{coef2(n2, lm2),
-                                                   coef2(n2, lm2 - 2 * m2s)};
-                                } else if (m2s == 0) {
-                                  coef2c = complex(coef2(n2, lm2), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m2s < 0) {
-                                  coef2c = complex{coef2(n2, lm2 - 2 * m2s),
-                                                   -coef2(n2, lm2)};
-                                }
-                                if (m3s > 0) {
-                                  coef3c = math::pow(-1.0, m3s) *
-                                           complex{coef3(n3, lm3),
-                                                   coef3(n3, lm3 - 2 * m3s)};
-                                } else if (m3s == 0) {
-                                  coef3c = complex(coef3(n3, lm3), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m3s < 0) {
-                                  coef3c = complex{coef3(n3, lm3 - 2 * m3s),
-                                                   -coef3(n3, lm3)};
-                                }
-                                coef1c *= math::INV_SQRT_TWO;
-                                coef2c *= math::INV_SQRT_TWO;
-                                coef3c *= math::INV_SQRT_TWO;
-
-                                // The descriptor components are purely real or
-                                // imaginary
-                                // depending on the divisibility of l1 + l2 +l3
-                                // by 2.
-                                if ((l1 + l2 + l3) % 2 == 0) {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).real();
-                                } else {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).imag();
-                                }
-                                wigner_count++;
-                              }  // m3
-                            }    // m2
-                          }      // m1
-                          l0++;
-                        }  // l3
-                      }    // l2
-                    }      // l1
+                    auto && soap_row{soap_vector_by_type.row(nn)};
+                    auto && coef3_row{coef3.row(n3)};
+                    for (size_t i_coupling{0}; i_coupling < couplings.size();
+                         ++i_coupling) {
+                      auto & coupling{couplings[i_coupling]};
+                      soap_row(coupling.l0) +=
+                          products(i_coupling) * coef3_row(coupling.lm3);
+                    }
                     nn++;
                   }  // n3
                 }    // n2
@@ -1159,8 +1158,11 @@ namespace rascal {
       if (this->normalize) {
         soap_vector.normalize();
       }
-    }  // center
-  }    // end function
+      center_features.store(thread_id, soap_vectors[center]);
+    };  // compute_center
+
+    internal::for_each_center(manager, this->n_threads, compute_center);
+  }  // end function
 
   template <class StructureManager, class Invariants, class ExpansionCoeff>
   void
@@ -0,0 +1,306 @@
+/**
+ * @file   feature_stream.hh
+ *
+ * @brief  featurize the structures of a file in chunks, without holding all
+ *         the structures or all their representations in memory
+ *
+ * Copyright  2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_REPRESENTATIONS_FEATURE_STREAM_HH_
+#define SRC_REPRESENTATIONS_FEATURE_STREAM_HH_
+
+#include "representations/calculator_base.hh"
+#include "structure_managers/structure_manager_collection.hh"
+#include "math/math_utils.hh"
+#include "utils/parallel_for.hh"
+#include "json_io.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Structures of a file featurized together, see stream_dense_features()
+   */
+  struct FeatureChunk {
+    //! ids of the structures in the file
+    std::vector<int> ids{};
+    //! first row of each structure in the features of the chunk, and the
+    //! number of rows at the back
+    std::vector<size_t> offsets{0};
+  };
+
+  /**
+   * Compute the dense feature matrix of the structures of a file in the ase
+   * format (see json_io::read_ase_structures) by chunks of chunk_size
+   * structures, without ever holding the whole file, all the managers or
+   * the whole feature matrix in memory.
+   *
+   * The calling thread reads the structures while n_threads worker threads
+   * (0 means all the available hardware threads) build the managers of a
+   * chunk, compute the representation with their own single threaded copy
+   * of calculator and fill the features of the chunk. The features are
+   * handed over in the order of the file as
+   *
+   *   callback(first_row, const FeatureChunk & chunk,
+   *            const Eigen::Ref<const math::Matrix_t> & features)
+   *
+   * with one row per center and the columns of keys, like
+   * ManagerCollection::get_dense_feature_matrix() with a fixed set of keys,
+   * after which the managers of the chunk are freed. At most one chunk per
+   * worker is held at any time (and as many waiting to be computed).
+   *
+   * @tparam ManagerCollection_t the ManagerCollection type defining the
+   *         adaptor stack
+   * @param keys keys of the BlockSparseProperty of the calculator giving the
+   *             columns of the features, e.g. all the species pairs for the
+   *             power spectrum; the other keys are ignored
+   * @return number of rows, i.e. of centers
+   */
+  template <class ManagerCollection_t, class Calculator, class Keys,
+            class Callback>
+  size_t stream_dense_features(const std::string & filename,
+                               const json & adaptor_parameters,
+                               const Calculator & calculator,
+                               const Keys & keys, size_t chunk_size,
+                               size_t n_threads, Callback && callback) {
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    struct PendingChunk {
+      size_t index{0};
+      FeatureChunk chunk{};
+      std::vector<json> structures{};
+    };
+
+    if (chunk_size == 0) {
+      throw std::runtime_error("chunk_size should be positive");
+    }
+    n_threads = utils::resolve_n_threads(n_threads,
+                                         std::numeric_limits<size_t>::max());
+
+    // compute the features of a chunk, the managers being freed on return
+    auto compute_chunk = [&](Calculator & worker_calculator,
+                             PendingChunk & pending,
+                             math::Matrix_t & features) {
+      ManagerCollection_t collection{adaptor_parameters};
+      for (auto & structure : pending.structures) {
+        collection.add_structure(structure);
+      }
+      pending.structures.clear();
+      worker_calculator.compute(collection);
+
+      auto & offsets{pending.chunk.offsets};
+      internal::visit_feature_property<Calculator, Manager_t>(
+          worker_calculator, [&](auto property_type) {
+            using Prop_t = typename decltype(property_type)::type;
+            int n_cols{0};
+            for (auto & manager : collection) {
+              auto && property{
+                  manager->template get_validated_property_ref<Prop_t>(
+                      worker_calculator.get_name())};
+              n_cols = property.get_nb_comp() * static_cast<int>(keys.size());
+              offsets.push_back(offsets.back() + property.size());
+            }
+            features.setZero(offsets.back(), n_cols);
+            size_t i_structure{0};
+            for (auto & manager : collection) {
+              auto && property{
+                  manager->template get_validated_property_ref<Prop_t>(
+                      worker_calculator.get_name())};
+              property.fill_dense_feature_matrix(
+                  features.middleRows(offsets[i_structure],
+                                      offsets[i_structure + 1] -
+                                          offsets[i_structure]),
+                  keys);
+              ++i_structure;
+            }
+          });
+    };
+
+    size_t n_rows{0};
+    if (n_threads == 1) {
+      auto copies{internal::make_calculator_copies(calculator, 1)};
+      PendingChunk pending{};
+      math::Matrix_t features{};
+      auto flush = [&]() {
+        compute_chunk(*copies[0], pending, features);
+        callback(n_rows, static_cast<const FeatureChunk &>(pending.chunk),
+                 static_cast<const math::Matrix_t &>(features));
+        n_rows += features.rows();
+        pending = PendingChunk{};
+      };
+      json_io::read_ase_structures(filename, [&](int id, json && structure) {
+        pending.chunk.ids.push_back(id);
+        pending.structures.push_back(std::move(structure));
+        if (pending.structures.size() == chunk_size) {
+          flush();
+        }
+        return true;
+      });
+      if (not pending.structures.empty()) {
+        flush();
+      }
+      return n_rows;
+    }
+
+    std::mutex mutex{};
+    std::condition_variable queue_changed{}, emitted{};
+    std::deque<PendingChunk> queue{};
+    bool done_reading{false};
+    size_t next_to_emit{0};
+    std::exception_ptr error{nullptr};
+    auto set_error = [&]() {
+      std::lock_guard<std::mutex> lock{mutex};
+      if (not error) {
+        error = std::current_exception();
+      }
+      queue_changed.notify_all();
+      emitted.notify_all();
+    };
+
+    // the workers already use all the threads, the copies should not start
+    // their own (see CalculatorBase::set_n_threads())
+    auto copies{internal::make_calculator_copies(calculator, n_threads)};
+    for (auto & copy : copies) {
+      copy->set_n_threads(1);
+    }
+    auto worker = [&](size_t thread_id) {
+      math::Matrix_t features{};
+      try {
+        while (true) {
+          PendingChunk pending{};
+          {
+            std::unique_lock<std::mutex> lock{mutex};
+            queue_changed.wait(lock, [&]() {
+              return error or done_reading or not queue.empty();
+            });
+            if (error or queue.empty()) {
+              return;
+            }
+            pending = std::move(queue.front());
+            queue.pop_front();
+          }
+          queue_changed.notify_all();
+          compute_chunk(*copies[thread_id], pending, features);
+          // hand over the chunks in the order of the file
+          std::unique_lock<std::mutex> lock{mutex};
+          emitted.wait(lock, [&]() {
+            return error or next_to_emit == pending.index;
+          });
+          if (error) {
+            return;
+          }
+          callback(n_rows, static_cast<const FeatureChunk &>(pending.chunk),
+                   static_cast<const math::Matrix_t &>(features));
+          n_rows += features.rows();
+          ++next_to_emit;
+          emitted.notify_all();
+        }
+      } catch (...) {
+        set_error();
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(n_threads);
+    for (size_t thread_id{0}; thread_id < n_threads; ++thread_id) {
+      threads.emplace_back(worker, thread_id);
+    }
+
+    try {
+      PendingChunk pending{};
+      size_t n_chunks{0};
+      auto push = [&]() {
+        pending.index = n_chunks++;
+        std::unique_lock<std::mutex> lock{mutex};
+        // bound the number of chunks read ahead of the workers
+        queue_changed.wait(lock,
+                           [&]() { return error or queue.size() < n_threads; });
+        if (error) {
+          return false;
+        }
+        queue.push_back(std::move(pending));
+        pending = PendingChunk{};
+        queue_changed.notify_all();
+        return true;
+      };
+      json_io::read_ase_structures(filename, [&](int id, json && structure) {
+        pending.chunk.ids.push_back(id);
+        pending.structures.push_back(std::move(structure));
+        if (pending.structures.size() == chunk_size) {
+          return push();
+        }
+        return true;
+      });
+      if (not pending.structures.empty()) {
+        push();
+      }
+    } catch (...) {
+      set_error();
+    }
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      done_reading = true;
+    }
+    queue_changed.notify_all();
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return n_rows;
+  }
+
+  /**
+   * Same as stream_dense_features() but the features are written in the
+   * rows of a preallocated matrix (e.g. mapped on a memory mapped file),
+   * which should have at least as many rows as there are centers in the
+   * file.
+   */
+  template <class ManagerCollection_t, class Calculator, class Keys>
+  size_t stream_dense_features_into(const std::string & filename,
+                                    const json & adaptor_parameters,
+                                    const Calculator & calculator,
+                                    const Keys & keys, size_t chunk_size,
+                                    size_t n_threads,
+                                    Eigen::Ref<math::Matrix_t> features) {
+    return stream_dense_features<ManagerCollection_t>(
+        filename, adaptor_parameters, calculator, keys, chunk_size, n_threads,
+        [&features](size_t first_row, const FeatureChunk &,
+                    const Eigen::Ref<const math::Matrix_t> & chunk_features) {
+          if (first_row + chunk_features.rows() >
+                  static_cast<size_t>(features.rows()) or
+              chunk_features.cols() != features.cols()) {
+            throw std::runtime_error(
+                "The features do not fit in the output matrix.");
+          }
+          features.middleRows(first_row, chunk_features.rows()) =
+              chunk_features;
+        });
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_REPRESENTATIONS_FEATURE_STREAM_HH_
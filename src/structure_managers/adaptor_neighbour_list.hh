@@ -38,8 +38,13 @@
 #include "rascal_utility.hh"
 #include "structure_managers/property.hh"
 #include "structure_managers/structure_manager.hh"
+#include "utils/parallel_for.hh"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <set>
+#include <utility>
 #include <vector>
 
 namespace rascal {
@@ -298,25 +303,6 @@ namespace rascal {
           extent;  //!< repetitions in each dimension
     };
 
-    /* ---------------------------------------------------------------------- */
-    //! get dimension dependent neighbour indices (surrounding cell and the cell
-    //! itself
-    template <size_t Dim, class Container_t>
-    void fill_neighbours_atom_tag(const int current_atom_tag,
-                                  const std::array<int, Dim> & ccoord,
-                                  const Container_t & boxes,
-                                  std::vector<int> & neighbours_atom_tag) {
-      neighbours_atom_tag.clear();
-      for (auto && s : Stencil<Dim>{ccoord}) {
-        for (const auto & neigh : boxes[s]) {
-          // avoid adding the current i atom to the neighbour list
-          if (neigh != current_atom_tag) {
-            neighbours_atom_tag.push_back(neigh);
-          }
-        }
-      }
-    }
-
     /* ---------------------------------------------------------------------- */
     //! get the cell index for a position
     template <class Vector_t>
@@ -347,6 +333,19 @@ namespace rascal {
       return retval;
     }
 
+    /* ---------------------------------------------------------------------- */
+    //! get the coordinates of a voxel from its linear index in a given grid
+    template <size_t Dim>
+    std::array<int, Dim> get_ccoord(const std::array<int, Dim> & sizes,
+                                    Dim_t index) {
+      std::array<int, Dim> ccoord{};
+      for (Dim_t i = Dim - 1; i >= 0; --i) {
+        ccoord[i] = index % sizes[i];
+        index /= sizes[i];
+      }
+      return ccoord;
+    }
+
     /* ---------------------------------------------------------------------- */
     //! test if position inside
     template <int Dim>
@@ -369,52 +368,138 @@ namespace rascal {
 
     /* ---------------------------------------------------------------------- */
     /**
-     * storage for cell coordinates of atoms depending on the number of
-     * dimensions
+     * Cell list of the mesh used by the linked cell algorithm. The atoms are
+     * sorted into the boxes with a counting sort and stored in a compressed
+     * sparse row layout: the atoms of the box with linear index ``i_box`` are
+     * the entries ``offsets[i_box]`` to ``offsets[i_box + 1] - 1`` of
+     * ``atom_tags``, in increasing order of atom tag. Their positions are
+     * stored in the same order so that the distances between the atoms of
+     * two boxes are computed from contiguous memory.
      */
     template <int Dim>
-    class IndexContainer {
+    class CellList {
      public:
+      using Positions_t = Eigen::Matrix<double, Dim, Eigen::Dynamic>;
+
       //! Default constructor
-      IndexContainer() = delete;
+      CellList() = delete;
 
-      //! Constructor with size
-      explicit IndexContainer(const std::array<int, Dim> & nboxes)
-          : nboxes{nboxes} {
+      //! Constructor with the number of boxes in each dimension
+      explicit CellList(const std::array<int, Dim> & nboxes) : nboxes{nboxes} {
         auto ntot = std::accumulate(nboxes.begin(), nboxes.end(), 1,
                                     std::multiplies<int>());
-        data.resize(ntot);
+        this->offsets.resize(ntot + 1);
       }
 
       //! Copy constructor
-      IndexContainer(const IndexContainer & other) = delete;
+      CellList(const CellList & other) = delete;
       //! Move constructor
-      IndexContainer(IndexContainer && other) = delete;
+      CellList(CellList && other) = delete;
       //! Destructor
-      ~IndexContainer() {}
+      ~CellList() = default;
       //! Copy assignment operator
-      IndexContainer & operator=(const IndexContainer & other) = delete;
+      CellList & operator=(const CellList & other) = delete;
       //! Move assignment operator
-      IndexContainer & operator=(IndexContainer && other) = default;
-      //! brackets operator
-      std::vector<int> & operator[](const std::array<int, Dim> & ccoord) {
-        auto index = get_index(this->nboxes, ccoord);
-        return data[index];
+      CellList & operator=(CellList && other) = delete;
+
+      /**
+       * Sort the atoms into the boxes.
+       *
+       * The atoms are split into one contiguous chunk per thread. Each chunk
+       * counts its atoms in every box, a prefix sum over the boxes and then
+       * over the chunks gives where each chunk writes its atoms in each box,
+       * so that the result does not depend on the number of threads.
+       *
+       * @param box_indices linear index of the box of each atom tag
+       * @param positions positions of the atoms, one column per atom tag
+       * @param n_threads number of threads, 0 means all the available
+       * hardware threads
+       */
+      void fill(const std::vector<int> & box_indices,
+                const Positions_t & positions, size_t n_threads = 1) {
+        size_t n_atoms{box_indices.size()};
+        size_t n_boxes{static_cast<size_t>(this->size())};
+        size_t n_chunks{utils::resolve_n_threads(n_threads, n_atoms)};
+        auto chunk_begin = [n_atoms, n_chunks](size_t i_chunk) {
+          return i_chunk * n_atoms / n_chunks;
+        };
+
+        // number of atoms of each chunk in each box
+        std::vector<int> entries(n_chunks * n_boxes, 0);
+        utils::parallel_for(
+            n_chunks, n_chunks, [&](size_t /*thread_id*/, size_t i_chunk) {
+              int * counts{entries.data() + i_chunk * n_boxes};
+              for (size_t atom_tag{chunk_begin(i_chunk)};
+                   atom_tag < chunk_begin(i_chunk + 1); ++atom_tag) {
+                ++counts[box_indices[atom_tag]];
+              }
+            });
+
+        // turn the counts into the first entry of each chunk in each box
+        int entry{0};
+        for (size_t i_box{0}; i_box < n_boxes; ++i_box) {
+          this->offsets[i_box] = entry;
+          for (size_t i_chunk{0}; i_chunk < n_chunks; ++i_chunk) {
+            int & chunk_entry{entries[i_chunk * n_boxes + i_box]};
+            int count{chunk_entry};
+            chunk_entry = entry;
+            entry += count;
+          }
+        }
+        this->offsets[n_boxes] = entry;
+
+        this->atom_tags.resize(n_atoms);
+        this->positions.resize(Dim, n_atoms);
+        utils::parallel_for(
+            n_chunks, n_chunks, [&](size_t /*thread_id*/, size_t i_chunk) {
+              int * next_entry{entries.data() + i_chunk * n_boxes};
+              for (size_t atom_tag{chunk_begin(i_chunk)};
+                   atom_tag < chunk_begin(i_chunk + 1); ++atom_tag) {
+                int entry{next_entry[box_indices[atom_tag]]++};
+                this->atom_tags[entry] = static_cast<int>(atom_tag);
+                this->positions.col(entry) = positions.col(atom_tag);
+              }
+            });
+      }
+
+      //! number of boxes
+      inline int size() const {
+        return static_cast<int>(this->offsets.size()) - 1;
       }
 
-      const std::vector<int> &
-      operator[](const std::array<int, Dim> & ccoord) const {
-        auto index = get_index(this->nboxes, ccoord);
-        return this->data[index];
+      //! linear index of the box at the given coordinates
+      inline int get_box_index(const std::array<int, Dim> & ccoord) const {
+        return get_index(this->nboxes, ccoord);
+      }
+
+      //! coordinates of the box with the given linear index
+      inline std::array<int, Dim> get_box_ccoord(int i_box) const {
+        return get_ccoord(this->nboxes, i_box);
+      }
+
+      //! first entry of a box
+      inline int begin(int i_box) const { return this->offsets[i_box]; }
+
+      //! one past the last entry of a box
+      inline int end(int i_box) const { return this->offsets[i_box + 1]; }
+
+      inline int get_atom_tag(int entry) const {
+        return this->atom_tags[entry];
+      }
+
+      inline decltype(auto) get_position(int entry) const {
+        return this->positions.col(entry);
       }
 
      protected:
-      //! a vector of atom tags for every box
-      std::vector<std::vector<int>> data{};
       //! number of boxes in each dimension
       std::array<int, Dim> nboxes{};
-
-     private:
+      //! first entry of every box, the last element is the number of atoms
+      std::vector<int> offsets{};
+      //! atom tags sorted by box
+      std::vector<int> atom_tags{};
+      //! positions of the atoms sorted by box
+      Positions_t positions{};
     };
   }  // namespace internal
 
@@ -438,8 +523,8 @@ namespace rascal {
     using AtomRef_t = typename ManagerImplementation::AtomRef_t;
     using Vector_ref = typename Parent::Vector_ref;
     using Vector_t = typename Parent::Vector_t;
-    using Positions_ref =
-        Eigen::Map<Eigen::Matrix<double, traits::Dim, Eigen::Dynamic>>;
+    using Positions_t = Eigen::Matrix<double, traits::Dim, Eigen::Dynamic>;
+    using Positions_ref = Eigen::Map<Positions_t>;
     using Hypers_t = typename Parent::Hypers_t;
     // using AtomTypes_ref = AtomicStructure<traits::Dim>::AtomTypes_ref;
 
@@ -463,7 +548,11 @@ namespace rascal {
         : AdaptorNeighbourList(
               manager, adaptor_hypers.at("cutoff").template get<double>(),
               optional_argument_ghost(adaptor_hypers),
-              optional_argument_skin(adaptor_hypers)) {}
+              optional_argument_skin(adaptor_hypers)) {
+      if (adaptor_hypers.find("n_threads") != adaptor_hypers.end()) {
+        this->n_threads = adaptor_hypers["n_threads"];
+      }
+    }
 
     //! Copy constructor
     AdaptorNeighbourList(const AdaptorNeighbourList & other) = delete;
@@ -498,6 +587,21 @@ namespace rascal {
       return skin;
     }
 
+    /**
+     * Set the number of threads used to build the list. The ghost atoms are
+     * generated serially, the sorting of the atoms into the boxes and the
+     * search of the pairs are split over the threads. The list is identical
+     * to the serial one.
+     *
+     * @param n_threads number of threads, 0 means all the available hardware
+     * threads and 1 (the default) the serial build.
+     */
+    inline void set_n_threads(size_t n_threads) {
+      this->n_threads = n_threads;
+    }
+
+    inline size_t get_n_threads() const { return this->n_threads; }
+
     /**
      * Updates just the adaptor assuming the underlying manager was
      * updated. this function invokes building either the neighbour list or to
@@ -604,6 +708,35 @@ namespace rascal {
       return this->ghost_types;
     }
 
+    /**
+     * Returns the atom tag of the atom in the cell of which the atom with
+     * index atom_tag is a periodic image (itself for the atoms of the cell)
+     */
+    inline int get_image_atom_tag(size_t atom_tag) const {
+      if (atom_tag < this->n_atoms) {
+        return static_cast<int>(atom_tag);
+      } else {
+        return this->ghost_image_atom_tags[atom_tag - this->n_atoms];
+      }
+    }
+
+    /**
+     * Returns the lattice translation, in units of the cell vectors, from the
+     * atom returned by get_image_atom_tag() to the atom with index atom_tag,
+     * i.e. the integer shift of the pairs in which it is the neighbour (zero
+     * for the atoms of the cell)
+     */
+    inline Eigen::Matrix<int, traits::Dim, 1>
+    get_lattice_shift(size_t atom_tag) const {
+      if (atom_tag < this->n_atoms) {
+        return Eigen::Matrix<int, traits::Dim, 1>::Zero();
+      } else {
+        return Eigen::Map<const Eigen::Matrix<int, traits::Dim, 1>>(
+            this->ghost_shifts.data() +
+            traits::Dim * (atom_tag - this->n_atoms));
+      }
+    }
+
     //! Returns position of the given atom object (useful for users)
     inline Vector_ref get_position(const AtomRef_t & atom) {
       return this->manager->get_position(atom.get_index());
@@ -679,7 +812,7 @@ namespace rascal {
 
     size_t get_n_update() const { return this->n_update; }
 
-    size_t get_skin2() const { return this->skin2; }
+    double get_skin2() const { return this->skin2; }
 
    protected:
     /* ---------------------------------------------------------------------- */
@@ -697,8 +830,10 @@ namespace rascal {
      * is needed, because ghost atoms are also included in the buildup of the
      * pair list.
      */
-    inline void add_ghost_atom(int atom_tag, const Vector_t & position,
-                               int atom_type) {
+    inline void
+    add_ghost_atom(int atom_tag, const Vector_t & position, int atom_type,
+                   int image_atom_tag,
+                   const Eigen::Ref<const Eigen::VectorXi> & shift) {
       // first add it to the list of atoms
       this->atom_tag_list.push_back(atom_tag);
       this->atom_types.push_back(atom_type);
@@ -708,9 +843,50 @@ namespace rascal {
       for (auto dim{0}; dim < traits::Dim; ++dim) {
         this->ghost_positions.push_back(position(dim));
       }
+      // keep track of its periodic image to be able to move it
+      this->ghost_image_atom_tags.push_back(image_atom_tag);
+      for (auto dim{0}; dim < traits::Dim; ++dim) {
+        this->ghost_shifts.push_back(shift(dim));
+      }
       this->n_ghosts++;
     }
 
+    /**
+     * Returns true if one of the atoms has moved by more than half the skin
+     * since the last build of the list, i.e. some pairs within the cutoff
+     * might be missing from the list.
+     */
+    inline bool has_moved_beyond_skin() {
+      if (static_cast<size_t>(this->positions_at_build.cols()) !=
+          this->manager->get_n_atoms()) {
+        return true;
+      }
+      // (skin / 2)**2
+      double threshold2{0.25 * this->skin2};
+      for (size_t atom_tag{0}; atom_tag < this->n_atoms; ++atom_tag) {
+        double displacement2{(this->manager->get_position(atom_tag) -
+                              this->positions_at_build.col(atom_tag))
+                                 .squaredNorm()};
+        if (displacement2 > threshold2) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //! Moves the ghost atoms along with the atoms they are an image of
+    inline void update_ghost_positions() {
+      auto && ghost_positions{this->get_ghost_positions()};
+      auto && cell{this->manager->get_cell()};
+      Eigen::Map<const Eigen::Matrix<int, traits::Dim, Eigen::Dynamic>> shifts(
+          this->ghost_shifts.data(), traits::Dim, this->n_ghosts);
+      for (size_t i_ghost{0}; i_ghost < this->n_ghosts; ++i_ghost) {
+        ghost_positions.col(i_ghost) =
+            this->manager->get_position(this->ghost_image_atom_tags[i_ghost]) +
+            cell * shifts.col(i_ghost).template cast<double>();
+      }
+    }
+
     //! Extends the list containing the number of neighbours with a 0
     inline void add_entry_number_of_neighbours() {
       this->nb_neigh.push_back(0);
@@ -732,6 +908,24 @@ namespace rascal {
     //! full neighbour list with linked cell algorithm
     void make_full_neighbour_list();
 
+    /**
+     * full neighbour list of a small cell, comparing the periodic images of
+     * every atom with every center
+     */
+    void make_neighbour_list_from_images(
+        const std::array<int, traits::Dim> & periodic_min,
+        const std::array<int, traits::Dim> & repetitions, size_t n_images,
+        double cutoff);
+
+    /**
+     * Stores the neighbours given as (center index, neighbour atom tag) pairs
+     * found in any order, possibly split into several lists (e.g. one per
+     * thread).
+     */
+    void set_neighbours(
+        const std::vector<std::vector<std::pair<int, int>>> & pair_lists,
+        size_t n_centers_with_ghosts);
+
     /* ---------------------------------------------------------------------- */
     //! pointer to underlying structure manager
     ImplementationPtr_t manager;
@@ -739,10 +933,12 @@ namespace rascal {
     //! Cutoff radius for neighbour list
     const double cutoff;
     /**
-     * If no atom has moved more than the skin-distance since the
-     * last call to the update method, then the linked cell neighbor list can
-     * be reused. This will save some expensive rebuilds of the list, but
-     * extra neighbors outside the cutoff will be considered.
+     * The list is built with a cutoff of cutoff + skin. As long as no atom
+     * has moved by more than half the skin since the last build, it still
+     * contains all the pairs within the cutoff and it is reused: only the
+     * ghost positions are moved along. This saves expensive rebuilds of the
+     * list, but extra neighbours outside the cutoff will be considered, the
+     * strict filtering is left to AdaptorStrict.
      *
      * use squared skin to avoid computing the sqrt of the squared norm
      * between the two .
@@ -795,7 +991,9 @@ namespace rascal {
 
     /**
      * on top of the main update signal, the skin parameter allow to skip
-     * the update. So this variable records this possiblity.
+     * the update. This variable records whether the structure has changed in
+     * another way than by the displacement of the atoms (cell, atom types...)
+     * in which case the list has to be rebuilt anyway.
      */
     bool need_update{true};
 
@@ -805,9 +1003,24 @@ namespace rascal {
     //! ghost atom type
     std::vector<int> ghost_types{};
 
+    //! atom tag of the atom in the cell of which a ghost atom is an image
+    std::vector<int> ghost_image_atom_tags{};
+
+    /**
+     * lattice translation from the atom in the cell to the ghost atom, in
+     * units of the cell vectors
+     */
+    std::vector<int> ghost_shifts{};
+
+    //! positions of the atoms in the cell at the last build of the list
+    Positions_t positions_at_build{};
+
     //! whether or not to consider neighbours of ghost atoms
     const bool consider_ghost_neighbours;
 
+    //! number of threads used to build the list, see set_n_threads()
+    size_t n_threads{1};
+
    private:
   };
 
@@ -837,9 +1050,12 @@ namespace rascal {
       // TODO(felix) should not have to assume that the underlying manager is
       // manager centers.
       auto && atomic_structure{this->manager->get_atomic_structure()};
-      // if the structure has not changed by more than skin**2
-      if (not atomic_structure.is_similar(std::forward<Args>(arguments)...,
-                                          this->skin2)) {
+      // only the changes other than the atomic displacements (cell, types,
+      // number of atoms...) are looked at here, the displacements are
+      // compared to the positions of the last build in update_self
+      if (not atomic_structure.is_similar(
+              std::forward<Args>(arguments)...,
+              std::numeric_limits<double>::infinity())) {
         this->need_update = true;
       } else {
         this->need_update = false;
@@ -855,7 +1071,7 @@ namespace rascal {
    */
   template <class ManagerImplementation>
   void AdaptorNeighbourList<ManagerImplementation>::update_self() {
-    if (this->need_update) {
+    if (this->need_update or this->has_moved_beyond_skin()) {
       // set the number of centers
       this->n_centers = this->manager->get_size();
       this->n_atoms = this->manager->get_n_atoms();
@@ -873,6 +1089,8 @@ namespace rascal {
       this->offsets.clear();
       this->ghost_positions.clear();
       this->ghost_types.clear();
+      this->ghost_image_atom_tags.clear();
+      this->ghost_shifts.clear();
       this->atom_index_from_atom_tag_list.clear();
       // actual call for building the neighbour list
       this->make_full_neighbour_list();
@@ -885,7 +1103,17 @@ namespace rascal {
 
       atom_cluster_indices.fill_sequence(this->consider_ghost_neighbours);
       pair_cluster_indices.fill_sequence();
+
+      // reference positions to decide when the list has to be rebuilt
+      this->positions_at_build.resize(traits::Dim, this->n_atoms);
+      for (size_t atom_tag{0}; atom_tag < this->n_atoms; ++atom_tag) {
+        this->positions_at_build.col(atom_tag) =
+            this->manager->get_position(atom_tag);
+      }
       ++this->n_update;
+    } else {
+      // the list is still valid, the ghosts follow the atoms of the cell
+      this->update_ghost_positions();
     }
   }
 
@@ -894,15 +1122,17 @@ namespace rascal {
    * Builds full neighbour list. Triclinicity is accounted for. The general idea
    * is to anchor a mesh at the origin of the supplied cell (assuming it is at
    * the origin). Then the mesh is extended into space until it is as big as the
-   * maximum cell coordinate plus one cutoff in each direction. This mesh has
-   * boxes of size ``cutoff``. Depending on the periodicity of the mesh, ghost
-   * atoms are added by shifting all i-atoms by the cell vectors corresponding
-   * to the desired periodicity. All i-atoms and the ghost atoms are then sorted
-   * into the respective boxes of the cartesian mesh and a stencil anchored at
-   * the box of the i-atoms is used to build the atom neighbourhoods from the 9
-   * (2d) or 27 (3d) boxes, which is checked for the neighbourhood. Correct
-   * periodicity is ensured by the placement of the ghost atoms. The resulting
-   * neighbourlist is full and not strict.
+   * maximum cell coordinate plus one cutoff + skin in each direction. This
+   * mesh has boxes of size ``cutoff + skin``. Depending on the periodicity of
+   * the mesh, ghost atoms are added by shifting all i-atoms by the cell vectors
+   * corresponding to the desired periodicity. All i-atoms and the ghost atoms
+   * are then sorted into the respective boxes of the cartesian mesh, stored as
+   * a CellList, and a stencil anchored at each box is used to find the pairs
+   * of atoms within the 9 (2d) or 27 (3d) surrounding boxes. Only half of the
+   * stencil is visited so that the distance of every pair is computed once.
+   * Correct periodicity is ensured by the placement of the ghost atoms. The
+   * resulting neighbourlist is full and strict with respect to cutoff + skin,
+   * the neighbours of each center being sorted by atom tag.
    */
   template <class ManagerImplementation>
   void AdaptorNeighbourList<ManagerImplementation>::make_full_neighbour_list() {
@@ -912,7 +1142,9 @@ namespace rascal {
     constexpr auto dim{traits::Dim};
 
     auto cell{this->manager->get_cell()};
-    double cutoff{this->cutoff};
+    // the list is built with cutoff + skin so that it stays valid as long as
+    // the atoms have moved by less than half the skin
+    double cutoff{this->cutoff + std::sqrt(this->skin2)};
 
     std::array<int, dim> nboxes_per_dim{};
 
@@ -1028,6 +1260,48 @@ namespace rascal {
       this->atom_index_from_atom_tag_list.push_back(cluster_index);
     }
 
+    // For a cell that is small compared to the cutoff, most of the periodic
+    // images are far from the cell and turning all the images of the mesh
+    // into ghost atoms costs more than comparing the images of every atom
+    // directly with every center, which takes n_centers * n_images distances.
+    // The cell list visits every image and every box, creates the ghosts, at
+    // about the cost of a hundred distances each, and compares every center
+    // with the atoms of the n_stencil boxes around it. Only the images that
+    // are neighbours of a center are then added as ghost atoms. Ghost atoms
+    // need the full treatment when they are centers themselves.
+    size_t n_boxes{1};
+    for (auto i{0}; i < dim; ++i) {
+      n_boxes *= nboxes_per_dim[i];
+    }
+    if (not this->consider_ghost_neighbours) {
+      size_t n_mesh_ghosts{0};
+      for (size_t atom_tag{0}; atom_tag < this->n_atoms; ++atom_tag) {
+        auto pos = this->manager->get_position(atom_tag);
+        for (auto && p_image :
+             internal::PeriodicImages<dim>{periodic_min, repetitions, ntot}) {
+          if (not(p_image.array() == 0).all()) {
+            Vector_t pos_ghost{pos + cell * p_image.template cast<double>()};
+            if (internal::position_in_bounds(ghost_min, ghost_max,
+                                             pos_ghost)) {
+              ++n_mesh_ghosts;
+            }
+          }
+        }
+      }
+      size_t n_images{this->n_atoms * ntot};
+      constexpr size_t n_stencil{internal::ipow(3, dim)};
+      constexpr size_t ghost_cost{100};
+      size_t images_work{this->n_centers * n_images};
+      size_t cell_list_work{n_images + n_boxes + ghost_cost * n_mesh_ghosts +
+                            n_stencil * this->n_centers *
+                                (this->n_atoms + n_mesh_ghosts) / n_boxes};
+      if (images_work < cell_list_work) {
+        this->make_neighbour_list_from_images(periodic_min, repetitions, ntot,
+                                              cutoff);
+        return;
+      }
+    }
+
     // generate ghost atom tags and positions
     for (size_t atom_tag{0}; atom_tag < this->n_atoms; ++atom_tag) {
       auto pos = this->manager->get_position(atom_tag);
@@ -1044,7 +1318,8 @@ namespace rascal {
           if (flag_inside) {
             // next atom tag is size, since start is at index = 0
             auto new_atom_tag{this->n_atoms + this->n_ghosts};
-            this->add_ghost_atom(new_atom_tag, pos_ghost, atom_type);
+            this->add_ghost_atom(new_atom_tag, pos_ghost, atom_type,
+                                 atom_tag, p_image);
             // adds origin atom cluster_index if true
             // adds ghost atom cluster index if false
             size_t cluster_index = this->manager->get_atom_index(atom_tag);
@@ -1054,38 +1329,256 @@ namespace rascal {
       }
     }
 
-    // neighbour boxes
-    internal::IndexContainer<dim> atom_id_cell{nboxes_per_dim};
-
     // sorting the atoms and ghosts inside the cell into boxes
     auto n_potential_neighbours{this->n_atoms + this->n_ghosts};
-    for (size_t atom_tag{0}; atom_tag < n_potential_neighbours; ++atom_tag) {
-      auto pos = this->get_position(atom_tag);
-      Vector_t dpos = pos - mesh_min;
-      auto idx = internal::get_box_index(dpos, cutoff);
-      atom_id_cell[idx].push_back(atom_tag);
+    std::vector<int> box_indices(n_potential_neighbours);
+    typename internal::CellList<dim>::Positions_t positions(
+        dim, n_potential_neighbours);
+    size_t n_chunks{
+        utils::resolve_n_threads(this->n_threads, n_potential_neighbours)};
+    utils::parallel_for(
+        n_chunks, n_chunks, [&](size_t /*thread_id*/, size_t i_chunk) {
+          for (size_t atom_tag{i_chunk * n_potential_neighbours / n_chunks};
+               atom_tag < (i_chunk + 1) * n_potential_neighbours / n_chunks;
+               ++atom_tag) {
+            auto pos = this->get_position(atom_tag);
+            positions.col(atom_tag) = pos;
+            Vector_t dpos = pos - mesh_min;
+            auto idx = internal::get_box_index(dpos, cutoff);
+            box_indices[atom_tag] = internal::get_index(nboxes_per_dim, idx);
+          }
+        });
+    internal::CellList<dim> cell_list{nboxes_per_dim};
+    cell_list.fill(box_indices, positions, this->n_threads);
+
+    // index of the atoms and/or ghosts in the list of centers (-1 if it is
+    // not a center), depending on the runtime decision flag
+    size_t n_centers_with_ghosts{this->get_size_with_ghosts()};
+    std::vector<int> center_indices(n_potential_neighbours, -1);
+    for (size_t i_center{0}; i_center < n_centers_with_ghosts; ++i_center) {
+      center_indices[this->atom_tag_list[i_center]] =
+          static_cast<int>(i_center);
     }
 
-    // go through all atoms and/or ghosts to build neighbour list, depending on
-    // the runtime decision flag
-    std::vector<int> current_j_atoms{};
-    for (auto center : this->get_manager().with_ghosts()) {
-      int atom_tag = center.get_atom_tag();
-      int nneigh{0};
-
-      Vector_t pos = center.get_position();
-      Vector_t dpos = pos - mesh_min;
-      auto box_index = internal::get_box_index(dpos, cutoff);
-      internal::fill_neighbours_atom_tag(atom_tag, box_index, atom_id_cell,
-                                         current_j_atoms);
-
-      nneigh += current_j_atoms.size();
-      for (auto & j_atom_tag : current_j_atoms) {
-        this->neighbours_atom_tag.push_back(j_atom_tag);
+    // the list is strict up to cutoff + skin
+    double cutoff2{cutoff * cutoff};
+
+    // pairs of (center index, neighbour atom tag) in order of discovery, the
+    // boxes are split into contiguous blocks handed out to the threads, each
+    // block having its own list of pairs
+    size_t n_blocks{std::min(n_boxes, 8 * utils::resolve_n_threads(
+                                              this->n_threads, n_boxes))};
+    std::vector<std::vector<std::pair<int, int>>> pair_lists(n_blocks);
+    auto add_pair = [&](std::vector<std::pair<int, int>> & pairs, int entry_i,
+                        int entry_j) {
+      int atom_tag_i{cell_list.get_atom_tag(entry_i)};
+      int atom_tag_j{cell_list.get_atom_tag(entry_j)};
+      int center_i{center_indices[atom_tag_i]};
+      int center_j{center_indices[atom_tag_j]};
+      if (center_i < 0 and center_j < 0) {
+        return;
+      }
+      double distance2{(cell_list.get_position(entry_i) -
+                        cell_list.get_position(entry_j))
+                           .squaredNorm()};
+      if (distance2 > cutoff2) {
+        return;
+      }
+      if (center_i >= 0) {
+        pairs.emplace_back(center_i, atom_tag_j);
       }
+      if (center_j >= 0) {
+        pairs.emplace_back(center_j, atom_tag_i);
+      }
+    };
+
+    // each pair of atoms is visited once: the atoms of a box are paired with
+    // the following atoms of the same box and with the atoms of the boxes of
+    // the upper half of the stencil, the other half being covered from the
+    // neighbouring boxes
+    constexpr int stencil_center{internal::ipow(3, dim) / 2};
+    auto find_pairs = [&](size_t /*thread_id*/, size_t i_block) {
+      auto & pairs{pair_lists[i_block]};
+      int block_begin{static_cast<int>(i_block * n_boxes / n_blocks)};
+      int block_end{static_cast<int>((i_block + 1) * n_boxes / n_blocks)};
+      for (int i_box{block_begin}; i_box < block_end; ++i_box) {
+        int begin_i{cell_list.begin(i_box)};
+        int end_i{cell_list.end(i_box)};
+        if (begin_i == end_i) {
+          continue;
+        }
+        for (int entry_i{begin_i}; entry_i < end_i; ++entry_i) {
+          for (int entry_j{entry_i + 1}; entry_j < end_i; ++entry_j) {
+            add_pair(pairs, entry_i, entry_j);
+          }
+        }
+        int i_stencil{0};
+        for (auto && ccoord :
+             internal::Stencil<dim>{cell_list.get_box_ccoord(i_box)}) {
+          if (i_stencil++ <= stencil_center) {
+            continue;
+          }
+          int j_box{cell_list.get_box_index(ccoord)};
+          int begin_j{cell_list.begin(j_box)};
+          int end_j{cell_list.end(j_box)};
+          for (int entry_i{begin_i}; entry_i < end_i; ++entry_i) {
+            for (int entry_j{begin_j}; entry_j < end_j; ++entry_j) {
+              add_pair(pairs, entry_i, entry_j);
+            }
+          }
+        }
+      }
+    };
+    utils::parallel_for(n_blocks, this->n_threads, find_pairs);
+
+    this->set_neighbours(pair_lists, n_centers_with_ghosts);
+  }
 
-      this->nb_neigh.push_back(nneigh);
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Builds the full neighbour list by comparing every periodic image of every
+   * atom of the cell with every center. The images within cutoff + skin of at
+   * least one center are added as ghost atoms, so that the number of ghosts
+   * is bounded by the number of pairs rather than by the number of images
+   * needed to cover the mesh. Each ghost keeps the integer lattice shift
+   * relating it to its atom in the cell (see get_lattice_shift()). The
+   * centers are split over n_threads threads.
+   *
+   * The ghost atoms have no neighbours, i.e. consider_ghost_neighbours has to
+   * be false.
+   */
+  template <class ManagerImplementation>
+  void AdaptorNeighbourList<ManagerImplementation>::
+      make_neighbour_list_from_images(
+          const std::array<int, traits::Dim> & periodic_min,
+          const std::array<int, traits::Dim> & repetitions, size_t n_images,
+          double cutoff) {
+    using Vector_t = Eigen::Matrix<double, traits::Dim, 1>;
+    constexpr auto dim{traits::Dim};
+
+    auto cell{this->manager->get_cell()};
+    double cutoff2{cutoff * cutoff};
+
+    Positions_t center_positions(dim, this->n_centers);
+    for (size_t i_center{0}; i_center < this->n_centers; ++i_center) {
+      center_positions.col(i_center) =
+          this->manager->get_position(this->atom_tag_list[i_center]);
+    }
+    std::vector<Eigen::Matrix<int, dim, 1>> shifts{};
+    for (auto && p_image :
+         internal::PeriodicImages<dim>{periodic_min, repetitions, n_images}) {
+      shifts.push_back(p_image);
+    }
+
+    // the centers are split into contiguous chunks handed out to the threads,
+    // each chunk collecting the (image, center index) of its neighbours, with
+    // the images numbered atom_tag * n_images + i_image
+    size_t n_chunks{utils::resolve_n_threads(this->n_threads, this->n_centers)};
+    std::vector<std::vector<std::pair<size_t, int>>> chunk_neighbours(
+        n_chunks);
+    auto find_neighbours = [&](size_t /*thread_id*/, size_t i_chunk) {
+      size_t begin{i_chunk * this->n_centers / n_chunks};
+      size_t end{(i_chunk + 1) * this->n_centers / n_chunks};
+      auto & neighbours{chunk_neighbours[i_chunk]};
+      for (size_t atom_tag{0}; atom_tag < this->n_atoms; ++atom_tag) {
+        Vector_t pos = this->manager->get_position(atom_tag);
+        for (size_t i_image{0}; i_image < n_images; ++i_image) {
+          bool is_ghost{not(shifts[i_image].array() == 0).all()};
+          Vector_t pos_image{pos +
+                             cell * shifts[i_image].template cast<double>()};
+          for (size_t i_center{begin}; i_center < end; ++i_center) {
+            if (not is_ghost and this->atom_tag_list[i_center] ==
+                                     static_cast<int>(atom_tag)) {
+              continue;
+            }
+            double distance2{
+                (pos_image - center_positions.col(i_center)).squaredNorm()};
+            if (distance2 <= cutoff2) {
+              neighbours.emplace_back(atom_tag * n_images + i_image,
+                                      static_cast<int>(i_center));
+            }
+          }
+        }
+      }
+    };
+    utils::parallel_for(n_chunks, n_chunks, find_neighbours);
+
+    // the ghost atoms are created in the order of the images, independently
+    // of the number of threads
+    std::vector<std::pair<size_t, int>> neighbours{};
+    for (auto & chunk : chunk_neighbours) {
+      neighbours.insert(neighbours.end(), chunk.begin(), chunk.end());
+      chunk = {};
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+
+    // pairs of (center index, neighbour atom tag)
+    std::vector<std::vector<std::pair<int, int>>> pair_lists(1);
+    auto & pairs{pair_lists.front()};
+    pairs.reserve(neighbours.size());
+    int neighbour_tag{-1};
+    for (size_t i_neighbour{0}; i_neighbour < neighbours.size();
+         ++i_neighbour) {
+      auto image{neighbours[i_neighbour].first};
+      if (i_neighbour == 0 or image != neighbours[i_neighbour - 1].first) {
+        size_t atom_tag{image / n_images};
+        auto && p_image{shifts[image % n_images]};
+        if ((p_image.array() == 0).all()) {
+          neighbour_tag = static_cast<int>(atom_tag);
+        } else {
+          neighbour_tag = static_cast<int>(this->n_atoms + this->n_ghosts);
+          Vector_t pos_image{this->manager->get_position(atom_tag) +
+                             cell * p_image.template cast<double>()};
+          this->add_ghost_atom(neighbour_tag, pos_image,
+                               this->manager->get_atom_type(atom_tag),
+                               atom_tag, p_image);
+          size_t cluster_index = this->manager->get_atom_index(atom_tag);
+          this->atom_index_from_atom_tag_list.push_back(cluster_index);
+        }
+      }
+      pairs.emplace_back(neighbours[i_neighbour].second, neighbour_tag);
+    }
+
+    this->set_neighbours(pair_lists, this->n_centers);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Gathers the neighbours of each center contiguously in
+   * neighbours_atom_tag, sorted by atom tag so that the list depends neither
+   * on the order in which the pairs were found nor on the number of threads.
+   */
+  template <class ManagerImplementation>
+  void AdaptorNeighbourList<ManagerImplementation>::set_neighbours(
+      const std::vector<std::vector<std::pair<int, int>>> & pair_lists,
+      size_t n_centers_with_ghosts) {
+    this->nb_neigh.assign(n_centers_with_ghosts, 0);
+    size_t n_pairs{0};
+    for (const auto & pairs : pair_lists) {
+      for (const auto & pair : pairs) {
+        ++this->nb_neigh[pair.first];
+      }
+      n_pairs += pairs.size();
+    }
+    std::vector<size_t> next_neighbour(n_centers_with_ghosts + 1, 0);
+    for (size_t i_center{0}; i_center < n_centers_with_ghosts; ++i_center) {
+      next_neighbour[i_center + 1] =
+          next_neighbour[i_center] + this->nb_neigh[i_center];
+    }
+    std::vector<size_t> neighbours_begin(next_neighbour);
+    this->neighbours_atom_tag.resize(n_pairs);
+    for (const auto & pairs : pair_lists) {
+      for (const auto & pair : pairs) {
+        this->neighbours_atom_tag[next_neighbour[pair.first]++] = pair.second;
+      }
     }
+    auto neighbours{this->neighbours_atom_tag.begin()};
+    utils::parallel_for(n_centers_with_ghosts, this->n_threads,
+                        [&](size_t /*thread_id*/, size_t i_center) {
+                          std::sort(
+                              neighbours + neighbours_begin[i_center],
+                              neighbours + neighbours_begin[i_center + 1]);
+                        });
   }
 
   /* ---------------------------------------------------------------------- */
@@ -35,6 +35,7 @@
 #include "structure_managers/property.hh"
 #include "structure_managers/updateable_base.hh"
 #include "rascal_utility.hh"
+#include "utils/parallel_for.hh"
 
 namespace rascal {
   /*
@@ -109,7 +110,11 @@ namespace rascal {
 
     AdaptorStrict(ImplementationPtr_t manager, const Hypers_t & adaptor_hypers)
         : AdaptorStrict(manager,
-                        adaptor_hypers.at("cutoff").template get<double>()) {}
+                        adaptor_hypers.at("cutoff").template get<double>()) {
+      if (adaptor_hypers.find("n_threads") != adaptor_hypers.end()) {
+        this->n_threads = adaptor_hypers["n_threads"];
+      }
+    }
 
     //! Copy constructor
     AdaptorStrict(const AdaptorStrict & other) = delete;
@@ -136,6 +141,20 @@ namespace rascal {
     //! returns the (strict) cutoff for the adaptor
     inline double get_cutoff() const { return this->cutoff; }
 
+    /**
+     * Set the number of threads used to filter the pairs and compute their
+     * distances and directions. The pairs are stored in the same order as in
+     * the serial update.
+     *
+     * @param n_threads number of threads, 0 means all the available hardware
+     * threads and 1 (the default) the serial update.
+     */
+    inline void set_n_threads(size_t n_threads) {
+      this->n_threads = n_threads;
+    }
+
+    inline size_t get_n_threads() const { return this->n_threads; }
+
     inline size_t get_nb_clusters(int order) const {
       assert(order > 0);
       return this->atom_tag_list[order - 1].size();
@@ -257,6 +276,24 @@ namespace rascal {
       return this->dir_vec->operator[](pair);
     }
 
+    /**
+     * returns the distances of all the pairs as a contiguous array indexed by
+     * the pair cluster index of this adaptor, i.e. the neighbours of a center
+     * are stored one after the other
+     */
+    inline Eigen::Map<const Eigen::ArrayXd> get_distances() const {
+      return Eigen::Map<const Eigen::ArrayXd>(this->distance->data(),
+                                              this->distance->size());
+    }
+
+    //! returns the direction vectors of all the pairs, one column per pair
+    inline Eigen::Map<const Eigen::Matrix<double, traits::Dim, Eigen::Dynamic>>
+    get_direction_vectors() const {
+      return Eigen::Map<
+          const Eigen::Matrix<double, traits::Dim, Eigen::Dynamic>>(
+          this->dir_vec->data(), traits::Dim, this->dir_vec->size());
+    }
+
     inline bool get_consider_ghost_neighbours() const {
       return this->manager->get_consider_ghost_neighbours();
     }
@@ -302,6 +339,9 @@ namespace rascal {
       this->template add_atom<Order - 1>(cluster.back());
     }
 
+    //! multithreaded filtering of the pairs, only for pair lists
+    void filter_pairs_in_parallel();
+
     ImplementationPtr_t manager;
     std::shared_ptr<Distance_t> distance;
     std::shared_ptr<DirectionVector_t> dir_vec;
@@ -326,6 +366,9 @@ namespace rascal {
      */
     std::array<std::vector<size_t>, traits::MaxOrder> offsets;
 
+    //! number of threads used by update_self(), see set_n_threads()
+    size_t n_threads{1};
+
    private:
   };
 
@@ -409,6 +452,22 @@ namespace rascal {
     this->distance->clear();
     this->dir_vec->clear();
 
+    size_t n_threads{utils::resolve_n_threads(
+        this->n_threads, this->manager->size_with_ghosts())};
+    if (traits::MaxOrder == 2 and n_threads > 1) {
+      this->filter_pairs_in_parallel();
+      this->distance->set_updated_status(true);
+      this->dir_vec->set_updated_status(true);
+      return;
+    }
+
+    // the pairs of the underlying manager bound the size of the pair storage
+    // so the single pass below does not reallocate
+    size_t max_nb_pairs{this->manager->get_nb_clusters(2)};
+    this->atom_tag_list[1].reserve(max_nb_pairs);
+    this->distance->reserve(max_nb_pairs);
+    this->dir_vec->reserve(max_nb_pairs);
+
     // fill the list, at least pairs are mandatory for this to work
     auto & atom_cluster_indices{std::get<0>(this->cluster_indices_container)};
     auto & pair_cluster_indices{std::get<1>(this->cluster_indices_container)};
@@ -430,18 +489,20 @@ namespace rascal {
       indices.template head<AtomLayer>() = atom.get_cluster_indices();
       indices(AtomLayer) = indices(AtomLayer - 1);
       atom_cluster_indices.push_back(indices);
+      Eigen::Matrix<double, traits::Dim, 1> position_i{atom.get_position()};
+      // the distance and direction of each pair within the cutoff are
+      // computed once and written to the contiguous pair storage
       for (auto pair : atom.with_self_pair()) {
-        auto vec_ij{pair.get_position() - atom.get_position()};
-        double distance2{(vec_ij).squaredNorm()};
+        Eigen::Matrix<double, traits::Dim, 1> vec_ij{pair.get_position() -
+                                                     position_i};
+        double distance2{vec_ij.squaredNorm()};
         if (distance2 <= rc2) {
           this->add_atom(pair);
           double distance{std::sqrt(distance2)};
           if (distance2 > 0.) {
-            this->dir_vec->push_back((vec_ij.array() / distance).matrix());
-          } else {
-            this->dir_vec->push_back((vec_ij.array()).matrix());
+            vec_ij /= distance;
           }
-
+          this->dir_vec->push_back(vec_ij);
           this->distance->push_back(distance);
 
           Eigen::Matrix<size_t, PairLayer + 1, 1> indices_pair;
@@ -456,6 +517,88 @@ namespace rascal {
     this->distance->set_updated_status(true);
     this->dir_vec->set_updated_status(true);
   }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Same filtering as the serial loop of update_self() in three steps: the
+   * pairs within the cutoff are counted for every center in parallel, a
+   * prefix sum gives the position of the pairs of every center in the
+   * contiguous pair storage and then every center writes its pairs, their
+   * distances and directions in parallel.
+   */
+  template <class ManagerImplementation>
+  void AdaptorStrict<ManagerImplementation>::filter_pairs_in_parallel() {
+    using Vector_t = Eigen::Matrix<double, traits::Dim, 1>;
+    auto & atom_cluster_indices{std::get<0>(this->cluster_indices_container)};
+    auto & pair_cluster_indices{std::get<1>(this->cluster_indices_container)};
+    size_t n_centers{this->manager->size_with_ghosts()};
+    double rc2{this->cutoff * this->cutoff};
+
+    std::vector<size_t> pair_offsets(n_centers + 1, 0);
+    utils::parallel_for(
+        n_centers, this->n_threads, [&](size_t /*thread_id*/, size_t i_center) {
+          auto atom_it{this->manager->get_iterator_at(i_center)};
+          auto atom{*atom_it};
+          Vector_t position_i{atom.get_position()};
+          size_t n_pairs{0};
+          for (auto pair : atom.with_self_pair()) {
+            if ((pair.get_position() - position_i).squaredNorm() <= rc2) {
+              ++n_pairs;
+            }
+          }
+          pair_offsets[i_center + 1] = n_pairs;
+        });
+
+    for (size_t i_center{0}; i_center < n_centers; ++i_center) {
+      this->nb_neigh[1].push_back(pair_offsets[i_center + 1]);
+      pair_offsets[i_center + 1] += pair_offsets[i_center];
+    }
+    this->offsets[1] = pair_offsets;
+
+    for (auto atom : this->manager.get()->with_ghosts()) {
+      this->atom_tag_list[0].push_back(atom.back());
+      Eigen::Matrix<size_t, AtomLayer + 1, 1> indices;
+      indices.template head<AtomLayer>() = atom.get_cluster_indices();
+      indices(AtomLayer) = indices(AtomLayer - 1);
+      atom_cluster_indices.push_back(indices);
+    }
+    this->nb_neigh[0].back() = n_centers;
+    this->offsets[0].back() = n_centers;
+
+    // the pair storage is sized from the number of pairs of the adaptor
+    this->atom_tag_list[1].resize(pair_offsets.back());
+    this->distance->resize();
+    this->dir_vec->resize();
+    pair_cluster_indices.resize();
+
+    utils::parallel_for(
+        n_centers, this->n_threads, [&](size_t /*thread_id*/, size_t i_center) {
+          auto atom_it{this->manager->get_iterator_at(i_center)};
+          auto atom{*atom_it};
+          Vector_t position_i{atom.get_position()};
+          size_t i_pair{pair_offsets[i_center]};
+          for (auto pair : atom.with_self_pair()) {
+            Vector_t vec_ij{pair.get_position() - position_i};
+            double distance2{vec_ij.squaredNorm()};
+            if (distance2 <= rc2) {
+              this->atom_tag_list[1][i_pair] = pair.back();
+              double distance{std::sqrt(distance2)};
+              if (distance2 > 0.) {
+                vec_ij /= distance;
+              }
+              (*this->dir_vec)[i_pair] = vec_ij;
+              (*this->distance)[i_pair] = distance;
+
+              Eigen::Matrix<size_t, PairLayer + 1, 1> indices_pair;
+              indices_pair.template head<PairLayer>() =
+                  pair.get_cluster_indices();
+              indices_pair(PairLayer) = i_pair;
+              pair_cluster_indices[i_pair] = indices_pair;
+              ++i_pair;
+            }
+          }
+        });
+  }
 }  // namespace rascal
 
 #endif  // SRC_STRUCTURE_MANAGERS_ADAPTOR_STRICT_HH_
@@ -39,7 +39,13 @@
 #include <map>
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace rascal {
   namespace internal {
@@ -98,27 +104,193 @@ namespace rascal {
       inline const Key_t & get_key() const { return data; }
     };
 
+    /**
+     * Associative container offering the subset of the std::map interface
+     * used by InternallySortedKeyMap. The elements are stored contiguously
+     * and sorted by key so lookups are binary searches that neither
+     * allocate nor chase tree nodes. Insertions are linear in the number of
+     * elements, which is fine since the keys are set once by resize().
+     */
+    template <class K, class T>
+    class SortedFlatMap {
+     public:
+      using key_type = K;
+      using mapped_type = T;
+      using value_type = std::pair<K, T>;
+      using Container_t = std::vector<value_type>;
+      using size_type = typename Container_t::size_type;
+      using iterator = typename Container_t::iterator;
+      using const_iterator = typename Container_t::const_iterator;
+
+      iterator begin() noexcept { return this->elements.begin(); }
+      iterator end() noexcept { return this->elements.end(); }
+      const_iterator begin() const noexcept { return this->elements.begin(); }
+      const_iterator end() const noexcept { return this->elements.end(); }
+
+      size_type size() const noexcept { return this->elements.size(); }
+      bool empty() const noexcept { return this->elements.empty(); }
+      void clear() noexcept { this->elements.clear(); }
+
+      iterator find(const key_type & key) {
+        auto it{this->lower_bound(key)};
+        if (it != this->end() and it->first == key) {
+          return it;
+        }
+        return this->end();
+      }
+
+      const_iterator find(const key_type & key) const {
+        auto it{this->lower_bound(key)};
+        if (it != this->end() and it->first == key) {
+          return it;
+        }
+        return this->end();
+      }
+
+      size_type count(const key_type & key) const {
+        return (this->find(key) != this->end()) ? 1 : 0;
+      }
+
+      mapped_type & at(const key_type & key) {
+        auto it{this->find(key)};
+        if (it == this->end()) {
+          throw std::out_of_range("SortedFlatMap::at: key not found");
+        }
+        return it->second;
+      }
+
+      const mapped_type & at(const key_type & key) const {
+        auto it{this->find(key)};
+        if (it == this->end()) {
+          throw std::out_of_range("SortedFlatMap::at: key not found");
+        }
+        return it->second;
+      }
+
+      //! access or insert specified element
+      mapped_type & operator[](const key_type & key) {
+        auto it{this->lower_bound(key)};
+        if (it == this->end() or it->first != key) {
+          it = this->elements.emplace(it, key, mapped_type{});
+        }
+        return it->second;
+      }
+
+      //! first element whose key is not less than key
+      iterator lower_bound(const key_type & key) {
+        return std::lower_bound(this->begin(), this->end(), key,
+                                CompareKey());
+      }
+
+      const_iterator lower_bound(const key_type & key) const {
+        return std::lower_bound(this->begin(), this->end(), key,
+                                CompareKey());
+      }
+
+     protected:
+      struct CompareKey {
+        bool operator()(const value_type & element,
+                        const key_type & key) const {
+          return element.first < key;
+        }
+      };
+
+      Container_t elements{};
+    };
+
+    /**
+     * Storage shared by the InternallySortedKeyMap of a BlockSparseProperty
+     * so that the blocks of all its entries live in a few large buffers
+     * instead of one heap allocation per entry.
+     *
+     * The memory is handed out from a list of pages that are kept by
+     * reset(), so filling the property again with the same layout, e.g. at
+     * the next step of a MD trajectory, does not allocate. Pages are never
+     * reallocated so the pointers handed out stay valid until the next
+     * reset(), and allocate() can be called from several threads.
+     */
+    template <typename Precision_t>
+    class BlockArena {
+     public:
+      //! default number of elements of a page
+      static constexpr size_t PageSize{1 << 16};
+
+      //! contiguous memory for size elements
+      Precision_t * allocate(size_t size) {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        for (; this->current_page < this->pages.size(); ++this->current_page) {
+          auto & page{this->pages[this->current_page]};
+          if (page.used + size <= page.data.size()) {
+            Precision_t * ptr{page.data.data() + page.used};
+            page.used += size;
+            return ptr;
+          }
+        }
+        this->pages.emplace_back();
+        auto & page{this->pages.back()};
+        page.data.resize(std::max(size, PageSize));
+        page.used = size;
+        return page.data.data();
+      }
+
+      //! release all the blocks but keep the memory for later use
+      void reset() {
+        for (auto & page : this->pages) {
+          page.used = 0;
+        }
+        this->current_page = 0;
+      }
+
+      //! number of elements that can be allocated without allocating
+      size_t capacity() const {
+        size_t n_elements{0};
+        for (const auto & page : this->pages) {
+          n_elements += page.data.size();
+        }
+        return n_elements;
+      }
+
+     protected:
+      struct Page {
+        std::vector<Precision_t> data{};
+        size_t used{0};
+      };
+
+      std::vector<Page> pages{};
+      size_t current_page{0};
+      std::mutex mutex{};
+    };
+
     template <class K, class V>
     class InternallySortedKeyMap {
      public:
-      using MyMap_t = std::map<K, V>;
-      // using Map_t = std::unordered_map<K, std::array<int, 3>, Hash<K>>;
-      using Map_t = std::map<K, std::tuple<int, int, int>>;
+      //! position of a block in data: (offset, n_rows, n_cols)
+      using Map_t = SortedFlatMap<K, std::tuple<int, int, int>>;
       using Precision_t = typename V::value_type;
       using Data_t = Eigen::Array<Precision_t, Eigen::Dynamic, 1>;
       using Vector_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, 1>;
       using VectorMap_Ref = typename Eigen::Map<Vector_t>;
+      using ConstVectorMap_Ref = typename Eigen::Map<const Vector_t>;
+      using DataMap_t = Eigen::Map<Data_t>;
+      using ConstDataMap_t = Eigen::Map<const Data_t>;
+      using Arena_t = BlockArena<Precision_t>;
       using Self_t = InternallySortedKeyMap<K, V>;
-      //! the data holder.
+      //! the data holder when the map owns its storage
       Data_t data{};
       Map_t map{};
       bool normalized{false};
+      //! storage given by the owner of the map, see set_arena()
+      Arena_t * arena{nullptr};
+      //! the data held in arena (nullptr if the map owns its storage)
+      Precision_t * arena_data{nullptr};
+      //! number of elements stored
+      int data_size{0};
 
       // some member types
-      using key_type = typename MyMap_t::key_type;
+      using key_type = typename Map_t::key_type;
       using mapped_type = V;
       using value_type = std::pair<const K, mapped_type>;
-      using size_type = typename MyMap_t::size_type;
+      using size_type = typename Map_t::size_type;
       using reference = typename Eigen::Map<V>;
       using const_reference = typename Eigen::Map<const V>;
 
@@ -138,13 +310,14 @@ namespace rascal {
                                                typename Map_t::const_iterator,
                                                typename Map_t::iterator>::type;
 
-        using MyData_t = typename std::conditional<std::is_const<Value>::value,
-                                                   const Data_t, Data_t>::type;
+        using MyData_t =
+            typename std::conditional<std::is_const<Value>::value,
+                                      const Precision_t, Precision_t>::type;
         // Map<const Matrix> is already write-only so remove the const
         // which is used to determine the cv of the iterator
         using Value_t = typename std::remove_const<Value>::type;
 
-        Iterator(MyData_t & data, It_t map_iterator)
+        Iterator(MyData_t * data, It_t map_iterator)
             : data{data}, map_iterator{map_iterator} {}
 
         Self_t & operator++() {
@@ -183,28 +356,35 @@ namespace rascal {
         }
 
        protected:
-        MyData_t & data;
+        MyData_t * data;
         It_t map_iterator;
       };
 
       using iterator = Iterator<reference>;
       using const_iterator = Iterator<const const_reference>;
 
-      iterator begin() noexcept { return iterator(data, map.begin()); }
-      iterator end() noexcept { return iterator(data, map.end()); }
+      iterator begin() noexcept {
+        return iterator(this->data_ptr(), map.begin());
+      }
+      iterator end() noexcept { return iterator(this->data_ptr(), map.end()); }
 
       const_iterator begin() const noexcept {
-        return const_iterator(data, map.begin());
+        return const_iterator(this->data_ptr(), map.begin());
       }
       const_iterator end() const noexcept {
-        return const_iterator(data, map.end());
+        return const_iterator(this->data_ptr(), map.end());
       }
 
       //! Default constructor
       InternallySortedKeyMap() = default;
 
-      //! Copy constructor
-      InternallySortedKeyMap(const InternallySortedKeyMap & other) = default;
+      /**
+       * Copy constructor, the copy always owns its storage so it stays valid
+       * when the arena of other is reset
+       */
+      InternallySortedKeyMap(const InternallySortedKeyMap & other)
+          : data{other.get_data()}, map{other.map},
+            normalized{other.normalized}, data_size{other.data_size} {}
 
       //! Move constructor
       InternallySortedKeyMap(InternallySortedKeyMap && other) = default;
@@ -212,9 +392,16 @@ namespace rascal {
       //! Destructor
       ~InternallySortedKeyMap() = default;
 
-      //! Copy assignment operator
-      InternallySortedKeyMap &
-      operator=(const InternallySortedKeyMap & other) = default;
+      //! Copy assignment operator, keeps the storage mode of this map
+      InternallySortedKeyMap & operator=(const InternallySortedKeyMap & other) {
+        if (this != &other) {
+          this->map = other.map;
+          this->normalized = other.normalized;
+          this->allocate(other.data_size);
+          this->get_data() = other.get_data();
+        }
+        return *this;
+      }
 
       //! Move assignment operator
       InternallySortedKeyMap &
@@ -250,25 +437,25 @@ namespace rascal {
        */
       reference at(const SortedKey_t & skey) {
         auto & pos{this->map.at(skey.get_key())};
-        return reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
+        return reference(&this->data_ptr()[std::get<0>(pos)], std::get<1>(pos),
                          std::get<2>(pos));
       }
 
       const_reference at(const SortedKey_t & skey) const {
         auto & pos{this->map.at(skey.get_key())};
-        return const_reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
-                               std::get<2>(pos));
+        return const_reference(&this->data_ptr()[std::get<0>(pos)],
+                               std::get<1>(pos), std::get<2>(pos));
       }
       //! access or insert specified element
       reference operator[](const SortedKey_t & skey) {
         auto & pos{this->map[skey.get_key()]};
-        return reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
+        return reference(&this->data_ptr()[std::get<0>(pos)], std::get<1>(pos),
                          std::get<2>(pos));
       }
       const_reference operator[](const SortedKey_t & skey) const {
-        auto & pos{this->map[skey.get_key()]};
-        return const_reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
-                               std::get<2>(pos));
+        auto & pos{this->map.at(skey.get_key())};
+        return const_reference(&this->data_ptr()[std::get<0>(pos)],
+                               std::get<1>(pos), std::get<2>(pos));
       }
 
       /**
@@ -279,7 +466,7 @@ namespace rascal {
       void resize(const Key_List & keys, int n_row, int n_col,
                   const Precision_t & val) {
         this->resize(keys, n_row, n_col);
-        this->data = val;
+        this->get_data() = val;
       }
 
       template <typename Key_List>
@@ -302,25 +489,52 @@ namespace rascal {
             new_size += static_cast<int>(n_row * n_col);
           }
         }
-        this->data.resize(new_size);
+        this->allocate(new_size);
+      }
+
+      /**
+       * Take the storage of the blocks from arena instead of the heap. It
+       * applies to the next resize() and the blocks are valid until the
+       * arena is reset.
+       */
+      void set_arena(Arena_t * arena) { this->arena = arena; }
+
+      //! the stored elements of all the blocks, in the order of insertion
+      DataMap_t get_data() { return DataMap_t(this->data_ptr(), data_size); }
+      ConstDataMap_t get_data() const {
+        return ConstDataMap_t(this->data_ptr(), data_size);
+      }
+
+      Precision_t * data_ptr() {
+        return (this->arena_data == nullptr) ? this->data.data()
+                                             : this->arena_data;
+      }
+      const Precision_t * data_ptr() const {
+        return (this->arena_data == nullptr) ? this->data.data()
+                                             : this->arena_data;
       }
 
       //! Returns the number of elements with key that compares equivalent to
       //! the specified argument, which is either 1 or 0 since this container
       //! does not allow duplicates.
-      decltype(auto) count(const key_type & key) {
+      decltype(auto) count(const key_type & key) const {
         SortedKey_t skey{key};
         return this->count(skey);
       }
 
-      decltype(auto) count(const SortedKey_t & skey) {
+      decltype(auto) count(const SortedKey_t & skey) const {
         return this->map.count(skey.get_key());
       }
 
+      //! number of keys
+      size_type size() const noexcept { return this->map.size(); }
+
       //! Erases all elements from the container. After this call, size()
       //! returns zero.
       void clear() noexcept {
-        this->data.clear();
+        this->data.resize(0);
+        this->arena_data = nullptr;
+        this->data_size = 0;
         this->map.clear();
       }
 
@@ -334,24 +548,26 @@ namespace rascal {
         return keys;
       }
 
-      inline void multiply_elements_by(double fac) { this->data *= fac; }
+      inline void multiply_elements_by(double fac) { this->get_data() *= fac; }
 
       /**
        * l^2 norm of the entire vector
        */
-      inline Precision_t norm() const { return this->data.matrix().norm(); }
+      inline Precision_t norm() const {
+        return this->get_data().matrix().norm();
+      }
 
       inline Precision_t squaredNorm() const {
-        return this->data.matrix().squaredNorm();
+        return this->get_data().matrix().squaredNorm();
       }
 
       /**
        * squared l^2 norm of the entire vector (sum of squared elements)
        */
       inline void normalize() {
-        double norm = this->data.matrix().norm();
+        double norm = this->get_data().matrix().norm();
         if (std::abs(norm) > 0.) {
-          this->data /= norm;
+          this->get_data() /= norm;
         }
       }
 
@@ -366,7 +582,7 @@ namespace rascal {
           auto && pair_type{el.first};
           auto && pos{el.second};
           if (pair_type[0] != pair_type[1]) {
-            auto block{reference(&this->data[std::get<0>(pos)],
+            auto block{reference(&this->data_ptr()[std::get<0>(pos)],
                                  std::get<1>(pos), std::get<2>(pos))};
             block *= fac;
           }
@@ -375,20 +591,32 @@ namespace rascal {
 
       /**
        * dot product with another internally sorted map
+       *
+       * Both sets of keys are sorted so the common keys are found by a
+       * single merge-join pass over the two maps.
        */
-      inline Precision_t dot(Self_t & B) {
+      inline Precision_t dot(const Self_t & B) const {
         Precision_t val{0.};
-        auto keys_b{B.get_keys()};
-        auto unique_keys{this->intersection(keys_b)};
-
-        for (auto & key : unique_keys) {
-          auto && posA{this->map[key]};
-          auto vecA{VectorMap_Ref(&this->data[std::get<0>(posA)],
-                                  std::get<1>(posA) * std::get<2>(posA))};
-          auto && posB{B.map[key]};
-          auto vecB{VectorMap_Ref(&B.data[std::get<0>(posB)],
-                                  std::get<1>(posB) * std::get<2>(posB))};
-          val += vecA.dot(vecB);
+        auto it_a{this->map.begin()};
+        auto it_b{B.map.begin()};
+        while (it_a != this->map.end() and it_b != B.map.end()) {
+          if (it_a->first < it_b->first) {
+            ++it_a;
+          } else if (it_b->first < it_a->first) {
+            ++it_b;
+          } else {
+            auto && posA{it_a->second};
+            auto && posB{it_b->second};
+            auto vecA{ConstVectorMap_Ref(
+                &this->data_ptr()[std::get<0>(posA)],
+                std::get<1>(posA) * std::get<2>(posA))};
+            auto vecB{ConstVectorMap_Ref(
+                &B.data_ptr()[std::get<0>(posB)],
+                std::get<1>(posB) * std::get<2>(posB))};
+            val += vecA.dot(vecB);
+            ++it_a;
+            ++it_b;
+          }
         }
         return val;
       }
@@ -401,8 +629,8 @@ namespace rascal {
       inline void lhs_dot(const Eigen::EigenBase<Derived> & left_side_mat) {
         for (const auto & el : this->map) {
           auto && pos{el.second};
-          auto block{reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
-                               std::get<2>(pos))};
+          auto block{reference(&this->data_ptr()[std::get<0>(pos)],
+                               std::get<1>(pos), std::get<2>(pos))};
           block.transpose() *= left_side_mat;
         }
       }
@@ -411,8 +639,8 @@ namespace rascal {
       inline void lhs_dot_der(const Eigen::EigenBase<Derived> & left_side_mat) {
         for (const auto & el : this->map) {
           auto && pos{el.second};
-          auto blocks{reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
-                                std::get<2>(pos))};
+          auto blocks{reference(&this->data_ptr()[std::get<0>(pos)],
+                                std::get<1>(pos), std::get<2>(pos))};
           int n_rows{static_cast<int>(std::get<1>(pos) / Dim)};
           int n_cols{std::get<2>(pos)};
           for (int ii{0}; ii < Dim; ++ii) {
@@ -423,20 +651,14 @@ namespace rascal {
       }
 
      private:
-      std::vector<key_type> intersection(std::vector<key_type> & keys) {
-        if (keys.empty()) {
-          return std::vector<key_type>();
-        }
-        std::set<key_type> set{keys.cbegin(), keys.cend()};
-        std::vector<key_type> intersections;
-        for (auto el : this->map) {
-          if (set.erase(el.first) >
-              0) {  // if n exists in set, then 1 is returned and n is erased;
-                    // otherwise, 0.
-            intersections.push_back(el.first);
-          }
+      //! get storage for size elements, from the arena if there is one
+      void allocate(int size) {
+        if (this->arena == nullptr) {
+          this->data.resize(size);
+        } else if (this->arena_data == nullptr or size > this->data_size) {
+          this->arena_data = this->arena->allocate(size);
         }
-        return intersections;
+        this->data_size = size;
       }
 
       /**
@@ -465,15 +687,24 @@ namespace rascal {
         BlockSparseProperty<Precision_t, Order, PropertyLayer, Manager, Key>;
     using traits = typename Manager::traits;
 
+    //! type of the dense and sparse feature matrices, always in double
     using Matrix_t = math::Matrix_t;
-    using DenseRef_t = Eigen::Map<Matrix_t>;
+    using SparseMatrix_t = math::SparseMatrix_t;
+    //! type of the stored values
+    using Scalar_t = Precision_t;
+    using Block_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, Eigen::Dynamic,
+                                  Eigen::RowMajor>;
+    using DenseRef_t = Eigen::Map<Block_t>;
     using Key_t = Key;
     using Keys_t = std::set<Key_t>;
-    using InputData_t = internal::InternallySortedKeyMap<Key_t, Matrix_t>;
+    using InputData_t = internal::InternallySortedKeyMap<Key_t, Block_t>;
     using Data_t = std::vector<InputData_t>;
+    using Arena_t = typename InputData_t::Arena_t;
 
    protected:
     Data_t values{};
+    //! storage of the blocks of all the entries of values
+    std::unique_ptr<Arena_t> arena{std::make_unique<Arena_t>()};
     std::string type_id{};
 
    public:
@@ -555,18 +786,34 @@ namespace rascal {
       return this->base_manager.nb_clusters(Order_);
     }
 
-    //! Adjust size of values (only increases, never frees)
-
+    /**
+     * Adjust size of values (only increases, never frees). The blocks of the
+     * entries are taken from the arena of the property.
+     */
     inline void resize(bool consider_ghost_atoms = false) {
       size_t new_size{
           this->get_validated_property_length<Order>(consider_ghost_atoms)};
       this->values.resize(new_size);
+      for (auto & value : this->values) {
+        value.set_arena(this->arena.get());
+      }
     }
 
     inline size_t size() const { return this->values.size(); }
 
-    //! clear all the content of the property
-    inline void clear() { this->values.clear(); }
+    /**
+     * clear all the content of the property. The memory of the arena is kept
+     * so refilling the property with a similar layout does not allocate.
+     */
+    inline void clear() {
+      this->values.clear();
+      this->arena->reset();
+    }
+
+    //! number of elements the property can hold without allocating
+    inline size_t get_arena_capacity() const {
+      return this->arena->capacity();
+    }
 
     inline Manager_t & get_manager() {
       return static_cast<Manager_t &>(this->base_manager);
@@ -693,6 +940,71 @@ namespace rascal {
       return features;
     }
 
+    /**
+     * @return number of features stored for all the centers, i.e. the number
+     * of non zero entries of the sparse feature matrix
+     */
+    inline size_t get_nb_stored_features() const {
+      size_t n_features{0};
+      for (const auto & center_values : this->values) {
+        n_features += center_values.size();
+      }
+      return n_features * this->get_nb_comp();
+    }
+
+    /**
+     * Fill the rows of a sparse feature matrix in compressed row storage
+     * (CSR) starting at first_row. The columns are the ones of
+     * fill_dense_feature_matrix, i.e. the blocks of all_keys in order, but
+     * only the keys of each center are stored so the memory scales with the
+     * content of the property. The compressed storage of features should
+     * have room for get_nb_stored_features() entries after
+     * features.outerIndexPtr()[first_row], which is set by the caller.
+     */
+    inline void fill_sparse_feature_matrix(SparseMatrix_t & features,
+                                           int first_row,
+                                           const Keys_t & all_keys) {
+      int inner_size{this->get_nb_comp()};
+      auto row_offsets{features.outerIndexPtr()};
+      auto columns{features.innerIndexPtr()};
+      auto entries{features.valuePtr()};
+      int i_row{first_row};
+      size_t n_center{this->values.size()};
+      for (size_t i_center{0}; i_center < n_center; i_center++) {
+        int i_entry{row_offsets[i_row]};
+        int i_feat{0};
+        for (const auto & key : all_keys) {
+          if (this->values[i_center].count(key) == 1) {
+            for (int i_pos{0}; i_pos < inner_size; i_pos++) {
+              columns[i_entry] = i_feat;
+              entries[i_entry] = this->values[i_center][key](i_pos);
+              i_entry++;
+              i_feat++;
+            }
+          } else {
+            i_feat += inner_size;
+          }
+        }  // keys
+        row_offsets[i_row + 1] = i_entry;
+        i_row++;
+      }  // centers
+    }
+
+    /**
+     * Get a sparse feature matrix Ncenter x Nfeatures, see
+     * get_dense_feature_matrix() and fill_sparse_feature_matrix().
+     */
+    inline SparseMatrix_t get_sparse_feature_matrix() {
+      auto all_keys = this->get_keys();
+      size_t n_elements{this->size()};
+      int inner_size{this->get_nb_comp()};
+      SparseMatrix_t features(n_elements, inner_size * all_keys.size());
+      features.resizeNonZeros(this->get_nb_stored_features());
+      features.outerIndexPtr()[0] = 0;
+      this->fill_sparse_feature_matrix(features, 0, all_keys);
+      return features;
+    }
+
     /**
      * @return set of unique keys at the level of the structure
      */
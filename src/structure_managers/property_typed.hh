@@ -259,6 +259,11 @@ namespace rascal {
      */
     void clear() { this->values.clear(); }
 
+    //! make room for n_items so that pushing them back does not reallocate
+    void reserve(size_t n_items) {
+      this->values.reserve(n_items * this->get_nb_comp());
+    }
+
     /* ---------------------------------------------------------------------- */
     //! Property accessor by cluster ref
     template <size_t CallerLayer>
@@ -284,8 +289,9 @@ namespace rascal {
                               this->get_nb_row(), this->get_nb_col());
     }
 
-    // //! getter to the underlying data storage
-    // inline std::vector<T> & get_raw_data() { return this->values; }
+    //! contiguous storage of the values, get_nb_comp() entries per item
+    inline T * data() { return this->values.data(); }
+    inline const T * data() const { return this->values.data(); }
 
     inline void fill_dense_feature_matrix(Eigen::Ref<Matrix_t> features) {
       size_t n_center{this->get_nb_item()};
@@ -37,8 +37,36 @@ namespace rascal {
   /* ---------------------------------------------------------------------- */
   // function for setting the internal data structures
   void StructureManagerCenters::build() {
+    auto & structure{this->atoms_object};
+    if (structure.is_view) {
+      auto & view{structure.view};
+      new (&this->positions)
+          PositionsMap_t(view.positions, traits::Dim, view.n_atoms,
+                         Eigen::OuterStride<>(view.positions_stride));
+      new (&this->atom_types) AtomTypesMap_t(view.atom_types, view.n_atoms);
+    } else {
+      new (&this->positions) PositionsMap_t(
+          structure.positions.data(), traits::Dim, structure.positions.cols(),
+          Eigen::OuterStride<>(traits::Dim));
+      new (&this->atom_types) AtomTypesMap_t(structure.atom_types.data(),
+                                             structure.atom_types.size());
+    }
+
+    Cell_t lat = structure.cell;
+    this->lattice.set_cell(lat);
+
+    // the buffers of a view are updated in place by the caller, the atoms are
+    // indexed again only if they are signalled to have changed
+    if (structure.is_view and this->is_indexed_view and
+        this->indexed_version == structure.view.version and
+        this->natoms == static_cast<size_t>(structure.view.n_atoms)) {
+      return;
+    }
+    this->is_indexed_view = structure.is_view;
+    this->indexed_version = structure.view.version;
+
     auto && center_atoms_mask = this->get_center_atoms_mask();
-    this->natoms = this->get_positions().size() / traits::Dim;
+    this->natoms = this->positions.cols();
     this->n_center_atoms = center_atoms_mask.count();
     // initialize necessary data structure
     this->atoms_index[0].clear();
@@ -61,9 +89,6 @@ namespace rascal {
       }
     }
 
-    Cell_t lat = this->atoms_object.cell;
-    this->lattice.set_cell(lat);
-
     auto & atom_cluster_indices{std::get<0>(this->cluster_indices_container)};
     atom_cluster_indices.fill_sequence();
   }
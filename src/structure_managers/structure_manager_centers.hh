@@ -133,6 +133,16 @@ namespace rascal {
     using ArrayB_t = AtomicStructure<traits::Dim>::ArrayB_t;
     using ArrayB_ref = AtomicStructure<traits::Dim>::ArrayB_ref;
 
+    using AtomicStructureView_t = AtomicStructureView<traits::Dim>;
+
+    /**
+     * The positions and atom types are accessed through maps, which point
+     * either to the arrays of atoms_object or to the caller-owned buffers of
+     * an AtomicStructureView, in which case the positions can be strided.
+     */
+    using PositionsMap_t = Eigen::Map<Positions_t, 0, Eigen::OuterStride<>>;
+    using AtomTypesMap_t = Eigen::Map<AtomTypes_t>;
+
     /**
      * Here, the types for internal data structures are defined, based on
      * standard types.  In general, we try to use as many standard types, where
@@ -201,24 +211,24 @@ namespace rascal {
     //! Returns the type of a given atom, given an AtomRef
     inline int & get_atom_type(int atom_tag) {
       auto && atom_index{this->get_atom_index(atom_tag)};
-      return this->atoms_object.atom_types(atom_index);
+      return this->atom_types(atom_index);
     }
 
     //! Returns the type of a given atom, given an AtomRef
     inline int get_atom_type(int atom_tag) const {
       auto && atom_index{this->get_atom_index(atom_tag)};
-      return this->atoms_object.atom_types(atom_index);
+      return this->atom_types(atom_index);
     }
 
     //! Returns an a map with all atom types.
     inline AtomTypes_ref get_atom_types() {
-      AtomTypes_ref val(this->atoms_object.atom_types);
+      AtomTypes_ref val(this->atom_types);
       return val;
     }
 
     //! Returns an a map with all atom types.
     inline ConstAtomTypes_ref get_atom_types() const {
-      ConstAtomTypes_ref val(this->atoms_object.atom_types);
+      ConstAtomTypes_ref val(this->atom_types);
       return val;
     }
 
@@ -247,7 +257,7 @@ namespace rascal {
 
     //! returns a map to all atomic positions.
     inline Positions_ref get_positions() {
-      return Positions_ref(this->atoms_object.positions);
+      return Positions_ref(this->positions);
     }
 
     //! returns number of I atoms in the list
@@ -313,7 +323,10 @@ namespace rascal {
     void update_self() {}
 
     /**
-     * Use AtomObject to read the incoming structure
+     * Use AtomObject to read the incoming structure. When it is given as an
+     * AtomicStructureView, the positions and atom types are not copied and
+     * the atoms are only validated and indexed again when the version of the
+     * view changes.
      */
     template <class... Args>
     void update_self(Args &&... arguments) {
@@ -337,6 +350,19 @@ namespace rascal {
      */
     AtomicStructure<traits::Dim> atoms_object{};
 
+    //! positions of the atoms, see PositionsMap_t
+    PositionsMap_t positions{nullptr, traits::Dim, 0,
+                             Eigen::OuterStride<>(traits::Dim)};
+
+    //! atomic numbers of the atoms, see PositionsMap_t
+    AtomTypesMap_t atom_types{nullptr, 0};
+
+    //! whether the atoms have been indexed from an AtomicStructureView
+    bool is_indexed_view{false};
+
+    //! version of the AtomicStructureView the atoms have been indexed from
+    size_t indexed_version{0};
+
     //! Lattice type for storing the cell and querying cell-related data
     Lattice<traits::Dim> lattice;
 
@@ -32,10 +32,12 @@
 #include "structure_managers/make_structure_manager.hh"
 #include "structure_managers/property.hh"
 #include "structure_managers/updateable_base.hh"
+#include "representations/calculator_base.hh"
 #include "math/math_utils.hh"
 #include "rascal_utility.hh"
 #include "json_io.hh"
 #include "atomic_structure.hh"
+#include "structure_store.hh"
 
 namespace rascal {
 
@@ -72,10 +74,13 @@ namespace rascal {
     using Data_t = std::vector<ManagerPtr_t>;
     using value_type = typename Data_t::value_type;
     using Matrix_t = math::Matrix_t;
+    using SparseMatrix_t = math::SparseMatrix_t;
 
    protected:
     Data_t managers{};
     Hypers_t adaptor_parameters{};
+    //! stores whose buffers are read by the managers, kept alive with them
+    std::vector<std::shared_ptr<const StructureStore>> structure_stores{};
 
    public:
     ManagerCollection() = default;
@@ -234,6 +239,32 @@ namespace rascal {
       }
     }
 
+    /**
+     * add structures from a StructureStore, see
+     * add_structures(filename, start, length) for start and length
+     *
+     * The positions and atom types are read in place from the memory mapped
+     * file, without parsing nor copying them, and the collection keeps the
+     * store alive. Selecting a range of structures does not depend on the
+     * size of the store.
+     */
+    void add_structures(const std::shared_ptr<const StructureStore> & store,
+                        int start = 0, int length = -1) {
+      int n_structures{static_cast<int>(store->size())};
+      if (length == -1) {
+        length = n_structures - start;
+      }
+      if (start < 0 or length < 0 or start + length > n_structures) {
+        throw std::runtime_error("The structures to add are not in the store.");
+      }
+      this->structure_stores.push_back(store);
+      Hypers_t empty_structure = Hypers_t::object();
+      for (int index{start}; index < start + length; ++index) {
+        this->add_structure(empty_structure);
+        this->managers.back()->update(store->get_structure_view(index));
+      }
+    }
+
     //! number of structure manager in the collection
     inline size_t size() const { return this->managers.size(); }
 
@@ -245,24 +276,66 @@ namespace rascal {
       return this->managers[index]->get_shared_ptr();
     }
 
+    /**
+     * Feature matrix of the representation computed with calculator, in
+     * double whatever the precision of the features.
+     */
     template <class Calculator>
     inline Matrix_t get_dense_feature_matrix(const Calculator & calculator) {
-      using Prop_t = typename Calculator::template Property_t<Manager_t>;
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [this, &calculator](auto property_type) {
+            using Prop_t = typename decltype(property_type)::type;
 
-      auto property_name{this->get_calculator_name(calculator, false)};
+            auto property_name{this->get_calculator_name(calculator, false)};
 
-      auto && property_ =
-          managers[0]->template get_property_ref<Prop_t>(property_name);
-      // assume inner_size is consistent for all managers
-      int inner_size{property_.get_nb_comp()};
+            auto && property_ =
+                managers[0]->template get_property_ref<Prop_t>(property_name);
+            // assume inner_size is consistent for all managers
+            int inner_size{property_.get_nb_comp()};
 
-      Matrix_t features{};
+            Matrix_t features{};
 
-      auto n_rows{this->get_number_of_elements(calculator, false)};
+            auto n_rows{this->get_number_of_elements(calculator, false)};
 
-      FeatureMatrixHelper<Prop_t>::apply(this->managers, property_name,
-                                         features, n_rows, inner_size);
-      return features;
+            FeatureMatrixHelper<Prop_t>::apply(this->managers, property_name,
+                                               features, n_rows, inner_size);
+            return features;
+          });
+    }
+
+    /**
+     * Same as get_dense_feature_matrix() but in compressed sparse row (CSR)
+     * storage: only the features of the keys present in each center are
+     * stored instead of zeros, so the memory scales with the number of keys
+     * of the centers instead of the number of keys of the whole collection.
+     * The columns are in the same order, i.e. the values of the sorted keys
+     * one after the other.
+     */
+    template <class Calculator>
+    inline SparseMatrix_t
+    get_sparse_feature_matrix(const Calculator & calculator) {
+      if (this->managers.empty()) {
+        throw std::runtime_error("The collection has no structure.");
+      }
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [this, &calculator](auto property_type) {
+            using Prop_t = typename decltype(property_type)::type;
+
+            auto property_name{this->get_calculator_name(calculator, false)};
+
+            auto && property_ =
+                managers[0]->template get_property_ref<Prop_t>(property_name);
+            // assume inner_size is consistent for all managers
+            int inner_size{property_.get_nb_comp()};
+
+            SparseMatrix_t features{};
+
+            auto n_rows{this->get_number_of_elements(calculator, false)};
+
+            FeatureMatrixHelper<Prop_t>::apply_sparse(
+                this->managers, property_name, features, n_rows, inner_size);
+            return features;
+          });
     }
 
    protected:
@@ -294,6 +367,29 @@ namespace rascal {
           i_row += n_rows_manager;
         }
       }
+
+      //! the features are dense so all of them are stored
+      template <class StructureManagers>
+      static void apply_sparse(StructureManagers & managers,
+                               const std::string & property_name,
+                               SparseMatrix_t & features, int n_rows,
+                               int inner_size) {
+        Matrix_t dense_features{};
+        apply(managers, property_name, dense_features, n_rows, inner_size);
+        check_sparse_size(static_cast<size_t>(n_rows) * inner_size);
+        features.resize(n_rows, inner_size);
+        features.resizeNonZeros(n_rows * inner_size);
+        for (int i_row{0}; i_row <= n_rows; ++i_row) {
+          features.outerIndexPtr()[i_row] = i_row * inner_size;
+        }
+        for (int i_row{0}; i_row < n_rows; ++i_row) {
+          for (int i_col{0}; i_col < inner_size; ++i_col) {
+            features.innerIndexPtr()[i_row * inner_size + i_col] = i_col;
+          }
+        }
+        Eigen::Map<Matrix_t>(features.valuePtr(), n_rows, inner_size) =
+            dense_features;
+      }
     };
 
     template <typename T, size_t Order, size_t PropertyLayer, typename Key>
@@ -328,8 +424,45 @@ namespace rascal {
           i_row += n_rows_manager;
         }
       }
+
+      template <class StructureManagers>
+      static void apply_sparse(StructureManagers & managers,
+                               const std::string & property_name,
+                               SparseMatrix_t & features, int n_rows,
+                               int inner_size) {
+        Keys_t all_keys{};
+        size_t n_entries{0};
+        for (auto & manager : managers) {
+          auto && property =
+              manager->template get_property_ref<Prop_t>(property_name);
+          auto keys = property.get_keys();
+          all_keys.insert(keys.begin(), keys.end());
+          n_entries += property.get_nb_stored_features();
+        }
+        check_sparse_size(n_entries);
+
+        features.resize(n_rows, all_keys.size() * inner_size);
+        features.resizeNonZeros(n_entries);
+        features.outerIndexPtr()[0] = 0;
+        int i_row{0};
+        for (auto & manager : managers) {
+          auto && property =
+              manager->template get_property_ref<Prop_t>(property_name);
+          property.fill_sparse_feature_matrix(features, i_row, all_keys);
+          i_row += property.size();
+        }
+      }
     };
 
+    //! the entries of SparseMatrix_t are indexed with int
+    static void check_sparse_size(size_t n_entries) {
+      if (n_entries >
+          static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error(
+            "The sparse feature matrix has too many entries to be indexed.");
+      }
+    }
+
     /**
      * @param calculator a calculator
      * @param is_gradients wether to return the name associated with the
@@ -357,21 +490,25 @@ namespace rascal {
     template <class Calculator>
     inline auto get_keys(const Calculator & calculator,
                          bool is_gradients = false) {
-      using Prop_t = typename Calculator::template Property_t<Manager_t>;
-      using Keys_t = typename Prop_t::Keys_t;
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [this, &calculator, is_gradients](auto property_type) {
+            using Prop_t = typename decltype(property_type)::type;
+            using Keys_t = typename Prop_t::Keys_t;
 
-      Keys_t all_keys{};
+            Keys_t all_keys{};
 
-      auto property_name{this->get_calculator_name(calculator, is_gradients)};
+            auto property_name{
+                this->get_calculator_name(calculator, is_gradients)};
 
-      for (auto & manager : this->managers) {
-        auto && property =
-            manager->template get_property_ref<Prop_t>(property_name);
-        auto keys = property.get_keys();
-        all_keys.insert(keys.begin(), keys.end());
-      }
+            for (auto & manager : this->managers) {
+              auto && property =
+                  manager->template get_property_ref<Prop_t>(property_name);
+              auto keys = property.get_keys();
+              all_keys.insert(keys.begin(), keys.end());
+            }
 
-      return all_keys;
+            return all_keys;
+          });
     }
 
     /**
@@ -383,19 +520,23 @@ namespace rascal {
     template <class Calculator>
     inline size_t get_number_of_elements(const Calculator & calculator,
                                          bool is_gradients = false) {
-      using Prop_t = typename Calculator::template Property_t<Manager_t>;
+      return internal::visit_feature_property<Calculator, Manager_t>(
+          calculator, [this, &calculator, is_gradients](auto property_type) {
+            using Prop_t = typename decltype(property_type)::type;
 
-      size_t n_elements{0};
+            size_t n_elements{0};
 
-      auto property_name{this->get_calculator_name(calculator, is_gradients)};
+            auto property_name{
+                this->get_calculator_name(calculator, is_gradients)};
 
-      for (auto & manager : this->managers) {
-        auto && property =
-            manager->template get_property_ref<Prop_t>(property_name);
-        n_elements += property.get_nb_item();
-      }
+            for (auto & manager : this->managers) {
+              auto && property =
+                  manager->template get_property_ref<Prop_t>(property_name);
+              n_elements += property.get_nb_item();
+            }
 
-      return n_elements;
+            return n_elements;
+          });
     }
   };
 
@@ -0,0 +1,269 @@
+/**
+ * @file   structure_store.cc
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  implementation of the binary file of atomic structures
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "structure_store.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace rascal {
+
+  namespace internal {
+
+    constexpr char StructureStoreMagic[8] = {'R', 'S', 'C', 'L',
+                                             'S', 'T', 'R', '1'};
+    constexpr std::uint64_t StructureStoreVersion{1};
+
+    struct StructureStoreHeader {
+      char magic[8];
+      std::uint64_t version;
+      std::uint64_t n_structures;
+      std::uint64_t n_atoms;
+    };
+
+    //! start of each array of the file in bytes, see StructureStore
+    struct StructureStoreLayout {
+      StructureStoreLayout(size_t n_structures, size_t n_atoms)
+          : atom_offsets{next(0, sizeof(StructureStoreHeader))},
+            ids{next(atom_offsets, (n_structures + 1) * sizeof(std::uint64_t))},
+            cells{next(ids, n_structures * sizeof(std::int32_t))},
+            pbcs{next(cells, n_structures * 9 * sizeof(double))},
+            positions{next(pbcs, n_structures * 3 * sizeof(std::int32_t))},
+            atom_types{next(positions, n_atoms * 3 * sizeof(double))},
+            n_bytes{next(atom_types, n_atoms * sizeof(std::int32_t))} {}
+
+      //! start of the array following n_bytes from start, 8 bytes aligned
+      static size_t next(size_t start, size_t n_bytes) {
+        return start + (n_bytes + 7) / 8 * 8;
+      }
+
+      size_t atom_offsets;
+      size_t ids;
+      size_t cells;
+      size_t pbcs;
+      size_t positions;
+      size_t atom_types;
+      size_t n_bytes;
+    };
+
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  StructureStore::StructureStore(const std::string & filename)
+      : file{filename} {
+    static_assert(sizeof(int) == sizeof(std::int32_t),
+                  "The atom types are mapped as int.");
+    auto bytes{this->file.data()};
+    internal::StructureStoreHeader header{};
+    if (this->file.size() < sizeof(header)) {
+      throw std::runtime_error(filename + " is not a structure store.");
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    internal::StructureStoreLayout layout{header.n_structures, header.n_atoms};
+    if (std::memcmp(header.magic, internal::StructureStoreMagic,
+                    sizeof(header.magic)) != 0 or
+        header.version != internal::StructureStoreVersion or
+        layout.n_bytes != this->file.size()) {
+      throw std::runtime_error(filename +
+                               " is not a structure store or is corrupted.");
+    }
+    this->n_structures = header.n_structures;
+    this->n_atoms = header.n_atoms;
+    this->atom_offsets =
+        reinterpret_cast<const std::uint64_t *>(bytes + layout.atom_offsets);
+    this->ids = reinterpret_cast<const std::int32_t *>(bytes + layout.ids);
+    this->cells = reinterpret_cast<const double *>(bytes + layout.cells);
+    this->pbcs = reinterpret_cast<const std::int32_t *>(bytes + layout.pbcs);
+    this->positions = reinterpret_cast<double *>(bytes + layout.positions);
+    this->atom_types = reinterpret_cast<int *>(bytes + layout.atom_types);
+
+    if (this->atom_offsets[0] != 0 or
+        this->atom_offsets[this->n_structures] != this->n_atoms or
+        not std::is_sorted(this->atom_offsets,
+                           this->atom_offsets + this->n_structures + 1)) {
+      throw std::runtime_error(filename + " has inconsistent atom offsets.");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStore::check_index(size_t index) const {
+    if (index >= this->n_structures) {
+      throw std::out_of_range("Structure " + std::to_string(index) +
+                              " is not in the store of " +
+                              std::to_string(this->n_structures) +
+                              " structures.");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto StructureStore::get_structure_view(size_t index) const -> View_t {
+    this->check_index(index);
+    View_t view{};
+    auto first_atom{this->atom_offsets[index]};
+    view.positions = this->positions + 3 * first_atom;
+    view.positions_stride = 3;
+    view.atom_types = this->atom_types + first_atom;
+    view.n_atoms = static_cast<Eigen::Index>(this->get_n_atoms(index));
+    view.cell = Eigen::Map<const Eigen::Matrix3d>(this->cells + 9 * index);
+    view.pbc = Eigen::Map<const Eigen::Vector3i>(this->pbcs + 3 * index);
+    return view;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  AtomicStructure<3> StructureStore::get_structure(size_t index) const {
+    auto view{this->get_structure_view(index)};
+    AtomicStructure<3> structure{};
+    structure.set_structure(
+        Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>>(
+            view.positions, 3, view.n_atoms),
+        Eigen::Map<const Eigen::VectorXi>(view.atom_types, view.n_atoms),
+        view.cell, view.pbc);
+    return structure;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStore::write(const std::string & filename,
+                             const std::vector<AtomicStructure<3>> & structures,
+                             const std::vector<int> & ids) {
+    size_t n_structures{structures.size()};
+    if (not ids.empty() and ids.size() != n_structures) {
+      throw std::runtime_error("There should be one id per structure.");
+    }
+    std::vector<std::uint64_t> atom_offsets{0};
+    for (auto & structure : structures) {
+      if (not structure.center_atoms_mask.all()) {
+        throw std::runtime_error(
+            "The structure store does not support center_atoms_mask.");
+      }
+      atom_offsets.push_back(atom_offsets.back() +
+                             structure.get_number_of_atoms());
+    }
+    internal::StructureStoreHeader header{};
+    std::memcpy(header.magic, internal::StructureStoreMagic,
+                sizeof(header.magic));
+    header.version = internal::StructureStoreVersion;
+    header.n_structures = n_structures;
+    header.n_atoms = atom_offsets.back();
+    internal::StructureStoreLayout layout{n_structures, atom_offsets.back()};
+
+    std::ofstream writer(filename, std::ios::binary | std::ios::trunc);
+    if (not writer.is_open()) {
+      throw std::runtime_error(std::string("Could not open the file: ") +
+                               filename);
+    }
+    // arrays start on a multiple of 8 bytes, see StructureStoreLayout
+    auto pad_to = [&writer](size_t start) {
+      while (static_cast<size_t>(writer.tellp()) < start) {
+        writer.put('\0');
+      }
+    };
+    auto write_bytes = [&writer](const void * values, size_t n_bytes) {
+      writer.write(static_cast<const char *>(values), n_bytes);
+    };
+    write_bytes(&header, sizeof(header));
+    pad_to(layout.atom_offsets);
+    write_bytes(atom_offsets.data(),
+                atom_offsets.size() * sizeof(std::uint64_t));
+
+    std::vector<std::int32_t> store_ids(n_structures);
+    if (ids.empty()) {
+      std::iota(store_ids.begin(), store_ids.end(), 0);
+    } else {
+      std::copy(ids.begin(), ids.end(), store_ids.begin());
+    }
+    pad_to(layout.ids);
+    write_bytes(store_ids.data(), n_structures * sizeof(std::int32_t));
+
+    std::vector<double> cells(9 * n_structures);
+    std::vector<std::int32_t> pbcs(3 * n_structures);
+    for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+      Eigen::Map<Eigen::Matrix3d> cell(&cells[9 * i_structure]);
+      Eigen::Map<Eigen::Vector3i> pbc(&pbcs[3 * i_structure]);
+      cell = structures[i_structure].cell;
+      pbc = structures[i_structure].pbc;
+    }
+    pad_to(layout.cells);
+    write_bytes(cells.data(), cells.size() * sizeof(double));
+    pad_to(layout.pbcs);
+    write_bytes(pbcs.data(), pbcs.size() * sizeof(std::int32_t));
+
+    pad_to(layout.positions);
+    Eigen::Matrix<double, 3, Eigen::Dynamic> positions{};
+    for (auto & structure : structures) {
+      if (structure.is_view) {
+        auto & view{structure.view};
+        positions = Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>,
+                               0, Eigen::OuterStride<>>(
+            view.positions, 3, view.n_atoms,
+            Eigen::OuterStride<>(view.positions_stride));
+      } else {
+        positions = structure.positions;
+      }
+      write_bytes(positions.data(), positions.size() * sizeof(double));
+    }
+    pad_to(layout.atom_types);
+    for (auto & structure : structures) {
+      const int * atom_types{structure.is_view ? structure.view.atom_types
+                                               : structure.atom_types.data()};
+      write_bytes(atom_types,
+                  structure.get_number_of_atoms() * sizeof(std::int32_t));
+    }
+    pad_to(layout.n_bytes);
+    if (not writer.good()) {
+      throw std::runtime_error(std::string("Could not write the file: ") +
+                               filename);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStore::convert_ase(const std::string & ase_filename,
+                                   const std::string & filename) {
+    std::vector<AtomicStructure<3>> structures{};
+    std::vector<int> ids{};
+    json_io::read_ase_structures(ase_filename, [&](int id, json && structure) {
+      ids.push_back(id);
+      structures.emplace_back();
+      structures.back().set_structure(structure);
+      return true;
+    });
+
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+    std::vector<AtomicStructure<3>> sorted_structures{};
+    std::vector<int> sorted_ids{};
+    sorted_structures.reserve(order.size());
+    sorted_ids.reserve(order.size());
+    for (auto & index : order) {
+      sorted_structures.push_back(std::move(structures[index]));
+      sorted_ids.push_back(ids[index]);
+    }
+    StructureStore::write(filename, sorted_structures, sorted_ids);
+  }
+
+}  // namespace rascal
@@ -0,0 +1,135 @@
+/**
+ * @file   structure_store.hh
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  compact binary file of atomic structures read through a memory map
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_STRUCTURE_STORE_HH_
+#define SRC_STRUCTURE_STORE_HH_
+
+#include "atomic_structure.hh"
+#include "utils/mapped_file.hh"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Read-only set of atomic structures stored in a binary file, which is
+   * memory mapped instead of being parsed.
+   *
+   * The file starts with a header (magic string, format version, number of
+   * structures and total number of atoms) followed by contiguous arrays,
+   * each starting on a multiple of 8 bytes:
+   *
+   *   - atom offsets, uint64 (n_structures + 1): first atom of each structure
+   *   - ids, int32 (n_structures): id of the structure in the original file
+   *   - cells, double (n_structures, 3, 3): cell vectors as columns
+   *   - pbc, int32 (n_structures, 3)
+   *   - positions, double (n_atoms, 3)
+   *   - atom types, int32 (n_atoms)
+   *
+   * in the byte order of the machine that wrote it. Structure i is made of
+   * the atoms atom_offsets[i] to atom_offsets[i+1], so any structure or range
+   * of structures is accessed in constant time and its positions and atom
+   * types are handed to StructureManagerCenters as an AtomicStructureView,
+   * i.e. without copy. The pages of the file are only read when they are
+   * accessed and are shared with the page cache.
+   *
+   * The mapping is private: the positions are never written to the file and
+   * the views stay valid as long as the store is alive.
+   */
+  class StructureStore {
+   public:
+    using View_t = AtomicStructureView<3>;
+
+    //! map the file, which is unmapped with the store
+    explicit StructureStore(const std::string & filename);
+
+    //! the views point into the mapping, which is owned by the store
+    StructureStore(const StructureStore &) = delete;
+    StructureStore(StructureStore &&) = delete;
+    StructureStore & operator=(const StructureStore &) = delete;
+    StructureStore & operator=(StructureStore &&) = delete;
+
+    //! number of structures
+    inline size_t size() const { return this->n_structures; }
+
+    //! total number of atoms
+    inline size_t get_n_atoms() const { return this->n_atoms; }
+
+    //! number of atoms of the structure at index
+    inline size_t get_n_atoms(size_t index) const {
+      return this->atom_offsets[index + 1] - this->atom_offsets[index];
+    }
+
+    //! id of the structure at index in the file it was converted from
+    inline int get_id(size_t index) const { return this->ids[index]; }
+
+    /**
+     * Non-owning view of the structure at index, valid as long as the store
+     * is alive
+     */
+    View_t get_structure_view(size_t index) const;
+
+    //! copy of the structure at index
+    AtomicStructure<3> get_structure(size_t index) const;
+
+    /**
+     * Write structures in the format of the store.
+     *
+     * @param ids id of each structure, by default their index
+     */
+    static void write(const std::string & filename,
+                      const std::vector<AtomicStructure<3>> & structures,
+                      const std::vector<int> & ids = {});
+
+    /**
+     * Convert a file in the ase json format (text or ubjson) to the format
+     * of the store. The structures are sorted by id like in
+     * ManagerCollection::add_structures(filename), so that the indices of the
+     * store are the same as its start and length arguments.
+     */
+    static void convert_ase(const std::string & ase_filename,
+                            const std::string & filename);
+
+   protected:
+    void check_index(size_t index) const;
+
+    internal::MappedFile file;
+
+    size_t n_structures{0};
+    size_t n_atoms{0};
+
+    const std::uint64_t * atom_offsets{nullptr};
+    const std::int32_t * ids{nullptr};
+    const double * cells{nullptr};
+    const std::int32_t * pbcs{nullptr};
+    double * positions{nullptr};
+    int * atom_types{nullptr};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_STRUCTURE_STORE_HH_
@@ -0,0 +1,75 @@
+/**
+ * @file   mapped_file.cc
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  implementation of the memory map of a whole file
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "utils/mapped_file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace rascal {
+  namespace internal {
+
+    /* ---------------------------------------------------------------------- */
+    MappedFile::MappedFile(const std::string & filename) {
+      int fd{::open(filename.c_str(), O_RDONLY)};
+      if (fd < 0) {
+        throw std::runtime_error(std::string("Could not open the file: ") +
+                                 filename);
+      }
+      struct stat file_stat {};
+      if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw std::runtime_error(std::string("Could not read the file: ") +
+                                 filename);
+      }
+      this->n_bytes = static_cast<size_t>(file_stat.st_size);
+      if (this->n_bytes == 0) {
+        // nothing to map
+        ::close(fd);
+        return;
+      }
+      void * data{::mmap(nullptr, this->n_bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE, fd, 0)};
+      ::close(fd);
+      if (data == MAP_FAILED) {
+        throw std::runtime_error(std::string("Could not map the file: ") +
+                                 filename);
+      }
+      this->bytes = static_cast<char *>(data);
+    }
+
+    /* ---------------------------------------------------------------------- */
+    MappedFile::~MappedFile() {
+      if (this->bytes != nullptr) {
+        ::munmap(this->bytes, this->n_bytes);
+      }
+    }
+
+  }  // namespace internal
+}  // namespace rascal
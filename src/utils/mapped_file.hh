@@ -0,0 +1,68 @@
+/**
+ * @file   mapped_file.hh
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  memory map of a whole file
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_UTILS_MAPPED_FILE_HH_
+#define SRC_UTILS_MAPPED_FILE_HH_
+
+#include <cstddef>
+#include <string>
+
+namespace rascal {
+  namespace internal {
+
+    /**
+     * Private memory map of a whole file, unmapped on destruction.
+     *
+     * The pages are read from the file when they are first accessed and
+     * shared with the page cache. The mapping is writable so that its content
+     * can be handed over as mutable buffers, but the writes are private
+     * (copy on write) and never reach the file.
+     */
+    class MappedFile {
+     public:
+      explicit MappedFile(const std::string & filename);
+
+      MappedFile(const MappedFile &) = delete;
+      MappedFile(MappedFile &&) = delete;
+      MappedFile & operator=(const MappedFile &) = delete;
+      MappedFile & operator=(MappedFile &&) = delete;
+
+      ~MappedFile();
+
+      //! first byte of the file
+      inline char * data() const { return this->bytes; }
+
+      //! size of the file in bytes
+      inline size_t size() const { return this->n_bytes; }
+
+     protected:
+      char * bytes{nullptr};
+      size_t n_bytes{0};
+    };
+
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_UTILS_MAPPED_FILE_HH_
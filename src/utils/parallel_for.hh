@@ -0,0 +1,130 @@
+/**
+ * @file   parallel_for.hh
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief  minimal thread based work sharing used by the calculators
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * librascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * librascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with librascal; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_UTILS_PARALLEL_FOR_HH_
+#define SRC_UTILS_PARALLEL_FOR_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rascal {
+
+  namespace utils {
+
+    /**
+     * Number of threads to use when the user asks for "all of them", i.e.
+     * when n_threads == 0. Falls back to 1 if the hardware concurrency can't
+     * be determined.
+     */
+    inline size_t get_n_threads_available() {
+      size_t n_threads{std::thread::hardware_concurrency()};
+      return std::max(n_threads, size_t{1});
+    }
+
+    /**
+     * Resolve a user given number of threads: 0 means all the available
+     * hardware threads and there is no point in having more threads than
+     * items to process.
+     */
+    inline size_t resolve_n_threads(size_t n_threads, size_t n_items) {
+      if (n_threads == 0) {
+        n_threads = get_n_threads_available();
+      }
+      return std::max(std::min(n_threads, n_items), size_t{1});
+    }
+
+    /**
+     * Call function(thread_id, item_id) for every item_id in [0, n_items)
+     * using n_threads std::threads (the calling thread being thread 0).
+     *
+     * Items are handed out one by one from a shared counter so that uneven
+     * workloads (e.g. structures of very different sizes) are balanced. The
+     * thread_id is in [0, n_threads) and is meant to index per-thread scratch
+     * data, so that function never has to share mutable state between
+     * threads. The order in which the items are processed is unspecified but
+     * every item is processed exactly once.
+     *
+     * The first exception thrown by function is rethrown on the calling
+     * thread once all the threads have joined; the remaining items are
+     * skipped.
+     *
+     * @param n_threads number of threads to use, 0 means all the available
+     * hardware threads (see resolve_n_threads())
+     */
+    template <class Function>
+    void parallel_for(size_t n_items, size_t n_threads, Function && function) {
+      n_threads = resolve_n_threads(n_threads, n_items);
+      if (n_threads == 1) {
+        for (size_t item_id{0}; item_id < n_items; ++item_id) {
+          function(size_t{0}, item_id);
+        }
+        return;
+      }
+
+      std::atomic<size_t> next_item{0};
+      std::exception_ptr error{nullptr};
+      std::mutex error_mutex{};
+
+      auto worker = [&](size_t thread_id) {
+        try {
+          for (size_t item_id{next_item++}; item_id < n_items;
+               item_id = next_item++) {
+            function(thread_id, item_id);
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock{error_mutex};
+          if (not error) {
+            error = std::current_exception();
+          }
+          // make the other threads stop picking up new items
+          next_item = n_items;
+        }
+      };
+
+      std::vector<std::thread> threads{};
+      threads.reserve(n_threads - 1);
+      for (size_t thread_id{1}; thread_id < n_threads; ++thread_id) {
+        threads.emplace_back(worker, thread_id);
+      }
+      worker(0);
+      for (auto & thread : threads) {
+        thread.join();
+      }
+
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+  }  // namespace utils
+
+}  // namespace rascal
+
+#endif  // SRC_UTILS_PARALLEL_FOR_HH_
@@ -4,13 +4,16 @@ import unittest
 import faulthandler
 
 from python_structure_manager_test import (
-    TestStructureManagerCenters, TestNL, TestNLStrict
+    TestStructureManagerCenters, TestUpdateFromBuffers, TestStructureStore,
+    TestNL, TestNLStrict
 )
 from python_representation_calculator_test import (
     TestSortedCoulombRepresentation, TestSphericalExpansionRepresentation,
     TestSphericalInvariantsRepresentation
 )
 
+from python_models_test import TestKernel, TestFeatureStore
+
 from python_math_test import TestMath
 
 from python_test_sparsify_fps import TestFPS
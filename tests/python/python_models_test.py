@@ -0,0 +1,182 @@
+from rascal.representations import SphericalInvariants
+from rascal.models import Kernel, FeatureStore
+from rascal.neighbourlist import AtomsList
+from test_utils import load_json_frame
+import unittest
+import numpy as np
+import gc
+import os
+import tempfile
+
+
+class TestKernel(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case. Test the kernels between the SOAP vectors of
+        a triclinic crystal and of its Ca and O atoms only.
+        """
+
+        fn = '../tests/reference_data/CaCrP2O7_mvc-11955_symmetrized.json'
+        frame = load_json_frame(fn)
+        mask = np.isin(frame['atom_types'].flatten(), [8, 20])
+        frame_CaO = dict(
+            cell=frame['cell'], pbc=frame['pbc'],
+            positions=np.array(frame['positions'][:, mask], order='F'),
+            atom_types=frame['atom_types'][mask].reshape(-1, 1))
+        self.frames = [frame, frame_CaO]
+
+        self.hypers = dict(soap_type="PowerSpectrum",
+                           interaction_cutoff=3.5,
+                           max_radial=4,
+                           max_angular=3,
+                           gaussian_sigma_constant=0.4,
+                           gaussian_sigma_type="Constant",
+                           cutoff_smooth_width=0.5,
+                           )
+
+    def test_compute_tiles(self):
+        '''
+        Compare the tiles of rows of the kernels to the whole kernel matrix
+        '''
+        rep = SphericalInvariants(**self.hypers)
+        features = rep.transform(self.frames)
+        for target_type in ['Structure', 'Atom']:
+            kernel = Kernel(rep, name='Cosine', target_type=target_type,
+                            zeta=2, tile_rows=5, tile_cols=7)
+            reference = kernel(features)
+
+            tiles = []
+
+            def callback(first_row, tile):
+                # the tiles come in order
+                self.assertEqual(first_row, sum(len(t) for t in tiles))
+                tiles.append(tile)
+
+            kernel.compute_tiles(callback, features)
+            self.assertGreater(len(tiles), 1)
+            self.assertTrue(np.allclose(np.vstack(tiles), reference))
+
+    def test_compute_derivative(self):
+        '''
+        Compare the derivatives of the kernels between a molecule and its
+        environments, with respect to the positions and to the strain, to
+        finite differences
+        '''
+        fn = '../tests/reference_data/small_molecule.json'
+        frame = load_json_frame(fn)
+        rep = SphericalInvariants(compute_gradients=True, **self.hypers)
+        sparse_points = rep.transform([frame])
+        kernel = Kernel(rep, name='Cosine', target_type='Structure', zeta=2)
+        derivative = kernel.compute_derivative(rep.transform([frame]),
+                                               sparse_points,
+                                               compute_stress=True)
+        n_atoms = frame['atom_types'].size
+        self.assertEqual(derivative.shape,
+                         (3 * n_atoms + 6, n_atoms))
+
+        # average over the centers of the kernel between the environments
+        atom_kernel = Kernel(rep, name='Cosine', target_type='Atom', zeta=2)
+
+        def compute_kernel(positions):
+            displaced = dict(frame, positions=positions)
+            return atom_kernel(rep.transform([displaced]),
+                               sparse_points).mean(axis=0)
+
+        delta = 1e-5
+
+        def check_finite_difference(plus, minus, row):
+            finite_difference = (compute_kernel(plus) -
+                                 compute_kernel(minus)) / (2 * delta)
+            scale = max(np.abs(derivative[row]).max(), 1e-3)
+            self.assertLess(
+                np.abs(derivative[row] - finite_difference).max() / scale,
+                1e-5)
+
+        positions = frame['positions']
+        for i_atom in range(3):
+            for i_dim in range(3):
+                plus, minus = np.array(positions), np.array(positions)
+                plus[i_dim, i_atom] += delta
+                minus[i_dim, i_atom] -= delta
+                check_finite_difference(plus, minus, 3 * i_atom + i_dim)
+        # the molecule is not periodic, the cell needs no strain
+        voigt = [(0, 0), (1, 1), (2, 2), (1, 2), (0, 2), (0, 1)]
+        for i_voigt, (a, b) in enumerate(voigt):
+            plus, minus = np.array(positions), np.array(positions)
+            plus[a] += delta * positions[b]
+            minus[a] -= delta * positions[b]
+            check_finite_difference(plus, minus, 3 * n_atoms + i_voigt)
+
+
+class TestFeatureStore(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case. Write the SOAP vectors of a triclinic crystal
+        and of its Ca and O atoms only to a FeatureStore.
+        """
+
+        fn = '../tests/reference_data/CaCrP2O7_mvc-11955_symmetrized.json'
+        frame = load_json_frame(fn)
+        mask = np.isin(frame['atom_types'].flatten(), [8, 20])
+        frame_CaO = dict(
+            cell=frame['cell'], pbc=frame['pbc'],
+            positions=np.array(frame['positions'][:, mask], order='F'),
+            atom_types=frame['atom_types'][mask].reshape(-1, 1))
+        self.frames = [frame, frame_CaO]
+        self.n_centers = [frame['atom_types'].size, np.count_nonzero(mask)]
+
+        self.rep = SphericalInvariants(soap_type="PowerSpectrum",
+                                       interaction_cutoff=3.5,
+                                       max_radial=4,
+                                       max_angular=3,
+                                       gaussian_sigma_constant=0.4,
+                                       gaussian_sigma_type="Constant",
+                                       cutoff_smooth_width=0.5)
+        self.features = self.rep.transform(self.frames)
+
+        self.directory = tempfile.TemporaryDirectory()
+        self.filename = os.path.join(self.directory.name, 'features.bin')
+        FeatureStore.write(self.filename, self.features.managers,
+                           self.rep._representation)
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def test_round_trip(self):
+        name = self.rep._representation.name
+        store = FeatureStore(self.filename, name)
+        self.assertEqual(store.name, name)
+        self.assertEqual(store.name_hash, FeatureStore.get_name_hash(name))
+        self.assertEqual(store.n_structures, len(self.frames))
+        self.assertEqual(store.n_centers, sum(self.n_centers))
+        self.assertEqual(store.get_structure_offsets(),
+                         [0, self.n_centers[0], sum(self.n_centers)])
+        # the features are normalized
+        self.assertTrue(np.allclose(store.get_squared_norms(), 1))
+        with self.assertRaises(RuntimeError):
+            FeatureStore(self.filename, name + 'other')
+
+        # the features registered from the store are the computed ones
+        managers = AtomsList(self.frames, self.rep.nl_options)
+        store.fill_properties(managers.managers, self.rep._representation)
+        self.assertTrue(np.allclose(
+            managers.get_dense_feature_matrix(self.rep),
+            self.features.get_dense_feature_matrix(self.rep)))
+
+        for target_type in ['Structure', 'Atom']:
+            kernel = Kernel(self.rep, name='Cosine', target_type=target_type,
+                            zeta=2)
+            self.assertTrue(np.allclose(kernel(store),
+                                        kernel(self.features)))
+
+    def test_views(self):
+        store = FeatureStore(self.filename)
+        centers = store.get_centers(0)
+        values = store.get_values(0)
+        self.assertEqual(len(centers), len(values))
+        self.assertTrue(np.all(np.diff(centers.astype(np.int64)) > 0))
+        # the arrays are read-only views of the file that keep it mapped
+        self.assertFalse(values.flags.writeable)
+        del store
+        gc.collect()
+        self.assertTrue(np.all(np.isfinite(values)))
@@ -82,3 +82,43 @@ class TestSphericalInvariantsRepresentation(unittest.TestCase):
         features = rep.transform([self.frame])
 
         test = features.get_dense_feature_matrix(rep)
+
+    def test_sparse_feature_matrix(self):
+        '''
+        Compare the sparse feature matrices to the dense one, with a second
+        structure without Cr and P atoms so that its centers have fewer keys
+        '''
+        frame = self.frame
+        mask = np.isin(frame['atom_types'].flatten(), [8, 20])
+        frame_CaO = dict(
+            cell=frame['cell'], pbc=frame['pbc'],
+            positions=np.array(frame['positions'][:, mask], order='F'),
+            atom_types=frame['atom_types'][mask].reshape(-1, 1))
+
+        rep = SphericalInvariants(**self.hypers)
+        features = rep.transform([frame, frame_CaO])
+        dense = features.get_dense_feature_matrix(rep)
+
+        # the buffers of the C++ matrix are shared by the arrays
+        data, indices, indptr, shape, block_size = \
+            features.managers.get_sparse_feature_matrix(rep._representation)
+        self.assertEqual(indices.dtype, np.int32)
+        self.assertEqual(indptr.dtype, np.int32)
+        self.assertIs(data.base, indices.base)
+        self.assertIs(data.base, indptr.base)
+        self.assertEqual(shape, dense.shape)
+        self.assertEqual(dense.shape[1] % block_size, 0)
+
+        csr = features.get_sparse_feature_matrix(rep)
+        self.assertEqual(csr.shape, dense.shape)
+        self.assertTrue(np.allclose(csr.toarray(), dense))
+        # only the keys of each center are stored
+        self.assertLess(csr.nnz, dense.size)
+        n_entries = np.diff(csr.indptr)
+        n_centers = frame['atom_types'].size
+        self.assertLess(n_entries[n_centers:].max(),
+                        n_entries[:n_centers].max())
+
+        bsr = features.get_sparse_feature_matrix(rep, blocks=True)
+        self.assertEqual(bsr.blocksize, (1, block_size))
+        self.assertTrue(np.allclose(bsr.toarray(), dense))
@@ -1,9 +1,16 @@
-from rascal.neighbourlist import get_neighbourlist
+from rascal.neighbourlist import get_neighbourlist, AtomsList
+from rascal.neighbourlist.base import NeighbourListFactory
+from rascal.lib import neighbour_list
 from test_utils import load_json_frame, BoxList, Box
 import unittest
 import numpy as np
 import sys
 import faulthandler
+import gc
+import json
+import os
+import tempfile
+import weakref
 
 
 def get_NL_reference(cutoff, cell, pbc, positions, atom_types):
@@ -87,6 +94,171 @@ class TestStructureManagerCenters(unittest.TestCase):
             ii += 1
 
 
+class TestUpdateFromBuffers(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case. Test the update of a structure manager from
+        numpy arrays read in place (AtomicStructureView).
+        """
+
+        fn = '../tests/reference_data/CaCrP2O7_mvc-11955_symmetrized.json'
+        self.frame = load_json_frame(fn)
+        # (n_atoms, 3) like the positions of an ase.Atoms
+        self.positions = np.array(self.frame['positions'].T, order='C')
+        self.atom_types = np.array(
+            self.frame['atom_types'].flatten(), dtype=np.int32)
+        self.cell = self.frame['cell']
+        self.pbc = np.array(self.frame['pbc'], dtype=np.int32)
+        self.nl_options = [
+            dict(name='centers', args={}),
+        ]
+
+    def update(self, manager, positions, atom_types, version):
+        manager.update_from_buffers(positions, atom_types, self.cell,
+                                    self.pbc, version)
+
+    def test_positions_without_copy(self):
+        manager = NeighbourListFactory(self.nl_options)
+        # the rows of the positions can be strided
+        buffer = np.zeros((len(self.atom_types), 4))
+        buffer[:, :3] = self.positions
+        # a new version for each new array
+        for version, positions in enumerate([np.array(self.positions),
+                                             buffer[:, :3]]):
+            self.update(manager, positions, self.atom_types, version)
+            manager_positions = manager.get_positions()
+            self.assertTrue(np.shares_memory(manager_positions, positions))
+            self.assertTrue(np.allclose(manager_positions, positions.T))
+            self.assertTrue(np.allclose(manager.get_cell(), self.cell))
+
+            # in place modifications are seen without a new version
+            positions += 0.1
+            self.update(manager, positions, self.atom_types, version)
+            self.assertTrue(np.allclose(manager.get_positions(),
+                                        positions.T))
+            for center in manager:
+                self.assertTrue(np.allclose(
+                    positions[center.atom_tag], center.position))
+                self.assertTrue(
+                    self.atom_types[center.atom_tag] == center.atom_type)
+
+    def test_buffers_kept_alive(self):
+        manager = NeighbourListFactory(self.nl_options)
+        positions = np.array(self.positions)
+        atom_types = np.array(self.atom_types)
+        positions_ref = weakref.ref(positions)
+        atom_types_ref = weakref.ref(atom_types)
+        self.update(manager, positions, atom_types, 0)
+        del positions, atom_types
+        gc.collect()
+        self.assertIsNotNone(positions_ref())
+        self.assertIsNotNone(atom_types_ref())
+        self.assertTrue(np.allclose(manager.get_positions(),
+                                    self.positions.T))
+
+        # the buffers of the previous update are released
+        self.update(manager, self.positions, self.atom_types, 1)
+        gc.collect()
+        self.assertIsNone(positions_ref())
+        self.assertIsNone(atom_types_ref())
+
+    def test_invalid_buffers(self):
+        manager = NeighbourListFactory(self.nl_options)
+        # the positions should have contiguous rows
+        with self.assertRaises(RuntimeError):
+            self.update(manager, np.asfortranarray(self.positions),
+                        self.atom_types, 0)
+        # the atom types should be int32
+        with self.assertRaises(RuntimeError):
+            self.update(manager, self.positions,
+                        self.atom_types.astype(np.int64), 0)
+
+
+class TestStructureStore(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case. Convert a small file in the ase json format,
+        with a crystal and a molecule, to a StructureStore.
+        """
+
+        self.directory = tempfile.TemporaryDirectory()
+        self.ase_filename = os.path.join(self.directory.name,
+                                         'structures.json')
+        self.filename = os.path.join(self.directory.name, 'structures.bin')
+        frames = {}
+        for fn in ['CaCrP2O7_mvc-11955_symmetrized.json',
+                   'small_molecule.json']:
+            with open('../tests/reference_data/' + fn, 'r') as f:
+                data = json.load(f)
+            frames[str(len(frames) + 1)] = data[str(data['ids'][0])]
+        self.frames = frames
+        with open(self.ase_filename, 'w') as f:
+            json.dump(dict(ids=[1, 2], nextid=3, **frames), f)
+        neighbour_list.StructureStore.convert_ase(self.ase_filename,
+                                                  self.filename)
+
+        self.cutoff = 3.
+        self.nl_options = [
+            dict(name='centers', args=dict()),
+            dict(name='neighbourlist', args=dict(cutoff=self.cutoff)),
+            dict(name='strict', args=dict(cutoff=self.cutoff))
+        ]
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def test_convert_ase(self):
+        store = neighbour_list.StructureStore(self.filename)
+        self.assertEqual(len(store), len(self.frames))
+        for index in range(len(store)):
+            self.assertEqual(store.get_id(index), index + 1)
+            frame = self.frames[str(index + 1)]
+            structure = store.get_structure(index)
+            self.assertTrue(np.allclose(structure.get_positions(),
+                                        np.array(frame['positions']).T))
+            self.assertTrue(np.all(structure.get_atom_types().flatten() ==
+                                   frame['numbers']))
+            self.assertTrue(np.allclose(structure.get_cell(),
+                                        np.array(frame['cell']).T))
+        with self.assertRaises(IndexError):
+            store.get_id(len(store))
+        with self.assertRaises(IndexError):
+            store.get_structure(len(store))
+
+    def test_atoms_list(self):
+        """
+        The managers of the structures read from the store are the same as
+        the ones read from the ase file
+        """
+        reference = AtomsList(self.ase_filename, self.nl_options)
+        store = neighbour_list.StructureStore(self.filename)
+        managers = AtomsList(store, self.nl_options)
+        self.assertEqual(len(managers.managers), len(reference.managers))
+        for index in range(len(reference.managers)):
+            self.check_equal(managers[index], reference[index])
+
+        # a range of the store
+        managers = AtomsList(store, self.nl_options, start=1, length=1)
+        self.assertEqual(len(managers.managers), 1)
+        self.check_equal(managers[0], reference[1])
+
+    def check_equal(self, manager, reference):
+        centers = list(manager)
+        reference_centers = list(reference)
+        self.assertEqual(len(centers), len(reference_centers))
+        for center, reference_center in zip(centers, reference_centers):
+            self.assertEqual(center.atom_type, reference_center.atom_type)
+            self.assertTrue(np.allclose(center.position,
+                                        reference_center.position))
+            distances = sorted(np.linalg.norm(neigh.position -
+                                              center.position)
+                               for neigh in center)
+            reference_distances = sorted(
+                np.linalg.norm(neigh.position - reference_center.position)
+                for neigh in reference_center)
+            self.assertTrue(np.allclose(distances, reference_distances))
+
+
 class TestNL(unittest.TestCase):
     def setUp(self):
         """
@@ -70,6 +70,39 @@ namespace rascal {
     BOOST_CHECK_EQUAL(n_update, managers_no_skin->get_n_update());
     BOOST_CHECK_EQUAL(n_update - 1, managers_small_skin->get_n_update());
     BOOST_CHECK_EQUAL(1, managers_skin->get_n_update());
+
+    // the reused lists, whose ghosts have been moved along with the atoms,
+    // have to find the same neighbours within the cutoff as the rebuilt one
+    auto get_distances = [](auto & manager) {
+      double cutoff{manager->get_cutoff()};
+      std::vector<std::vector<double>> distances{};
+      for (auto atom : manager) {
+        auto position{manager->get_position(atom.get_atom_tag())};
+        distances.emplace_back();
+        for (auto pair : atom) {
+          double distance{(position - pair.get_position()).norm()};
+          if (distance <= cutoff) {
+            distances.back().push_back(distance);
+          }
+        }
+        std::sort(distances.back().begin(), distances.back().end());
+      }
+      return distances;
+    };
+    auto distances_ref{get_distances(managers_no_skin)};
+    for (auto & manager : {managers_small_skin, managers_skin}) {
+      auto distances{get_distances(manager)};
+      BOOST_CHECK_EQUAL(distances.size(), distances_ref.size());
+      for (size_t i_center{0}; i_center < distances.size(); ++i_center) {
+        BOOST_CHECK_EQUAL(distances[i_center].size(),
+                          distances_ref[i_center].size());
+        for (size_t i_neigh{0}; i_neigh < distances[i_center].size();
+             ++i_neigh) {
+          BOOST_CHECK_CLOSE(distances[i_center][i_neigh],
+                            distances_ref[i_center][i_neigh], 1e-10);
+        }
+      }
+    }
   }
 
   /* ---------------------------------------------------------------------- */
@@ -213,6 +246,59 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /*
+   * test that the neighbours of each center are sorted and within cutoff +
+   * skin, and that they contain all the atoms and ghosts within the cutoff
+   * by comparing with a brute force search
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_neighbour_brute_force, Fix,
+                                   multiple_fixtures, Fix) {
+    auto & managers = Fix::managers;
+
+    for (auto & pair_manager : managers) {
+      double cutoff{pair_manager->get_cutoff()};
+      double cutoff_skin{cutoff + std::sqrt(pair_manager->get_skin2())};
+      size_t n_atoms{pair_manager->get_previous_manager()->get_n_atoms()};
+      size_t n_potential_neighbours{
+          n_atoms +
+          static_cast<size_t>(pair_manager->get_ghost_positions().cols())};
+
+      for (auto atom : pair_manager) {
+        int atom_tag{atom.get_atom_tag()};
+        auto position{pair_manager->get_position(atom_tag)};
+        std::vector<int> neighbours{};
+        std::vector<int> neighbours_in_cutoff{};
+        for (auto pair : atom) {
+          int neigh_tag{pair.get_atom_tag()};
+          double distance{(position - pair.get_position()).norm()};
+          BOOST_CHECK_LE(distance, cutoff_skin);
+          neighbours.push_back(neigh_tag);
+          if (distance <= cutoff) {
+            neighbours_in_cutoff.push_back(neigh_tag);
+          }
+        }
+        BOOST_CHECK(std::is_sorted(neighbours.begin(), neighbours.end()));
+
+        std::vector<int> neighbours_ref{};
+        for (size_t neigh_tag{0}; neigh_tag < n_potential_neighbours;
+             ++neigh_tag) {
+          if (static_cast<int>(neigh_tag) == atom_tag) {
+            continue;
+          }
+          double distance{
+              (position - pair_manager->get_position(neigh_tag)).norm()};
+          if (distance <= cutoff) {
+            neighbours_ref.push_back(static_cast<int>(neigh_tag));
+          }
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            neighbours_in_cutoff.begin(), neighbours_in_cutoff.end(),
+            neighbours_ref.begin(), neighbours_ref.end());
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /*
    * test if two differently defined 2-atom units cells of hcp crystal structure
@@ -528,5 +614,194 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /*
+   * test that the multithreaded build gives the same ghost atoms and the
+   * same neighbours in the same order as the serial one
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(parallel_build_test, Fix, multiple_fixtures,
+                                   Fix) {
+    auto & managers = Fix::managers;
+
+    for (auto & pair_manager : managers) {
+      auto manager{pair_manager->get_previous_manager()};
+      auto pair_manager_parallel{make_adapted_manager<AdaptorNeighbourList>(
+          manager, pair_manager->get_cutoff(),
+          pair_manager->get_consider_ghost_neighbours(),
+          std::sqrt(pair_manager->get_skin2()))};
+      pair_manager_parallel->set_n_threads(4);
+      pair_manager_parallel->update();
+
+      BOOST_CHECK_EQUAL(pair_manager->get_nb_clusters(2),
+                        pair_manager_parallel->get_nb_clusters(2));
+      BOOST_CHECK_EQUAL(pair_manager->get_ghost_positions().cols(),
+                        pair_manager_parallel->get_ghost_positions().cols());
+      std::vector<int> neighbours{};
+      for (auto atom : pair_manager->with_ghosts()) {
+        for (auto pair : atom) {
+          neighbours.push_back(pair.get_atom_tag());
+        }
+      }
+      std::vector<int> neighbours_parallel{};
+      for (auto atom : pair_manager_parallel->with_ghosts()) {
+        for (auto pair : atom) {
+          neighbours_parallel.push_back(pair.get_atom_tag());
+        }
+      }
+      BOOST_CHECK_EQUAL_COLLECTIONS(
+          neighbours.begin(), neighbours.end(), neighbours_parallel.begin(),
+          neighbours_parallel.end());
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /*
+   * Small cells with a large cutoff are handled by comparing the periodic
+   * images directly with the centers (see make_neighbour_list_from_images),
+   * test that it finds the same neighbours as the cell list (which is always
+   * used when the ghost atoms are centers), that the ghosts are images of
+   * the atoms of the cell by their lattice shift and that there is no more
+   * ghost than pairs.
+   */
+  BOOST_AUTO_TEST_CASE(small_cell_images_test) {
+    const std::vector<std::string> filenames{
+        "reference_data/diamond_2atom.json",
+        "reference_data/SiC_moissanite.json"};
+    const std::vector<double> cutoffs{{2., 4., 6.}};
+
+    auto get_distances = [](auto & manager) {
+      std::vector<std::vector<double>> distances{};
+      for (auto atom : manager) {
+        auto position{manager->get_position(atom.get_atom_tag())};
+        distances.emplace_back();
+        for (auto pair : atom) {
+          distances.back().push_back((position - pair.get_position()).norm());
+        }
+        std::sort(distances.back().begin(), distances.back().end());
+      }
+      return distances;
+    };
+
+    for (auto & filename : filenames) {
+      for (auto & cutoff : cutoffs) {
+        auto manager{make_structure_manager<StructureManagerCenters>()};
+        manager->update(filename);
+        auto cell{manager->get_cell()};
+
+        auto pair_manager{
+            make_adapted_manager<AdaptorNeighbourList>(manager, cutoff)};
+        pair_manager->update();
+        auto pair_manager_ref{
+            make_adapted_manager<AdaptorNeighbourList>(manager, cutoff, true)};
+        pair_manager_ref->update();
+
+        auto distances{get_distances(pair_manager)};
+        auto distances_ref{get_distances(pair_manager_ref)};
+        BOOST_CHECK_EQUAL(distances.size(), distances_ref.size());
+        for (size_t i_center{0}; i_center < distances.size(); ++i_center) {
+          BOOST_CHECK_EQUAL(distances[i_center].size(),
+                            distances_ref[i_center].size());
+          for (size_t i_neigh{0}; i_neigh < distances[i_center].size();
+               ++i_neigh) {
+            BOOST_CHECK_CLOSE(distances[i_center][i_neigh],
+                              distances_ref[i_center][i_neigh], 1e-10);
+          }
+        }
+
+        size_t n_atoms{manager->get_n_atoms()};
+        size_t n_ghosts{
+            static_cast<size_t>(pair_manager->get_ghost_positions().cols())};
+        BOOST_CHECK_LE(n_ghosts, pair_manager->get_nb_clusters(2));
+        for (size_t atom_tag{n_atoms}; atom_tag < n_atoms + n_ghosts;
+             ++atom_tag) {
+          auto image_tag{pair_manager->get_image_atom_tag(atom_tag)};
+          auto shift{pair_manager->get_lattice_shift(atom_tag)};
+          Eigen::Vector3d position{manager->get_position(image_tag) +
+                                   cell * shift.cast<double>()};
+          BOOST_CHECK_LE((position - pair_manager->get_position(atom_tag))
+                             .lpNorm<Eigen::Infinity>(),
+                         1e-10);
+        }
+
+        // the images of a small cell are every one a neighbour
+        std::set<int> ghost_neighbours{};
+        for (auto atom : pair_manager) {
+          for (auto pair : atom) {
+            if (pair.get_atom_tag() >= static_cast<int>(n_atoms)) {
+              ghost_neighbours.insert(pair.get_atom_tag());
+            }
+          }
+        }
+        BOOST_CHECK_EQUAL(ghost_neighbours.size(), n_ghosts);
+
+        // the centers are split over the threads without changing the list
+        auto pair_manager_parallel{
+            make_adapted_manager<AdaptorNeighbourList>(manager, cutoff)};
+        pair_manager_parallel->set_n_threads(3);
+        pair_manager_parallel->update();
+        BOOST_CHECK_EQUAL(
+            pair_manager_parallel->get_ghost_positions().cols(),
+            pair_manager->get_ghost_positions().cols());
+        std::vector<int> neighbours{}, neighbours_parallel{};
+        for (auto atom : pair_manager) {
+          for (auto pair : atom) {
+            neighbours.push_back(pair.get_atom_tag());
+          }
+        }
+        for (auto atom : pair_manager_parallel) {
+          for (auto pair : atom) {
+            neighbours_parallel.push_back(pair.get_atom_tag());
+          }
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            neighbours.begin(), neighbours.end(), neighbours_parallel.begin(),
+            neighbours_parallel.end());
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /*
+   * A cell of a few hundred atoms that is a few cutoffs wide has tens of
+   * thousands of images: it has to go through the cell list, which creates
+   * the ghosts of the whole mesh including the ones that are no neighbour of
+   * any center, rather than comparing every image with every center.
+   */
+  BOOST_AUTO_TEST_CASE(medium_cell_list_test) {
+    const int n_atoms{200};
+    const double length{12.6}, cutoff{5.};
+    std::mt19937 generator{11};
+    std::uniform_real_distribution<double> distribution{0., length};
+    Eigen::Matrix<double, 3, Eigen::Dynamic> positions(3, n_atoms);
+    for (int i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      for (int i_dim{0}; i_dim < 3; ++i_dim) {
+        positions(i_dim, i_atom) = distribution(generator);
+      }
+    }
+    Eigen::VectorXi atom_types{Eigen::VectorXi::Constant(n_atoms, 14)};
+    Eigen::Matrix3d cell{length * Eigen::Matrix3d::Identity()};
+    Eigen::Vector3i pbc{Eigen::Vector3i::Ones()};
+    AtomicStructure<3> structure{};
+    structure.set_structure(positions, atom_types, cell, pbc);
+
+    auto manager{make_structure_manager<StructureManagerCenters>()};
+    manager->update(structure);
+    auto pair_manager{
+        make_adapted_manager<AdaptorNeighbourList>(manager, cutoff)};
+    pair_manager->update();
+
+    std::set<int> ghost_neighbours{};
+    for (auto atom : pair_manager) {
+      for (auto pair : atom) {
+        if (pair.get_atom_tag() >= n_atoms) {
+          ghost_neighbours.insert(pair.get_atom_tag());
+        }
+      }
+    }
+    size_t n_ghosts{
+        static_cast<size_t>(pair_manager->get_ghost_positions().cols())};
+    BOOST_CHECK_GT(n_ghosts, ghost_neighbours.size());
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
@@ -295,6 +295,96 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the contiguous distances and direction vectors match the ones
+   * accessed pair by pair and that the neighbours of a center are contiguous
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(contiguous_pair_storage_test, Fix,
+                                   multiple_fixtures, Fix) {
+    auto & managers = Fix::managers;
+
+    for (auto & pair_manager : managers) {
+      double cutoff{pair_manager->get_cutoff()};
+      auto adaptor_strict{
+          make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+      adaptor_strict->update();
+
+      auto distances{adaptor_strict->get_distances()};
+      auto direction_vectors{adaptor_strict->get_direction_vectors()};
+      BOOST_CHECK_EQUAL(distances.size(), adaptor_strict->get_nb_clusters(2));
+      BOOST_CHECK_EQUAL(direction_vectors.cols(),
+                        adaptor_strict->get_nb_clusters(2));
+
+      size_t pair_index{0};
+      for (auto center : adaptor_strict) {
+        for (auto neigh : center.with_self_pair()) {
+          BOOST_CHECK_EQUAL(neigh.get_global_index(), pair_index);
+          BOOST_CHECK_EQUAL(distances(pair_index),
+                            adaptor_strict->get_distance(neigh));
+          auto && dir_vec{adaptor_strict->get_direction_vector(neigh)};
+          for (int i_dim{0}; i_dim < 3; ++i_dim) {
+            BOOST_CHECK_EQUAL(direction_vectors(i_dim, pair_index),
+                              dir_vec(i_dim));
+          }
+          ++pair_index;
+        }
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the multithreaded update gives the same pairs, in the same
+   * order, with the same distances and direction vectors as the serial one
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(parallel_update_test, Fix,
+                                   multiple_fixtures, Fix) {
+    auto & managers = Fix::managers;
+
+    for (auto & pair_manager : managers) {
+      double cutoff{pair_manager->get_cutoff()};
+      auto adaptor_strict{
+          make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+      adaptor_strict->update();
+      auto adaptor_strict_parallel{
+          make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+      adaptor_strict_parallel->set_n_threads(4);
+      adaptor_strict_parallel->update();
+
+      BOOST_CHECK_EQUAL(adaptor_strict->get_nb_clusters(2),
+                        adaptor_strict_parallel->get_nb_clusters(2));
+      auto neighbours{adaptor_strict->get_neighbours_atom_tag()};
+      auto neighbours_parallel{
+          adaptor_strict_parallel->get_neighbours_atom_tag()};
+      BOOST_CHECK_EQUAL_COLLECTIONS(
+          neighbours.begin(), neighbours.end(), neighbours_parallel.begin(),
+          neighbours_parallel.end());
+      auto distances{adaptor_strict->get_distances()};
+      auto distances_parallel{adaptor_strict_parallel->get_distances()};
+      auto direction_vectors{adaptor_strict->get_direction_vectors()};
+      auto direction_vectors_parallel{
+          adaptor_strict_parallel->get_direction_vectors()};
+      size_t n_pairs{std::min(neighbours.size(), neighbours_parallel.size())};
+      for (size_t i_pair{0}; i_pair < n_pairs; ++i_pair) {
+        BOOST_CHECK_EQUAL(distances(i_pair), distances_parallel(i_pair));
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          BOOST_CHECK_EQUAL(direction_vectors(i_dim, i_pair),
+                            direction_vectors_parallel(i_dim, i_pair));
+        }
+      }
+
+      size_t pair_index{0};
+      for (auto center : adaptor_strict_parallel) {
+        for (auto neigh : center.with_self_pair()) {
+          BOOST_CHECK_EQUAL(neigh.get_global_index(), pair_index);
+          ++pair_index;
+        }
+      }
+      BOOST_CHECK_EQUAL(pair_index, adaptor_strict->get_nb_clusters(2));
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   // using Fixtures_no_center = boost::mpl::list<
   //     MultipleStructureFixture<MultipleStructureManagerNLCCFixtureCenterMask>,
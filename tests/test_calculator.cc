@@ -28,6 +28,8 @@
 #include "tests.hh"
 #include "test_calculator.hh"
 #include "test_math.hh"  // for the gradient test
+#include "test_manager_collection.hh"
+#include "representations/feature_stream.hh"
 
 namespace rascal {
   BOOST_AUTO_TEST_SUITE(representation_test);
@@ -82,6 +84,17 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the stacks with AdaptorStrict on top, and only those, provide
+   * the distances and direction vectors read by the spherical expansion
+   */
+  BOOST_AUTO_TEST_CASE(pair_geometry_test) {
+    using NeighbourList_t = AdaptorNeighbourList<StructureManagerCenters>;
+    using Strict_t = AdaptorStrict<AdaptorCenterContribution<NeighbourList_t>>;
+    BOOST_CHECK(not internal::HasPairGeometry<NeighbourList_t>::value);
+    BOOST_CHECK(internal::HasPairGeometry<Strict_t>::value);
+  }
+
   /* ---------------------------------------------------------------------- */
 
   using multiple_fixtures =
@@ -180,6 +193,54 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the sparse feature matrix of a managerCollection has the
+   * entries of the dense one and only stores the features of each center
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multiple_sparse_feature_comparison, Fix,
+                                   multiple_fixtures, Fix) {
+    using ManagerCollection_t =
+        typename TypeHolderInjector<ManagerCollection,
+                                    typename Fix::ManagerTypeList_t>::type;
+
+    auto & managers = Fix::managers;
+    auto & representations = Fix::representations;
+    auto & representation_hypers = Fix::representation_hypers;
+    for (auto & hyper : representation_hypers) {
+      representations.emplace_back(hyper);
+      ManagerCollection_t collection{};
+      for (auto & manager : managers) {
+        representations.back().compute(manager);
+        collection.add_structure(manager);
+      }
+      math::Matrix_t feat_dense =
+          collection.get_dense_feature_matrix(representations.back());
+      math::SparseMatrix_t feat_sparse =
+          collection.get_sparse_feature_matrix(representations.back());
+
+      BOOST_CHECK(feat_sparse.isCompressed());
+      BOOST_CHECK_EQUAL(feat_sparse.rows(), feat_dense.rows());
+      BOOST_CHECK_EQUAL(feat_sparse.cols(), feat_dense.cols());
+      BOOST_CHECK_LE(feat_sparse.nonZeros(), feat_dense.size());
+      BOOST_CHECK_EQUAL(
+          (math::Matrix_t(feat_sparse) - feat_dense).cwiseAbs().maxCoeff(), 0.);
+      // the columns of each row are sorted as required by the CSR format
+      for (int i_row{0}; i_row < feat_sparse.rows(); ++i_row) {
+        auto first{feat_sparse.innerIndexPtr() +
+                   feat_sparse.outerIndexPtr()[i_row]};
+        auto last{feat_sparse.innerIndexPtr() +
+                  feat_sparse.outerIndexPtr()[i_row + 1]};
+        BOOST_CHECK(std::is_sorted(first, last));
+      }
+      // there is no manager to find the features in
+      ManagerCollection_t empty_collection{};
+      BOOST_CHECK_THROW(
+          empty_collection.get_sparse_feature_matrix(representations.back()),
+          std::runtime_error);
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the compute function runs
@@ -197,6 +258,112 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that computing a ManagerCollection with several threads gives
+   * exactly the same features as the serial computation, also when the
+   * calculator computes a second collection with the copies it kept for its
+   * threads
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multiple_threaded_compute_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using ManagerCollection_t =
+        typename TypeHolderInjector<ManagerCollection,
+                                    typename Fix::ManagerTypeList_t>::type;
+    using Representation_t = typename Fix::Representation_t;
+
+    auto & factory_args = Fix::factory_args;
+    auto & representation_hypers = Fix::representation_hypers;
+    for (auto & hyper : representation_hypers) {
+      Representation_t representation_serial{hyper};
+      Representation_t representation_threaded{hyper};
+      representation_threaded.set_n_threads(3);
+
+      for (int i_compute{0}; i_compute < 2; ++i_compute) {
+        ManagerCollection_t collection_serial{};
+        ManagerCollection_t collection_threaded{};
+        for (auto & factory_arg : factory_args) {
+          collection_serial.add_structure(factory_arg["structure"],
+                                          factory_arg["adaptors"]);
+          collection_threaded.add_structure(factory_arg["structure"],
+                                            factory_arg["adaptors"]);
+        }
+        representation_serial.compute(collection_serial);
+        representation_threaded.compute(collection_threaded);
+
+        math::Matrix_t feat_serial =
+            collection_serial.get_dense_feature_matrix(representation_serial);
+        math::Matrix_t feat_threaded =
+            collection_threaded.get_dense_feature_matrix(
+                representation_threaded);
+
+        BOOST_REQUIRE_EQUAL(feat_serial.rows(), feat_threaded.rows());
+        BOOST_REQUIRE_EQUAL(feat_serial.cols(), feat_threaded.cols());
+        BOOST_CHECK((feat_serial.array() == feat_threaded.array()).all());
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that splitting the centers of a single structure over several
+   * threads gives exactly the same features as the serial computation, also
+   * when the calculator computes another structure with the copies it kept
+   * for its threads
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multiple_threaded_centers_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using ManagerTypeList_t = typename Fix::ManagerTypeList_t;
+    using Property_t = typename Fix::Property_t;
+    using Representation_t = typename Fix::Representation_t;
+
+    auto & managers = Fix::managers;
+    auto & factory_args = Fix::factory_args;
+    auto & representation_hypers = Fix::representation_hypers;
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      auto & manager = managers[i_manager];
+      auto & factory_arg = factory_args[i_manager];
+      auto manager_threaded{
+          make_structure_manager_stack_with_hypers_and_typeholder<
+              ManagerTypeList_t>::apply(factory_arg["structure"],
+                                        factory_arg["adaptors"])};
+      for (auto & hyper : representation_hypers) {
+        Representation_t representation_serial{hyper};
+        representation_serial.compute(manager);
+
+        Representation_t representation_threaded{hyper};
+        representation_threaded.set_n_threads(3);
+        representation_threaded.compute(manager_threaded);
+
+        auto & prop_serial =
+            manager->template get_validated_property_ref<Property_t>(
+                representation_serial.get_name());
+        auto & prop_threaded =
+            manager_threaded->template get_validated_property_ref<Property_t>(
+                representation_threaded.get_name());
+        math::Matrix_t feat_serial = prop_serial.get_dense_feature_matrix();
+        math::Matrix_t feat_threaded = prop_threaded.get_dense_feature_matrix();
+
+        BOOST_REQUIRE_EQUAL(feat_serial.rows(), feat_threaded.rows());
+        BOOST_REQUIRE_EQUAL(feat_serial.cols(), feat_threaded.cols());
+        BOOST_CHECK((feat_serial.array() == feat_threaded.array()).all());
+
+        auto manager_again{
+            make_structure_manager_stack_with_hypers_and_typeholder<
+                ManagerTypeList_t>::apply(factory_arg["structure"],
+                                          factory_arg["adaptors"])};
+        representation_threaded.compute(manager_again);
+        auto & prop_again =
+            manager_again->template get_validated_property_ref<Property_t>(
+                representation_threaded.get_name());
+        math::Matrix_t feat_again = prop_again.get_dense_feature_matrix();
+        BOOST_REQUIRE_EQUAL(feat_serial.rows(), feat_again.rows());
+        BOOST_REQUIRE_EQUAL(feat_serial.cols(), feat_again.cols());
+        BOOST_CHECK((feat_serial.array() == feat_again.array()).all());
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the no center option takes out the centers
@@ -448,6 +615,462 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the gradients computed with the centers split over several
+   * threads are exactly the same as the serial ones
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_representation_threaded_gradients,
+                                   Fix, simple_periodic_fixtures, Fix) {
+    using ManagerTypeList_t = typename Fix::ManagerTypeList_t;
+    using Representation_t = typename Fix::Representation_t;
+    using PropGrad_t = typename Representation_t::template PropertyGradient_t<
+        typename Fix::Manager_t>;
+
+    auto & managers = Fix::managers;
+    auto & factory_args = Fix::factory_args;
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      auto & manager = managers[i_manager];
+      auto & factory_arg = factory_args[i_manager];
+      auto manager_threaded{
+          make_structure_manager_stack_with_hypers_and_typeholder<
+              ManagerTypeList_t>::apply(factory_arg["structure"],
+                                        factory_arg["adaptors"])};
+      for (auto hyper : Fix::representation_hypers) {
+        hyper["compute_gradients"] = true;
+        Representation_t representation_serial{hyper};
+        representation_serial.compute(manager);
+
+        Representation_t representation_threaded{hyper};
+        representation_threaded.set_n_threads(3);
+        representation_threaded.compute(manager_threaded);
+
+        auto & grad_serial =
+            manager->template get_validated_property_ref<PropGrad_t>(
+                representation_serial.get_gradient_name());
+        auto & grad_threaded =
+            manager_threaded->template get_validated_property_ref<PropGrad_t>(
+                representation_threaded.get_gradient_name());
+        math::Matrix_t feat_serial = grad_serial.get_dense_feature_matrix();
+        math::Matrix_t feat_threaded = grad_threaded.get_dense_feature_matrix();
+
+        BOOST_REQUIRE_EQUAL(feat_serial.rows(), feat_threaded.rows());
+        BOOST_REQUIRE_EQUAL(feat_serial.cols(), feat_threaded.cols());
+        BOOST_CHECK((feat_serial.array() == feat_threaded.array()).all());
+      }
+    }
+  }
+
+  using spherical_expansion_fixtures =
+      boost::mpl::list<CalculatorFixture<SingleHypersSphericalExpansion>>;
+
+  /**
+   * Test that the spherical expansion (and its gradient) computed with the
+   * splined radial integral matches the one computed with the GTO radial
+   * integral it tabulates
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_expansion_spline_test, Fix,
+                                   spherical_expansion_fixtures, Fix) {
+    using ManagerTypeList_t = typename Fix::ManagerTypeList_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Prop_t =
+        typename Representation_t::template Property_t<typename Fix::Manager_t>;
+    using PropGrad_t = typename Representation_t::template PropertyGradient_t<
+        typename Fix::Manager_t>;
+
+    auto & managers = Fix::managers;
+    auto & factory_args = Fix::factory_args;
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      auto & manager = managers[i_manager];
+      auto & factory_arg = factory_args[i_manager];
+      auto manager_spline{
+          make_structure_manager_stack_with_hypers_and_typeholder<
+              ManagerTypeList_t>::apply(factory_arg["structure"],
+                                        factory_arg["adaptors"])};
+      for (auto hyper : Fix::representation_hypers) {
+        hyper["compute_gradients"] = true;
+        Representation_t representation_gto{hyper};
+        representation_gto.compute(manager);
+
+        hyper["radial_contribution"] = {
+            {"type", "Spline"}, {"basis", "GTO"}, {"accuracy", 1e-10}};
+        Representation_t representation_spline{hyper};
+        representation_spline.compute(manager_spline);
+
+        auto & prop_gto = manager->template get_validated_property_ref<Prop_t>(
+            representation_gto.get_name());
+        auto & prop_spline =
+            manager_spline->template get_validated_property_ref<Prop_t>(
+                representation_spline.get_name());
+        math::Matrix_t feat_gto = prop_gto.get_dense_feature_matrix();
+        math::Matrix_t feat_spline = prop_spline.get_dense_feature_matrix();
+        BOOST_REQUIRE_EQUAL(feat_gto.rows(), feat_spline.rows());
+        BOOST_REQUIRE_EQUAL(feat_gto.cols(), feat_spline.cols());
+        double diff{(feat_gto - feat_spline).cwiseAbs().maxCoeff() /
+                    feat_gto.cwiseAbs().maxCoeff()};
+        BOOST_CHECK_LE(diff, 1e-10);
+
+        auto & grad_gto =
+            manager->template get_validated_property_ref<PropGrad_t>(
+                representation_gto.get_gradient_name());
+        auto & grad_spline =
+            manager_spline->template get_validated_property_ref<PropGrad_t>(
+                representation_spline.get_gradient_name());
+        math::Matrix_t feat_grad_gto = grad_gto.get_dense_feature_matrix();
+        math::Matrix_t feat_grad_spline =
+            grad_spline.get_dense_feature_matrix();
+        BOOST_REQUIRE_EQUAL(feat_grad_gto.rows(), feat_grad_spline.rows());
+        BOOST_REQUIRE_EQUAL(feat_grad_gto.cols(), feat_grad_spline.cols());
+        double diff_grad{
+            (feat_grad_gto - feat_grad_spline).cwiseAbs().maxCoeff() /
+            feat_grad_gto.cwiseAbs().maxCoeff()};
+        BOOST_CHECK_LE(diff_grad, 1e-7);
+      }
+    }
+  }
+
+  /**
+   * Same as above for the DVR radial integral (without gradients since they
+   * are not implemented for DVR)
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_expansion_spline_dvr_test, Fix,
+                                   spherical_expansion_fixtures, Fix) {
+    using ManagerTypeList_t = typename Fix::ManagerTypeList_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Prop_t =
+        typename Representation_t::template Property_t<typename Fix::Manager_t>;
+
+    auto & managers = Fix::managers;
+    auto & factory_args = Fix::factory_args;
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      auto & manager = managers[i_manager];
+      auto & factory_arg = factory_args[i_manager];
+      auto manager_spline{
+          make_structure_manager_stack_with_hypers_and_typeholder<
+              ManagerTypeList_t>::apply(factory_arg["structure"],
+                                        factory_arg["adaptors"])};
+      for (auto hyper : Fix::representation_hypers) {
+        // the recursions of the DVR radial integral need max_angular > 0
+        if (hyper["max_angular"].template get<int>() == 0) {
+          continue;
+        }
+        hyper["compute_gradients"] = false;
+        hyper["radial_contribution"] = {{"type", "DVR"}};
+        Representation_t representation_dvr{hyper};
+        representation_dvr.compute(manager);
+
+        hyper["radial_contribution"] = {
+            {"type", "Spline"}, {"basis", "DVR"}, {"accuracy", 1e-8}};
+        Representation_t representation_spline{hyper};
+        representation_spline.compute(manager_spline);
+
+        auto & prop_dvr = manager->template get_validated_property_ref<Prop_t>(
+            representation_dvr.get_name());
+        auto & prop_spline =
+            manager_spline->template get_validated_property_ref<Prop_t>(
+                representation_spline.get_name());
+        math::Matrix_t feat_dvr = prop_dvr.get_dense_feature_matrix();
+        math::Matrix_t feat_spline = prop_spline.get_dense_feature_matrix();
+        BOOST_REQUIRE_EQUAL(feat_dvr.rows(), feat_spline.rows());
+        BOOST_REQUIRE_EQUAL(feat_dvr.cols(), feat_spline.cols());
+        double diff{(feat_dvr - feat_spline).cwiseAbs().maxCoeff() /
+                    feat_dvr.cwiseAbs().maxCoeff()};
+        BOOST_CHECK_LE(diff, 1e-8);
+      }
+    }
+  }
+
+  /**
+   * Check that evaluating only one of the ij- and ji-pairs and using the
+   * parity of the spherical harmonics for the other one gives the same
+   * expansion and gradients as evaluating every pair, also when the centers
+   * are split over threads (the structures are periodic so the reverse of a
+   * pair is often a pair with a ghost atom)
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_expansion_pair_parity_test, Fix,
+                                   spherical_expansion_fixtures, Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Prop_t =
+        typename Representation_t::template Property_t<typename Fix::Manager_t>;
+    using PropGrad_t = typename Representation_t::template PropertyGradient_t<
+        typename Fix::Manager_t>;
+
+    auto & managers = Fix::managers;
+    for (auto & manager : managers) {
+      // every atom is a center so every pair has a reverse
+      internal::ReversePairs reverse_pairs{};
+      reverse_pairs.update(*manager);
+      size_t n_evaluated{0};
+      for (size_t i_pair{0}; i_pair < reverse_pairs.get_nb_pairs(); ++i_pair) {
+        BOOST_CHECK(reverse_pairs.get_reverse(i_pair) !=
+                    reverse_pairs.NoReverse);
+        n_evaluated += reverse_pairs.is_evaluated(i_pair);
+      }
+      BOOST_CHECK_EQUAL(2 * n_evaluated, reverse_pairs.get_nb_pairs());
+      BOOST_CHECK_EQUAL(n_evaluated, reverse_pairs.get_nb_shared_pairs());
+      for (size_t i_pair{0}; i_pair < reverse_pairs.get_nb_pairs(); ++i_pair) {
+        BOOST_CHECK_EQUAL(reverse_pairs.get_shared_index(i_pair),
+                          reverse_pairs.get_shared_index(
+                              reverse_pairs.get_reverse(i_pair)));
+      }
+
+      for (auto hyper : Fix::representation_hypers) {
+        hyper["compute_gradients"] = true;
+        Representation_t representation_full{hyper};
+        representation_full.compute(manager);
+
+        for (size_t n_threads : {1, 2}) {
+          hyper["use_pair_parity"] = true;
+          Representation_t representation_half{hyper};
+          representation_half.set_n_threads(n_threads);
+          representation_half.compute(manager);
+
+          auto & prop_full =
+              manager->template get_validated_property_ref<Prop_t>(
+                  representation_full.get_name());
+          auto & prop_half =
+              manager->template get_validated_property_ref<Prop_t>(
+                  representation_half.get_name());
+          math::Matrix_t feat_full = prop_full.get_dense_feature_matrix();
+          math::Matrix_t feat_half = prop_half.get_dense_feature_matrix();
+          BOOST_REQUIRE_EQUAL(feat_full.rows(), feat_half.rows());
+          BOOST_REQUIRE_EQUAL(feat_full.cols(), feat_half.cols());
+          double diff{(feat_full - feat_half).cwiseAbs().maxCoeff() /
+                      feat_full.cwiseAbs().maxCoeff()};
+          BOOST_CHECK_LE(diff, 10 * math::dbl_ftol);
+
+          auto & grad_full =
+              manager->template get_validated_property_ref<PropGrad_t>(
+                  representation_full.get_gradient_name());
+          auto & grad_half =
+              manager->template get_validated_property_ref<PropGrad_t>(
+                  representation_half.get_gradient_name());
+          math::Matrix_t feat_grad_full = grad_full.get_dense_feature_matrix();
+          math::Matrix_t feat_grad_half = grad_half.get_dense_feature_matrix();
+          BOOST_REQUIRE_EQUAL(feat_grad_full.rows(), feat_grad_half.rows());
+          BOOST_REQUIRE_EQUAL(feat_grad_full.cols(), feat_grad_half.cols());
+          double diff_grad{
+              (feat_grad_full - feat_grad_half).cwiseAbs().maxCoeff() /
+              feat_grad_full.cwiseAbs().maxCoeff()};
+          BOOST_CHECK_LE(diff_grad, 10 * math::dbl_ftol);
+        }
+      }
+    }
+  }
+
+  using bispectrum_fixtures =
+      boost::mpl::list<CalculatorFixture<MultipleStructureSphericalInvariants<
+          MultipleStructureManagerNLCCStrictFixture>>>;
+
+  /**
+   * Check the bispectrum computed with the sparse real couplings against a
+   * direct evaluation with the complex expansion coefficients and the
+   * Wigner 3j symbols
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_invariants_bispectrum_test, Fix,
+                                   bispectrum_fixtures, Fix) {
+    using Manager_t = typename Fix::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Prop_t = typename Representation_t::template Property_t<Manager_t>;
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<Manager_t>;
+    using complex = std::complex<double>;
+
+    // complex coefficient from the real ones, see spherical_harmonics.hh
+    auto complex_coefficient = [](const auto & coef, size_t n, size_t l,
+                                  int m) {
+      size_t lm{l * l + l + m}, lm_opposite{l * l + l - m};
+      if (m > 0) {
+        return std::pow(-1., m) * math::INV_SQRT_TWO *
+               complex{coef(n, lm), coef(n, lm_opposite)};
+      } else if (m == 0) {
+        return complex{coef(n, lm), 0.};
+      } else {
+        return math::INV_SQRT_TWO *
+               complex{coef(n, lm_opposite), -coef(n, lm)};
+      }
+    };
+
+    auto & managers = Fix::managers;
+    for (auto & manager : managers) {
+      for (auto hyper : Fix::representation_hypers) {
+        if (hyper["soap_type"] != "BiSpectrum") {
+          continue;
+        }
+        for (int max_angular : {1, 3}) {
+          hyper["max_angular"] = max_angular;
+          hyper["normalize"] = false;
+          Representation_t representation{hyper};
+          representation.compute(manager);
+          CalculatorSphericalExpansion expansion{hyper};
+          expansion.compute(manager);
+
+          auto & soap_vectors{
+              manager->template get_validated_property_ref<Prop_t>(
+                  representation.get_name())};
+          auto & expansions_coefficients{
+              manager->template get_validated_property_ref<PropExp_t>(
+                  expansion.get_name())};
+          size_t max_radial{hyper["max_radial"]};
+          bool inversion_symmetry{hyper["inversion_symmetry"]};
+
+          wig_table_init(2 * (max_angular + 1), 3);
+          wig_temp_init(2 * (max_angular + 1));
+          for (auto center : manager) {
+            auto & coefficients{expansions_coefficients[center]};
+            for (auto el : soap_vectors[center]) {
+              auto & triplet_type{el.first};
+              auto & soap_vector_by_type{el.second};
+              auto coef1{coefficients[{triplet_type[0]}]};
+              auto coef2{coefficients[{triplet_type[1]}]};
+              auto coef3{coefficients[{triplet_type[2]}]};
+              double mult{1.};
+              if (triplet_type[0] == triplet_type[1] &&
+                  triplet_type[1] == triplet_type[2]) {
+                mult = 1.;
+              } else if (triplet_type[0] == triplet_type[1] ||
+                         triplet_type[0] == triplet_type[2] ||
+                         triplet_type[1] == triplet_type[2]) {
+                mult = std::sqrt(3.);
+              } else {
+                mult = std::sqrt(6.);
+              }
+
+              size_t nn{0};
+              for (size_t n1{0}; n1 < max_radial; ++n1) {
+                for (size_t n2{0}; n2 < max_radial; ++n2) {
+                  for (size_t n3{0}; n3 < max_radial; ++n3) {
+                    size_t l0{0};
+                    for (int l1{0}; l1 < max_angular + 1; ++l1) {
+                      for (int l2{0}; l2 < max_angular + 1; ++l2) {
+                        for (int l3{0}; l3 < max_angular + 1; ++l3) {
+                          if (l1 < std::abs(l2 - l3) or l1 > l2 + l3 or
+                              (inversion_symmetry and (l1 + l2 + l3) % 2)) {
+                            continue;
+                          }
+                          complex value{0.};
+                          for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+                            for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+                              int m3{-m1 - m2};
+                              if (std::abs(m3) > l3) {
+                                continue;
+                              }
+                              value += wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1,
+                                              2 * m2, 2 * m3) *
+                                       complex_coefficient(coef1, n1, l1, m1) *
+                                       complex_coefficient(coef2, n2, l2, m2) *
+                                       complex_coefficient(coef3, n3, l3, m3);
+                            }
+                          }
+                          double ref{mult * ((l1 + l2 + l3) % 2 == 0
+                                                 ? value.real()
+                                                 : value.imag())};
+                          BOOST_CHECK_SMALL(soap_vector_by_type(nn, l0) - ref,
+                                            100 * math::dbl_ftol);
+                          ++l0;
+                        }
+                      }
+                    }
+                    ++nn;
+                  }
+                }
+              }
+            }
+          }
+          wig_temp_free();
+          wig_table_free();
+        }
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the features computed chunk by chunk while streaming the
+   * structures of a file match the dense feature matrix of the collection of
+   * all the structures of the file
+   */
+  BOOST_FIXTURE_TEST_CASE(stream_dense_features_test,
+                          CollectionFixture<StrictNLCollectionFixture>) {
+    using ManagerCollection_t =
+        typename CollectionFixture<StrictNLCollectionFixture>::
+            ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Property_t = CalculatorSphericalInvariants::Property_t<Manager_t>;
+
+    json hypers{{"max_radial", 3},
+                {"max_angular", 2},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", 2.0}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    CalculatorSphericalInvariants representation{hypers};
+    representation.set_n_threads(0);
+
+    auto & collection{this->collections[0]};
+    auto & adaptors{this->factory_args[0]["adaptors"]};
+    collection.add_structures(this->filename);
+    representation.compute(collection);
+    math::Matrix_t ref_features{
+        collection.get_dense_feature_matrix(representation)};
+    // first row of the structures, sorted by id in the collection
+    auto ids{json_io::load(this->filename)["ids"].get<std::vector<int>>()};
+    std::sort(ids.begin(), ids.end());
+    std::map<int, size_t> ref_offsets{};
+    typename Property_t::Keys_t keys{};
+    size_t n_rows{0};
+    for (size_t i_structure{0}; i_structure < ids.size(); ++i_structure) {
+      auto && property{
+          collection[i_structure]
+              ->template get_validated_property_ref<Property_t>(
+                  representation.get_name())};
+      auto property_keys{property.get_keys()};
+      keys.insert(property_keys.begin(), property_keys.end());
+      ref_offsets[ids[i_structure]] = n_rows;
+      n_rows += property.size();
+    }
+
+    for (size_t n_threads : {1, 3}) {
+      size_t next_row{0}, n_structures{0};
+      auto n_streamed_rows{stream_dense_features<ManagerCollection_t>(
+          this->filename, adaptors, representation, keys, 7, n_threads,
+          [&](size_t first_row, const FeatureChunk & chunk,
+              const Eigen::Ref<const math::Matrix_t> & features) {
+            BOOST_CHECK_EQUAL(first_row, next_row);
+            BOOST_CHECK_LE(chunk.ids.size(), 7);
+            BOOST_REQUIRE_EQUAL(chunk.offsets.back(),
+                                static_cast<size_t>(features.rows()));
+            BOOST_REQUIRE_EQUAL(features.cols(), ref_features.cols());
+            for (size_t i_structure{0}; i_structure < chunk.ids.size();
+                 ++i_structure) {
+              size_t n_centers{chunk.offsets[i_structure + 1] -
+                               chunk.offsets[i_structure]};
+              auto && ref{ref_features.middleRows(
+                  ref_offsets.at(chunk.ids[i_structure]), n_centers)};
+              auto && streamed{
+                  features.middleRows(chunk.offsets[i_structure], n_centers)};
+              BOOST_CHECK_LE((ref - streamed).cwiseAbs().maxCoeff(), 1e-14);
+            }
+            next_row += features.rows();
+            n_structures += chunk.ids.size();
+          })};
+      BOOST_CHECK_EQUAL(n_streamed_rows, n_rows);
+      BOOST_CHECK_EQUAL(n_structures, ids.size());
+    }
+
+    // streamed in a preallocated matrix, the file being in the order of the
+    // ids
+    math::Matrix_t features(n_rows, ref_features.cols());
+    stream_dense_features_into<ManagerCollection_t>(
+        this->filename, adaptors, representation, keys, 50, 2, features);
+    BOOST_CHECK_LE((features - ref_features).cwiseAbs().maxCoeff(), 1e-14);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
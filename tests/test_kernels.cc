@@ -113,6 +113,501 @@ namespace rascal {
     }
   }
 
+  /**
+   * Tests that the kernels computed from the features grouped by key match
+   * the dot products between the properties of each pair of structures, also
+   * when the structure kernel is split into many tiles.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_key_blocks_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using Property_t = typename Fix::Property_t;
+    using internal::KernelType;
+    using internal::TargetType;
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+
+    for (auto & collection : collections) {
+      for (auto & representation : representations) {
+        auto && representation_name{representation.get_name()};
+        size_t n_centers{0};
+        for (auto & manager : collection) {
+          n_centers += manager->size();
+        }
+        math::Matrix_t ref_structure_kernel(collection.size(),
+                                            collection.size());
+        math::Matrix_t ref_atom_kernel(n_centers, n_centers);
+        size_t i_a{0}, i_center_a{0};
+        for (auto & manager_a : collection) {
+          auto && prop_a{
+              manager_a->template get_validated_property_ref<Property_t>(
+                  representation_name)};
+          size_t i_b{0}, i_center_b{0};
+          for (auto & manager_b : collection) {
+            auto && prop_b{
+                manager_b->template get_validated_property_ref<Property_t>(
+                    representation_name)};
+            math::Matrix_t dot{prop_a.dot(prop_b).array().square()};
+            ref_structure_kernel(i_a, i_b) = dot.mean();
+            ref_atom_kernel.block(i_center_a, i_center_b, dot.rows(),
+                                  dot.cols()) = dot;
+            ++i_b;
+            i_center_b += manager_b->size();
+          }
+          ++i_a;
+          i_center_a += manager_a->size();
+        }
+
+        internal::KernelImpl<KernelType::Cosine> kernel{json{{"zeta", 2}}};
+        // two distinct sets of managers have their own features
+        std::vector<typename Fix::ManagerCollection_t::ManagerPtr_t>
+            managers_a(collection.begin(), collection.end()),
+            managers_b(collection.begin(), collection.end());
+        for (size_t tile_size : {1, 20, 1024}) {
+          kernel.tile_rows = tile_size;
+          kernel.tile_cols = tile_size;
+          auto atom_kernel{
+              kernel.template compute<Property_t, TargetType::Atom>(
+                  collection, collection, representation_name)};
+          BOOST_CHECK_LE(
+              (atom_kernel - ref_atom_kernel).cwiseAbs().maxCoeff(), 1e-14);
+          auto structure_kernel{
+              kernel.template compute<Property_t, TargetType::Structure>(
+                  collection, collection, representation_name)};
+          BOOST_CHECK_LE(
+              (structure_kernel - ref_structure_kernel).cwiseAbs().maxCoeff(),
+              1e-14);
+          structure_kernel =
+              kernel.template compute<Property_t, TargetType::Structure>(
+                  managers_a, managers_b, representation_name);
+          BOOST_CHECK_LE(
+              (structure_kernel - ref_structure_kernel).cwiseAbs().maxCoeff(),
+              1e-14);
+        }
+      }
+    }
+  }
+
+  /**
+   * Tests the polynomial and gaussian kernels and the reductions of the
+   * center kernels to structure kernels against a direct evaluation from the
+   * dot products between the properties of each pair of structures, the
+   * gaussian kernel distributing its tiles over several threads.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_functions_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using Property_t = typename Fix::Property_t;
+    using internal::KernelType;
+    using internal::StructureReduction;
+    using internal::TargetType;
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+    double gamma{0.3}, coef0{0.7};
+
+    for (auto & collection : collections) {
+      for (auto & representation : representations) {
+        auto && representation_name{representation.get_name()};
+        size_t n_structures{collection.size()};
+        size_t n_centers{0};
+        for (auto & manager : collection) {
+          n_centers += manager->size();
+        }
+        math::Matrix_t dots(n_centers, n_centers);
+        std::vector<size_t> offsets{0};
+        size_t i_center_a{0};
+        for (auto & manager_a : collection) {
+          auto && prop_a{
+              manager_a->template get_validated_property_ref<Property_t>(
+                  representation_name)};
+          size_t i_center_b{0};
+          for (auto & manager_b : collection) {
+            auto && prop_b{
+                manager_b->template get_validated_property_ref<Property_t>(
+                    representation_name)};
+            math::Matrix_t dot{prop_a.dot(prop_b)};
+            dots.block(i_center_a, i_center_b, dot.rows(), dot.cols()) = dot;
+            i_center_b += manager_b->size();
+          }
+          i_center_a += manager_a->size();
+          offsets.push_back(i_center_a);
+        }
+        Eigen::VectorXd norms{dots.diagonal()};
+        math::Matrix_t ref_polynomial{
+            (gamma * dots.array() + coef0).pow(3).matrix()};
+        math::Matrix_t ref_gaussian(n_centers, n_centers);
+        for (size_t i_a{0}; i_a < n_centers; ++i_a) {
+          for (size_t i_b{0}; i_b < n_centers; ++i_b) {
+            ref_gaussian(i_a, i_b) = std::exp(
+                -gamma *
+                std::max(norms(i_a) + norms(i_b) - 2 * dots(i_a, i_b), 0.));
+          }
+        }
+        auto reduce = [&](const math::Matrix_t & center_kernel,
+                          StructureReduction reduction) {
+          math::Matrix_t kernel(n_structures, n_structures);
+          for (size_t i_a{0}; i_a < n_structures; ++i_a) {
+            for (size_t i_b{0}; i_b < n_structures; ++i_b) {
+              auto && pair_kernels{center_kernel.block(
+                  offsets[i_a], offsets[i_b], offsets[i_a + 1] - offsets[i_a],
+                  offsets[i_b + 1] - offsets[i_b])};
+              kernel(i_a, i_b) = (reduction == StructureReduction::Sum)
+                                     ? pair_kernels.sum()
+                                     : pair_kernels.mean();
+            }
+          }
+          if (reduction == StructureReduction::NormalizedAverage) {
+            Eigen::VectorXd scale{
+                kernel.diagonal().array().sqrt().inverse().matrix()};
+            kernel = scale.asDiagonal() * kernel * scale.asDiagonal();
+          }
+          return kernel;
+        };
+
+        internal::KernelImpl<KernelType::Polynomial> polynomial{json{
+            {"degree", 3}, {"gamma", gamma}, {"coef0", coef0}, {"tile_rows", 9},
+            {"tile_cols", 4}}};
+        internal::KernelImpl<KernelType::Gaussian> gaussian{
+            json{{"gamma", gamma},
+                 {"tile_rows", 9},
+                 {"tile_cols", 4},
+                 {"n_threads", 3}}};
+        auto atom_kernel{
+            polynomial.template compute<Property_t, TargetType::Atom>(
+                collection, collection, representation_name)};
+        BOOST_CHECK_LE((atom_kernel - ref_polynomial).cwiseAbs().maxCoeff() /
+                           ref_polynomial.cwiseAbs().maxCoeff(),
+                       1e-13);
+        atom_kernel = gaussian.template compute<Property_t, TargetType::Atom>(
+            collection, collection, representation_name);
+        BOOST_CHECK_LE((atom_kernel - ref_gaussian).cwiseAbs().maxCoeff(),
+                       1e-12);
+
+        for (auto reduction :
+             {StructureReduction::Average, StructureReduction::Sum,
+              StructureReduction::NormalizedAverage}) {
+          polynomial.reduction = reduction;
+          gaussian.reduction = reduction;
+          auto ref_kernel{reduce(ref_polynomial, reduction)};
+          auto structure_kernel{
+              polynomial.template compute<Property_t, TargetType::Structure>(
+                  collection, collection, representation_name)};
+          BOOST_CHECK_LE((structure_kernel - ref_kernel).cwiseAbs().maxCoeff() /
+                             ref_kernel.cwiseAbs().maxCoeff(),
+                         1e-13);
+          ref_kernel = reduce(ref_gaussian, reduction);
+          structure_kernel =
+              gaussian.template compute<Property_t, TargetType::Structure>(
+                  collection, collection, representation_name);
+          BOOST_CHECK_LE((structure_kernel - ref_kernel).cwiseAbs().maxCoeff() /
+                             ref_kernel.cwiseAbs().maxCoeff(),
+                         1e-12);
+          if (reduction == StructureReduction::NormalizedAverage) {
+            BOOST_CHECK_LE(
+                (structure_kernel.diagonal().array() - 1.).abs().maxCoeff(),
+                1e-12);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Tests that the tiles of rows streamed by compute_tiles cover the kernel
+   * in order and can be used to accumulate K^T K and K^T y.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_tiles_test, Fix, multiple_fixtures,
+                                   Fix) {
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+
+    for (auto & collection : collections) {
+      for (auto & representation : representations) {
+        for (auto hypers : Fix::ParentA::kernel_hypers) {
+          hypers["tile_rows"] = 7;
+          hypers["tile_cols"] = 5;
+          Kernel kernel(hypers);
+          auto mat = kernel.compute(representation, collection, collection);
+          math::Vector_t targets{math::Vector_t::Random(mat.rows())};
+          math::Matrix_t ref_ktk{mat.transpose() * mat};
+          math::Vector_t ref_kty{targets * mat};
+
+          math::Matrix_t ktk{math::Matrix_t::Zero(mat.cols(), mat.cols())};
+          math::Vector_t kty{math::Vector_t::Zero(mat.cols())};
+          size_t next_row{0};
+          kernel.compute_tiles(
+              representation, collection, collection,
+              [&](size_t first_row,
+                  const Eigen::Ref<const math::Matrix_t> & tile) {
+                BOOST_CHECK_EQUAL(first_row, next_row);
+                BOOST_CHECK_EQUAL(tile.cols(), mat.cols());
+                BOOST_CHECK_LE(
+                    (tile - mat.middleRows(first_row, tile.rows()))
+                        .cwiseAbs()
+                        .maxCoeff(),
+                    1e-14);
+                ktk += tile.transpose() * tile;
+                kty += targets.segment(first_row, tile.rows()) * tile;
+                next_row += tile.rows();
+              });
+          BOOST_CHECK_EQUAL(next_row, static_cast<size_t>(mat.rows()));
+          BOOST_CHECK_LE((ktk - ref_ktk).cwiseAbs().maxCoeff(), 1e-12);
+          BOOST_CHECK_LE((kty - ref_kty).cwiseAbs().maxCoeff(), 1e-12);
+        }
+      }
+    }
+  }
+
+  /**
+   * Tests that the features written to a FeatureStore give the same kernels
+   * as the ones of the managers and can be registered back in the managers.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_feature_store_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using Property_t = typename Fix::Property_t;
+    auto & kernels = Fix::kernels;
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+    const std::string filename{"feature_store_test.bin"};
+
+    for (auto & collection : collections) {
+      for (auto & representation : representations) {
+        auto && representation_name{representation.get_name()};
+        FeatureStore::write<Property_t>(filename, collection,
+                                        representation_name);
+        FeatureStore store{filename, representation_name};
+        BOOST_CHECK_EQUAL(store.get_n_structures(), collection.size());
+        BOOST_CHECK_EQUAL(store.get_name_hash(),
+                          FeatureStore::get_name_hash(representation_name));
+        BOOST_CHECK_THROW(FeatureStore(filename, representation_name + "a"),
+                          std::runtime_error);
+
+        for (auto & kernel : kernels) {
+          auto ref_mat = kernel.compute(representation, collection, collection);
+          auto mat = kernel.compute(store, store);
+          BOOST_CHECK_EQUAL(mat.rows(), ref_mat.rows());
+          BOOST_CHECK_EQUAL(mat.cols(), ref_mat.cols());
+          BOOST_CHECK_LE((mat - ref_mat).cwiseAbs().maxCoeff(), 1e-14);
+        }
+
+        auto ref_features =
+            collection.get_dense_feature_matrix(representation);
+        for (auto & manager : collection) {
+          manager->template get_property_ref<Property_t>(representation_name)
+              .clear();
+        }
+        store.fill_properties<Property_t>(collection);
+        auto features =
+            collection.get_dense_feature_matrix(representation);
+        BOOST_CHECK_EQUAL(features.rows(), ref_features.rows());
+        BOOST_CHECK_EQUAL(features.cols(), ref_features.cols());
+        BOOST_CHECK_EQUAL((features - ref_features).cwiseAbs().maxCoeff(), 0.);
+      }
+    }
+    std::remove(filename.c_str());
+  }
+
+  /**
+   * Tests that the features stored in single precision give the features and
+   * the kernels (and their derivatives) of the double precision ones up to
+   * the precision of float.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_single_precision_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using Calculator_t = typename Fix::Calculator_t;
+    using PropertySingle_t = typename Calculator_t::template PropertySingle_t<
+        typename Fix::Manager_t>;
+    auto & kernels = Fix::kernels;
+    auto & collections = Fix::collections;
+    const std::string filename{"feature_store_single_test.bin"};
+
+    for (auto & collection : collections) {
+      for (auto hyper : Fix::ParentB::representation_hypers) {
+        hyper["compute_gradients"] = true;
+        Calculator_t representation{hyper};
+        hyper["precision"] = "single";
+        Calculator_t representation_single{hyper};
+        BOOST_CHECK(representation_single.is_single_precision());
+        BOOST_CHECK(representation.get_name() !=
+                    representation_single.get_name());
+        representation.compute(collection);
+        representation_single.compute(collection);
+
+        auto features = collection.get_dense_feature_matrix(representation);
+        auto features_single =
+            collection.get_dense_feature_matrix(representation_single);
+        BOOST_CHECK_EQUAL(features.rows(), features_single.rows());
+        BOOST_CHECK_EQUAL(features.cols(), features_single.cols());
+        double scale{features.cwiseAbs().maxCoeff()};
+        BOOST_CHECK_LE(
+            (features - features_single).cwiseAbs().maxCoeff() / scale, 1e-6);
+        math::Matrix_t sparse_features{
+            collection.get_sparse_feature_matrix(representation_single)};
+        BOOST_CHECK_EQUAL(
+            (sparse_features - features_single).cwiseAbs().maxCoeff(), 0.);
+
+        for (auto & kernel : kernels) {
+          auto mat = kernel.compute(representation, collection, collection);
+          auto mat_single = kernel.compute(representation_single, collection,
+                                           collection);
+          BOOST_CHECK_EQUAL(mat.rows(), mat_single.rows());
+          BOOST_CHECK_EQUAL(mat.cols(), mat_single.cols());
+          double kernel_scale{std::max(mat.cwiseAbs().maxCoeff(), 1.)};
+          BOOST_CHECK_LE(
+              (mat - mat_single).cwiseAbs().maxCoeff() / kernel_scale, 1e-5);
+        }
+
+        Kernel kernel{json{{"name", "Cosine"},
+                           {"zeta", 2},
+                           {"target_type", "Structure"}}};
+        auto derivative = kernel.compute_derivative(representation,
+                                                    collection, collection);
+        auto derivative_single = kernel.compute_derivative(
+            representation_single, collection, collection);
+        double derivative_scale{
+            std::max(derivative.cwiseAbs().maxCoeff(), 1e-3)};
+        BOOST_CHECK_LE((derivative - derivative_single).cwiseAbs().maxCoeff() /
+                           derivative_scale,
+                       1e-5);
+
+        // the store holds the features in double
+        FeatureStore::write<PropertySingle_t>(filename, collection,
+                                              representation_single.get_name());
+        FeatureStore store{filename, representation_single.get_name()};
+        auto mat_single =
+            kernel.compute(representation_single, collection, collection);
+        auto mat_store = kernel.compute(store, store);
+        BOOST_CHECK_LE((mat_store - mat_single).cwiseAbs().maxCoeff(), 1e-6);
+      }
+    }
+    std::remove(filename.c_str());
+
+    json hyper = Fix::ParentB::representation_hypers.front();
+    hyper["precision"] = "half";
+    BOOST_CHECK_THROW(Calculator_t{hyper}, std::logic_error);
+  }
+
+  /**
+   * Tests the derivatives of the kernels with respect to the positions of the
+   * atoms and to the strain against finite differences of the kernels, also
+   * for constant kernels (zeta = 0 or degree = 0).
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(kernel_derivative_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Calculator_t = typename Fix::Calculator_t;
+    auto & collections = Fix::collections;
+    std::vector<json> kernel_hypers{{{"name", "Cosine"},
+                                     {"zeta", 2},
+                                     {"target_type", "Structure"},
+                                     {"tile_cols", 5},
+                                     {"n_threads", 2}},
+                                    {{"name", "Cosine"},
+                                     {"zeta", 0},
+                                     {"target_type", "Structure"}},
+                                    {{"name", "Polynomial"},
+                                     {"degree", 0},
+                                     {"target_type", "Structure"}},
+                                    {{"name", "Polynomial"},
+                                     {"degree", 3},
+                                     {"gamma", 0.5},
+                                     {"target_type", "Structure"},
+                                     {"structure_reduction", "Sum"}},
+                                    {{"name", "Gaussian"},
+                                     {"gamma", 0.5},
+                                     {"target_type", "Atom"},
+                                     {"n_threads", 3}}};
+    constexpr std::array<std::array<int, 2>, 6> voigt{
+        {{0, 0}, {1, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}}};
+    double delta{1e-5};
+
+    for (auto & collection : collections) {
+      ManagerCollection_t sparse_points{collection.get_adaptors_parameters()};
+      sparse_points.add_structures(Fix::ParentA::filename,
+                                   Fix::ParentA::start + 1, 1);
+      size_t n_atoms{0};
+      for (auto & manager : collection) {
+        n_atoms += manager->size();
+      }
+      auto manager{collection[0]};
+      auto structure{
+          extract_underlying_manager<0>(manager)->get_atomic_structure()};
+      for (auto hyper : Fix::ParentB::representation_hypers) {
+        hyper["compute_gradients"] = true;
+        Calculator_t representation{hyper};
+        representation.compute(collection);
+        representation.compute(sparse_points);
+
+        std::vector<Kernel> kernels{}, atom_kernels{};
+        std::vector<math::Matrix_t> derivatives{};
+        for (auto kernel_hyper : kernel_hypers) {
+          kernels.emplace_back(kernel_hyper);
+          derivatives.push_back(kernels.back().compute_derivative(
+              representation, collection, sparse_points, true));
+          BOOST_CHECK_EQUAL(derivatives.back().rows(),
+                            3 * n_atoms + 6 * collection.size());
+          BOOST_CHECK_EQUAL(derivatives.back().cols(),
+                            sparse_points[0]->size());
+          kernel_hyper["target_type"] = "Atom";
+          atom_kernels.emplace_back(kernel_hyper);
+        }
+        // kernels of the first structure with the sparse points
+        auto compute_kernels = [&](const AtomicStructure<3> & displaced) {
+          manager->update(displaced);
+          representation.compute(collection);
+          std::vector<math::Matrix_t> values{};
+          for (size_t i_kernel{0}; i_kernel < kernels.size(); ++i_kernel) {
+            auto atom_kernel{atom_kernels[i_kernel].compute(
+                representation, collection, sparse_points)};
+            auto && rows{atom_kernel.topRows(manager->size())};
+            bool average{kernels[i_kernel].target_type ==
+                             internal::TargetType::Structure and
+                         kernel_hypers[i_kernel].count("structure_reduction") ==
+                             0};
+            if (average) {
+              values.emplace_back(rows.colwise().mean());
+            } else {
+              values.emplace_back(rows.colwise().sum());
+            }
+          }
+          return values;
+        };
+        auto check_finite_difference = [&](AtomicStructure<3> & plus,
+                                           AtomicStructure<3> & minus,
+                                           size_t row) {
+          auto values_plus{compute_kernels(plus)};
+          auto values_minus{compute_kernels(minus)};
+          for (size_t i_kernel{0}; i_kernel < kernels.size(); ++i_kernel) {
+            math::Matrix_t finite_difference{
+                (values_plus[i_kernel] - values_minus[i_kernel]) /
+                (2 * delta)};
+            auto && derivative{derivatives[i_kernel].row(row)};
+            double scale{std::max(derivative.cwiseAbs().maxCoeff(), 1e-3)};
+            BOOST_CHECK_LE(
+                (derivative - finite_difference).cwiseAbs().maxCoeff() / scale,
+                1e-5);
+          }
+        };
+
+        for (int i_atom{0}; i_atom < 3; ++i_atom) {
+          for (int i_dim{0}; i_dim < 3; ++i_dim) {
+            auto plus{structure}, minus{structure};
+            plus.positions(i_dim, i_atom) += delta;
+            minus.positions(i_dim, i_atom) -= delta;
+            check_finite_difference(plus, minus, 3 * i_atom + i_dim);
+          }
+        }
+        for (size_t i_voigt{0}; i_voigt < voigt.size(); ++i_voigt) {
+          auto plus{structure}, minus{structure};
+          int a{voigt[i_voigt][0]}, b{voigt[i_voigt][1]};
+          plus.positions.row(a) += delta * structure.positions.row(b);
+          minus.positions.row(a) -= delta * structure.positions.row(b);
+          check_finite_difference(plus, minus, 3 * n_atoms + i_voigt);
+        }
+        manager->update(structure);
+        representation.compute(collection);
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
@@ -81,7 +81,16 @@ namespace rascal {
 
     std::vector<json> kernel_hypers{
         {{"zeta", 2}, {"target_type", "Structure"}, {"name", "Cosine"}},
-        {{"zeta", 2}, {"target_type", "Atom"}, {"name", "Cosine"}}};
+        {{"zeta", 2}, {"target_type", "Atom"}, {"name", "Cosine"}},
+        {{"degree", 3},
+         {"gamma", 0.5},
+         {"target_type", "Structure"},
+         {"name", "Polynomial"}},
+        {{"gamma", 0.5},
+         {"target_type", "Structure"},
+         {"name", "Gaussian"},
+         {"structure_reduction", "NormalizedAverage"}},
+        {{"gamma", 0.5}, {"target_type", "Atom"}, {"name", "Gaussian"}}};
   };
 
   struct DataSphericalInvariantsKernelFixture {
@@ -29,6 +29,8 @@
 
 #include "test_manager_collection.hh"
 
+#include <cstdio>
+
 namespace rascal {
 
   BOOST_AUTO_TEST_SUITE(manager_collection_test);
@@ -87,5 +89,47 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the managers built from a StructureStore converted from the
+   * file are the same as the ones built from the file
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(add_structures_from_store_test, Fix,
+                                   fixtures_test, Fix) {
+    auto & collections = Fix::collections;
+    auto & filename = Fix::filename;
+    auto & start = Fix::start;
+    auto & length = Fix::length;
+    std::string store_filename{"manager_collection_test.bin"};
+    StructureStore::convert_ase(filename, store_filename);
+    auto store{std::make_shared<const StructureStore>(store_filename)};
+
+    for (auto & collection : collections) {
+      collection.add_structures(filename, start, length);
+      typename Fix::ManagerCollection_t store_collection{
+          collection.get_adaptors_parameters()};
+      store_collection.add_structures(store, start, length);
+      BOOST_REQUIRE_EQUAL(store_collection.size(), collection.size());
+      for (size_t i_manager{0}; i_manager < collection.size(); ++i_manager) {
+        auto manager{collection[i_manager]};
+        auto store_manager{store_collection[i_manager]};
+        BOOST_CHECK_EQUAL(store_manager->size(), manager->size());
+        BOOST_CHECK_EQUAL(store_manager->get_nb_clusters(2),
+                          manager->get_nb_clusters(2));
+        auto atom{manager->begin()};
+        for (auto store_atom : store_manager) {
+          BOOST_CHECK_EQUAL(store_atom.get_atom_type(),
+                            (*atom).get_atom_type());
+          BOOST_CHECK((store_atom.get_position() - (*atom).get_position())
+                          .norm() == 0.);
+          ++atom;
+        }
+      }
+      BOOST_CHECK_THROW(store_collection.add_structures(
+                            store, static_cast<int>(store->size()), 1),
+                        std::runtime_error);
+    }
+    std::remove(store_filename.c_str());
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
@@ -128,6 +128,62 @@ namespace rascal {
     }
   }
 
+  /**
+   * Check that evaluating 1F1 for several distances at once gives the same
+   * values and derivatives as the evaluation distance by distance.
+   */
+  BOOST_FIXTURE_TEST_CASE(math_hyp1f1_spherical_expansion_batch_test,
+                          Hyp1f1SphericalExpansionFixture) {
+    for (size_t i_rc{0}; i_rc < this->rcs.size(); ++i_rc) {
+      auto & rc{this->rcs[i_rc]};
+      auto & fac_b{this->facs_b[i_rc]};
+      std::vector<double> r_ijs_in{};
+      for (auto & r_ij : this->r_ijs) {
+        if (r_ij < rc) {
+          r_ijs_in.push_back(r_ij);
+        }
+      }
+      Eigen::Map<Eigen::ArrayXd> distances(r_ijs_in.data(), r_ijs_in.size());
+      for (auto & fac_a : this->fac_as) {
+        for (size_t ii{0}; ii < this->hyp1f1.size(); ++ii) {
+          for (auto * calculator : {&hyp1f1[ii], &hyp1f1_recursion[ii]}) {
+            calculator->calc_batch(distances, fac_a, fac_b[ii], true);
+            Eigen::ArrayXXd values_batch{calculator->get_values_batch()};
+            Eigen::ArrayXXd derivatives_batch{
+                calculator->get_derivatives_batch()};
+            for (int i_dist{0}; i_dist < distances.size(); ++i_dist) {
+              calculator->calc(distances(i_dist), fac_a, fac_b[ii], true);
+              Eigen::MatrixXd val{calculator->get_values()};
+              Eigen::MatrixXd der{calculator->get_derivatives()};
+              Eigen::ArrayXd row_val{values_batch.row(i_dist).transpose()};
+              Eigen::ArrayXd row_der{derivatives_batch.row(i_dist).transpose()};
+              Eigen::Map<Eigen::MatrixXd> val_b(row_val.data(), val.rows(),
+                                                val.cols());
+              Eigen::Map<Eigen::MatrixXd> der_b(row_der.data(), der.rows(),
+                                                der.cols());
+              double diff_val{((val - val_b).array().abs() /
+                               val.array().abs().max(math::dbl_ftol))
+                                  .maxCoeff()};
+              double diff_der{((der - der_b).array().abs() /
+                               der.array().abs().max(math::dbl_ftol))
+                                  .maxCoeff()};
+              BOOST_CHECK_LE(diff_val, 10 * math::dbl_ftol);
+              // the derivatives are a difference of two terms of similar
+              // magnitude so the last bits of the (lockstep) series are
+              // amplified
+              BOOST_CHECK_LE(diff_der, 1e3 * math::dbl_ftol);
+              if (verbose) {
+                std::cout << "r_ij=" << distances(i_dist)
+                          << " diff_val= " << diff_val
+                          << " diff_der=" << diff_der << std::endl;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_CASE(hyp1f1_gradient_test) {
     const size_t max_radial = 4;
     const size_t max_angular = 2;
@@ -215,6 +215,57 @@ namespace rascal {
   }
   */
 
+  /**
+   * Check that the batched evaluation of the spherical harmonics and of their
+   * gradients gives the same results as the evaluation direction by
+   * direction, including directions along the z-axis and close to the poles
+   * where the gradients use a different expression.
+   */
+  BOOST_AUTO_TEST_CASE(spherical_harmonics_batch_test) {
+    constexpr int n_random{20};
+    Eigen::Matrix3Xd directions(3, n_random + 6);
+    directions.leftCols(n_random).setRandom();
+    directions.col(n_random) << 0., 0., 1.;
+    directions.col(n_random + 1) << 0.05, 0., 1.;
+    directions.col(n_random + 2) << 0., 0., -1.;
+    directions.col(n_random + 3) << 0.02, -0.01, -1.;
+    directions.col(n_random + 4) << 1., 0., 0.;
+    directions.col(n_random + 5) << 0.3, 0., 1.;
+    for (int i_dir{0}; i_dir < directions.cols(); ++i_dir) {
+      directions.col(i_dir).normalize();
+    }
+
+    for (size_t max_angular : {0, 1, 2, 5, 12}) {
+      math::SphericalHarmonics harmonics_calculator{true};
+      harmonics_calculator.precompute(max_angular);
+      Eigen::MatrixXd harmonics{}, harmonics_derivatives{};
+      harmonics_calculator.calc_batch(directions, harmonics,
+                                      harmonics_derivatives, true);
+      int n_lm{static_cast<int>((max_angular + 1) * (max_angular + 1))};
+      BOOST_REQUIRE_EQUAL(harmonics.rows(), directions.cols());
+      BOOST_REQUIRE_EQUAL(harmonics.cols(), n_lm);
+      BOOST_REQUIRE_EQUAL(harmonics_derivatives.cols(), 3 * n_lm);
+
+      for (int i_dir{0}; i_dir < directions.cols(); ++i_dir) {
+        harmonics_calculator.calc(directions.col(i_dir), true);
+        auto && harmonics_ref{harmonics_calculator.get_harmonics()};
+        auto && derivatives_ref{
+            harmonics_calculator.get_harmonics_derivatives()};
+        double error{
+            (harmonics.row(i_dir) - harmonics_ref).cwiseAbs().maxCoeff()};
+        BOOST_CHECK_LE(error, 10 * math::dbl_ftol);
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          double der_error{(harmonics_derivatives.block(i_dir, i_dim * n_lm, 1,
+                                                        n_lm) -
+                            derivatives_ref.row(i_dim))
+                               .cwiseAbs()
+                               .maxCoeff()};
+          BOOST_CHECK_LE(der_error, 100 * math::dbl_ftol);
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_CASE(spherical_harmonics_gradient_test) {
     // (max) what?! how does this even remain numerically stable?
     // it's total overkill in any case, 10 or even 3 would suffice
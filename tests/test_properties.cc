@@ -842,6 +842,53 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /*
+   * checks that filling the property again after clearing it reuses the
+   * memory of its arena and gives back the same data
+   */
+  BOOST_FIXTURE_TEST_CASE(arena_reuse_test, BlockSparsePropertyFixture<1>) {
+    auto i_manager{0};
+    for (auto & manager : managers) {
+      auto & keys{keys_list[i_manager]};
+      auto & sparse_feature{sparse_features[i_manager]};
+      size_t capacity{0};
+      for (int i_fill{0}; i_fill < 2; ++i_fill) {
+        sparse_feature.clear();
+        sparse_feature.set_shape(n_row, n_col);
+        sparse_feature.resize();
+        auto i_center{0};
+        for (auto center : manager) {
+          auto && sparse_feature_center{sparse_feature[center]};
+          sparse_feature_center.resize(keys[i_center], n_row, n_col, 0);
+          for (auto & key : keys[i_center]) {
+            sparse_feature_center[key] = test_datas[i_manager][i_center][key];
+          }
+          i_center++;
+        }
+        if (i_fill == 0) {
+          capacity = sparse_feature.get_arena_capacity();
+        } else {
+          BOOST_CHECK_EQUAL(capacity, sparse_feature.get_arena_capacity());
+        }
+      }
+
+      auto i_center{0};
+      for (auto center : manager) {
+        // the copy owns its data
+        auto sparse_feature_center{sparse_feature[center]};
+        for (auto & key : keys[i_center]) {
+          auto error = (sparse_feature_center[key] -
+                        test_datas[i_manager][i_center][key])
+                           .norm();
+          BOOST_CHECK_LE(error, tol * 100);
+        }
+        i_center++;
+      }
+      i_manager++;
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * test, if metadata can be assigned to properties
@@ -853,6 +900,45 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * test the keys lookup and the dot product between maps that only share
+   * some of their keys
+   */
+  BOOST_AUTO_TEST_CASE(sorted_key_map_dot_test) {
+    using Key_t = std::vector<int>;
+    using Map_t = internal::InternallySortedKeyMap<Key_t, math::Matrix_t>;
+    int n_row{3}, n_col{2};
+    std::vector<Key_t> keys_a{{3, 3}, {2, 1}, {1, 1}, {5, 6}};
+    std::vector<Key_t> keys_b{{4, 4}, {1, 2}, {6, 5}, {3, 3}, {0, 7}};
+    Map_t map_a{}, map_b{};
+    map_a.resize(keys_a, n_row, n_col, 0);
+    map_b.resize(keys_b, n_row, n_col, 0);
+    for (auto & key : keys_a) {
+      map_a[key] = math::Matrix_t::Random(n_row, n_col);
+    }
+    for (auto & key : keys_b) {
+      map_b[key] = math::Matrix_t::Random(n_row, n_col);
+    }
+
+    auto sorted_keys{map_b.get_keys()};
+    BOOST_CHECK_EQUAL(sorted_keys.size(), keys_b.size());
+    BOOST_CHECK(std::is_sorted(sorted_keys.begin(), sorted_keys.end()));
+    BOOST_CHECK_EQUAL(map_a.count(Key_t{1, 2}), 1);
+    BOOST_CHECK_EQUAL(map_a.count(Key_t{4, 4}), 0);
+    BOOST_CHECK_THROW(map_a.at(Key_t{4, 4}), std::out_of_range);
+
+    double ref_dot{0.};
+    for (auto & key : keys_a) {
+      if (map_b.count(key) == 1) {
+        ref_dot += map_a.at(key).cwiseProduct(map_b.at(key)).sum();
+      }
+    }
+    BOOST_CHECK_CLOSE(map_a.dot(map_b), ref_dot, 1e-10);
+    BOOST_CHECK_CLOSE(map_b.dot(map_a), ref_dot, 1e-10);
+    BOOST_CHECK_EQUAL(map_a.dot(Map_t{}), 0.);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
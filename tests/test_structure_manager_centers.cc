@@ -150,6 +150,91 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * checking the update from caller-owned buffers: the positions are read in
+   * place from a strided buffer, the changes made in place are seen without
+   * reindexing and a new version is validated and indexed again. The
+   * neighbour list built on top is compared with the one of a copied
+   * structure.
+   */
+  BOOST_FIXTURE_TEST_CASE(manager_view_update_test,
+                          ManagerFixture<StructureManagerCenters>) {
+    auto & structure = this->structures[0];
+    auto n_atoms{static_cast<Eigen::Index>(structure.get_number_of_atoms())};
+    // positions of the atoms as the rows of a (n_atoms, 4) C-ordered array
+    constexpr Eigen::Index stride{4};
+    std::vector<double> positions(stride * n_atoms, -1.);
+    std::vector<int> atom_types(n_atoms);
+    for (Eigen::Index i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      for (int i_dim{0}; i_dim < 3; ++i_dim) {
+        positions[stride * i_atom + i_dim] = structure.positions(i_dim, i_atom);
+      }
+      atom_types[i_atom] = structure.atom_types(i_atom);
+    }
+
+    AtomicStructureView<3> view{};
+    view.positions = positions.data();
+    view.positions_stride = stride;
+    view.atom_types = atom_types.data();
+    view.n_atoms = n_atoms;
+    view.cell = structure.cell;
+    view.pbc = structure.pbc;
+
+    auto manager{make_structure_manager<StructureManagerCenters>()};
+    auto pair_manager{make_adapted_manager<AdaptorNeighbourList>(
+        manager, this->cutoff)};
+    pair_manager->update(view);
+    auto ref_manager{make_structure_manager<StructureManagerCenters>()};
+    auto ref_pair_manager{make_adapted_manager<AdaptorNeighbourList>(
+        ref_manager, this->cutoff)};
+    ref_pair_manager->update(structure.positions, structure.atom_types,
+                             structure.cell, structure.pbc);
+
+    BOOST_CHECK_EQUAL(manager->get_positions().data(), positions.data());
+    BOOST_CHECK_EQUAL(manager->get_atom_types().data(), atom_types.data());
+    BOOST_CHECK_EQUAL(manager->size(), static_cast<size_t>(n_atoms));
+    for (auto atom : manager) {
+      auto index = manager->get_atom_index(atom);
+      BOOST_CHECK_EQUAL(atom.get_atom_type(), structure.atom_types(index));
+      auto position_error =
+          (atom.get_position() - structure.positions.col(index)).norm();
+      BOOST_CHECK_LE(position_error, tol / 100);
+    }
+    BOOST_CHECK_EQUAL(pair_manager->get_nb_clusters(2),
+                      ref_pair_manager->get_nb_clusters(2));
+
+    // displace an atom in place, the version is unchanged
+    positions[stride * 1] += 0.1;
+    pair_manager->update(view);
+    auto displaced_positions{structure.positions};
+    displaced_positions(0, 1) += 0.1;
+    ref_pair_manager->update(displaced_positions, structure.atom_types,
+                             structure.cell, structure.pbc);
+    BOOST_CHECK_EQUAL(manager->get_position(1)(0), positions[stride * 1]);
+    BOOST_CHECK_EQUAL(pair_manager->get_nb_clusters(2),
+                      ref_pair_manager->get_nb_clusters(2));
+
+    // remove the last atom, which has to be signalled with a new version
+    --view.n_atoms;
+    ++view.version;
+    pair_manager->update(view);
+    ref_pair_manager->update(
+        displaced_positions.leftCols(view.n_atoms).eval(),
+        structure.atom_types.head(view.n_atoms).eval(), structure.cell,
+        structure.pbc);
+    auto n_atoms_left{static_cast<size_t>(view.n_atoms)};
+    BOOST_CHECK_EQUAL(manager->size(), n_atoms_left);
+    BOOST_CHECK_EQUAL(manager->get_n_atoms(), n_atoms_left);
+    BOOST_CHECK_EQUAL(pair_manager->get_nb_clusters(2),
+                      ref_pair_manager->get_nb_clusters(2));
+
+    // an inconsistent view is rejected
+    ++view.version;
+    view.positions_stride = 2;
+    BOOST_CHECK_THROW(manager->update(view), std::runtime_error);
+  }
+
   /* ---------------------------------------------------------------------- */
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
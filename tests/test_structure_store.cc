@@ -0,0 +1,138 @@
+/**
+ * @file   test_structure_store.cc
+ *
+ * @date   18 Oct 2020
+ *
+ * @brief test the binary file of atomic structures
+ *
+ * Copyright © 2020 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Emacs; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "tests.hh"
+#include "structure_store.hh"
+
+#include <cstdio>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(StructureStoreTests);
+
+  struct StructureStoreFixture {
+    StructureStoreFixture() {}
+
+    ~StructureStoreFixture() { std::remove(this->store_filename.c_str()); }
+
+    void check_equal(const AtomicStructure<3> & structure,
+                     const StructureStore::View_t & view) {
+      BOOST_REQUIRE_EQUAL(structure.get_number_of_atoms(), view.n_atoms);
+      Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>, 0,
+                 Eigen::OuterStride<>>
+          positions(view.positions, 3, view.n_atoms,
+                    Eigen::OuterStride<>(view.positions_stride));
+      Eigen::Map<const Eigen::VectorXi> atom_types(view.atom_types,
+                                                   view.n_atoms);
+      BOOST_CHECK(structure.positions == positions);
+      BOOST_CHECK(structure.atom_types == atom_types);
+      BOOST_CHECK(structure.cell == view.cell);
+      BOOST_CHECK(structure.pbc == view.pbc);
+    }
+
+    std::string ase_filename{"reference_data/dft-smiles_500.ubjson"};
+    std::string store_filename{"structure_store_test.bin"};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the structures converted from an ase file are the same as when
+   * they are read from the json, in the order of the ids.
+   */
+  BOOST_FIXTURE_TEST_CASE(convert_ase_test, StructureStoreFixture) {
+    StructureStore::convert_ase(ase_filename, store_filename);
+    StructureStore store{store_filename};
+
+    json structures = json_io::load(ase_filename);
+    auto ids{structures["ids"].get<std::vector<int>>()};
+    std::sort(ids.begin(), ids.end());
+    BOOST_REQUIRE_EQUAL(store.size(), ids.size());
+
+    size_t n_atoms{0};
+    for (size_t index{0}; index < store.size(); ++index) {
+      BOOST_CHECK_EQUAL(store.get_id(index), ids[index]);
+      AtomicStructure<3> structure{};
+      structure.set_structure(structures[std::to_string(ids[index])]);
+      this->check_equal(structure, store.get_structure_view(index));
+      n_atoms += store.get_n_atoms(index);
+    }
+    BOOST_CHECK_EQUAL(store.get_n_atoms(), n_atoms);
+    BOOST_CHECK_THROW(store.get_structure_view(store.size()),
+                      std::out_of_range);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test writing structures given with their own positions or as views with
+   * strided positions, and reading them back.
+   */
+  BOOST_FIXTURE_TEST_CASE(write_read_test, StructureStoreFixture) {
+    std::vector<AtomicStructure<3>> structures(3);
+    structures[0].set_structure(
+        std::string("reference_data/CaCrP2O7_mvc-11955_symmetrized.json"));
+    structures[1].set_structure(
+        std::string("reference_data/small_molecule.json"));
+
+    // (n_atoms, 4) positions with an extra column, as in a MD engine
+    Eigen::Matrix<double, Eigen::Dynamic, 4, Eigen::RowMajor> buffer(5, 4);
+    buffer.setRandom();
+    Eigen::VectorXi types(5);
+    types << 1, 6, 6, 8, 1;
+    AtomicStructureView<3> view{};
+    view.positions = buffer.data();
+    view.positions_stride = 4;
+    view.atom_types = types.data();
+    view.n_atoms = 5;
+    view.cell = 10. * Eigen::Matrix3d::Identity();
+    view.pbc << 1, 0, 1;
+    structures[2].set_structure(view);
+
+    StructureStore::write(store_filename, structures, {3, 7, 11});
+    StructureStore store{store_filename};
+    BOOST_REQUIRE_EQUAL(store.size(), 3);
+    BOOST_CHECK_EQUAL(store.get_id(1), 7);
+    for (size_t index{0}; index < 2; ++index) {
+      this->check_equal(structures[index], store.get_structure_view(index));
+      auto copy{store.get_structure(index)};
+      BOOST_CHECK(copy.is_similar(structures[index], 0.));
+    }
+    auto stored_view{store.get_structure_view(2)};
+    BOOST_CHECK_EQUAL(stored_view.positions_stride, 3);
+    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+        stored_positions(stored_view.positions, 5, 3);
+    BOOST_CHECK(stored_positions == buffer.leftCols(3));
+    BOOST_CHECK(Eigen::Map<Eigen::VectorXi>(stored_view.atom_types, 5) ==
+                types);
+    BOOST_CHECK(stored_view.cell == view.cell);
+    BOOST_CHECK(stored_view.pbc == view.pbc);
+
+    // not a store
+    BOOST_CHECK_THROW(StructureStore("reference_data/small_molecule.json"),
+                      std::runtime_error);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal